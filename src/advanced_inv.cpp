@@ -663,9 +663,9 @@ advanced_inv_listitem::advanced_inv_listitem( item *an_item, int index, int coun
     : idx( index )
     , area( _area )
     , it( an_item )
-    , name( an_item->tname( count ) )
-    , name_without_prefix( an_item->tname( 1, false ) )
-    , autopickup( hasPickupRule( an_item->tname( 1, false ) ) )
+    , name( an_item->cached_tname( count ) )
+    , name_without_prefix( an_item->cached_tname( 1, false ) )
+    , autopickup( hasPickupRule( name_without_prefix ) )
     , stacks( count )
     , volume( an_item->volume() * stacks )
     , weight( an_item->weight() * stacks )
@@ -724,7 +724,7 @@ bool advanced_inventory_pane::is_filtered( const item *it ) const
         return false;
     }
 
-    std::string str = it->tname();
+    const std::string str = it->cached_tname();
     if( filtercache.find( str ) == filtercache.end() ) {
         bool match = !g->list_items_match( it, filter );
         filtercache[ str ] = match;
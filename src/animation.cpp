@@ -23,7 +23,8 @@ point relative_view_pos(player const &u, point const &p) noexcept
 
 void draw_animation_delay(long const scale = 1)
 {
-    auto const delay = static_cast<long>(OPTIONS["ANIMATION_DELAY"]) * scale * 1000000l;
+    static const option_handle<int> opt_animation_delay( "ANIMATION_DELAY" );
+    auto const delay = static_cast<long>(opt_animation_delay.get()) * scale * 1000000l;
 
     timespec const ts = {0, delay};
     if (ts.tv_nsec > 0) {
@@ -13,10 +13,32 @@
 #include <sstream>
 #include <string>
 #include <locale>
+#include <unordered_map>
 
-std::map<std::string, std::string> mapAutoPickupItems;
 std::vector<cPickupRules> vAutoPickupRules[5];
 
+/** An active rule of @ref vAutoPickupRules[APU_MERGED] with its pattern split at the '*'. */
+struct compiled_pickup_rule {
+    std::vector<std::string> vPattern;
+    bool bExclude;
+};
+
+/** Result of matching an item name against all the compiled rules. */
+struct pickup_rule_match {
+    bool bInclude = false;
+    bool bExclude = false;
+};
+
+static std::vector<compiled_pickup_rule> vCompiledRules;
+// Indexed by itype::index, rebuilt by createPickupRules whenever the rules change.
+static std::vector<bool> vIncludedTypes;
+static std::vector<bool> vExcludedTypes;
+// Items whose name differs from the name of their type (damaged, (fits), containers, ...)
+static std::unordered_map<std::string, pickup_rule_match> mapMatchedNames;
+
+static std::vector<std::string> compile_pattern( const std::string &sPattern );
+static bool auto_pickup_match( std::string sText, const std::vector<std::string> &vPattern );
+
 void show_auto_pickup()
 {
     save_reset_changes(false);
@@ -341,10 +363,11 @@ void test_pattern(int iCurrentPage, int iCurrentLine)
 
     //Loop through all itemfactory items
     //APU now ignores prefixes, bottled items and suffix combinations still not generated
+    const auto vPattern = compile_pattern( vAutoPickupRules[iCurrentPage][iCurrentLine].sRule );
     for( auto &p : item_controller->get_all_itypes() ) {
         sItemName = p.second->nname(1);
         if (vAutoPickupRules[iCurrentPage][iCurrentLine].bActive &&
-            auto_pickup_match(sItemName, vAutoPickupRules[iCurrentPage][iCurrentLine].sRule)) {
+            auto_pickup_match(sItemName, vPattern)) {
             vMatchingItems.push_back(sItemName);
         }
     }
@@ -570,65 +593,77 @@ void removePickupRule(std::string sRule)
     }
 }
 
-void createPickupRules(const std::string sItemNameIn)
+static pickup_rule_match match_pickup_rules( const std::string &sItemName )
 {
-    if (sItemNameIn == "") {
-        mapAutoPickupItems.clear();
+    pickup_rule_match result;
+    for( auto &rule : vCompiledRules ) {
+        bool &bMatched = rule.bExclude ? result.bExclude : result.bInclude;
+        if( !bMatched && auto_pickup_match( sItemName, rule.vPattern ) ) {
+            bMatched = true;
+        }
     }
+    return result;
+}
 
-    std::string sItemName = "";
-
-    //Includes only
-    for( auto &elem : vAutoPickupRules[APU_MERGED] ) {
-        if( !elem.bExclude ) {
-            if (sItemNameIn != "") {
-                if( elem.bActive && auto_pickup_match( sItemNameIn, elem.sRule ) ) {
-                    mapAutoPickupItems[sItemNameIn] = "true";
-                    break;
-                }
-            } else {
-                //Check include paterns against all itemfactory items
-                for( auto &p : item_controller->get_all_itypes() ) {
-                    sItemName = p.second->nname(1);
-                    if( elem.bActive && auto_pickup_match( sItemName, elem.sRule ) ) {
-                        mapAutoPickupItems[sItemName] = "true";
-                    }
-                }
-            }
-        }
+static pickup_rule_match find_pickup_rules( const std::string &sItemName, const itype *type )
+{
+    if( type != nullptr && type->index < vIncludedTypes.size() && sItemName == type->nname( 1 ) ) {
+        pickup_rule_match result;
+        result.bInclude = vIncludedTypes[type->index];
+        result.bExclude = vExcludedTypes[type->index];
+        return result;
     }
 
-    //Excludes only
-    for( auto &elem : vAutoPickupRules[APU_MERGED] ) {
-        if( elem.bExclude ) {
-            if (sItemNameIn != "") {
-                if( elem.bActive && auto_pickup_match( sItemNameIn, elem.sRule ) ) {
-                    mapAutoPickupItems[sItemNameIn] = "false";
-                    return;
-                }
-            } else {
-                //Check exclude paterns against all included items
-                for (std::map<std::string, std::string>::iterator iter =
-                         mapAutoPickupItems.begin();
-                     iter != mapAutoPickupItems.end(); ++iter) {
-                    if( elem.bActive && auto_pickup_match( iter->first, elem.sRule ) ) {
-                        mapAutoPickupItems[iter->first] = "false";
-                    }
-                }
-            }
-        }
+    auto iter = mapMatchedNames.find( sItemName );
+    if( iter == mapMatchedNames.end() ) {
+        iter = mapMatchedNames.insert( std::make_pair( sItemName, match_pickup_rules( sItemName ) ) ).first;
     }
+    return iter->second;
 }
 
-bool checkExcludeRules(const std::string sItemNameIn)
+void createPickupRules()
 {
+    vCompiledRules.clear();
     for( auto &elem : vAutoPickupRules[APU_MERGED] ) {
-        if( elem.bExclude && elem.bActive && auto_pickup_match( sItemNameIn, elem.sRule ) ) {
-            return false;
+        if( elem.bActive ) {
+            compiled_pickup_rule rule;
+            rule.vPattern = compile_pattern( elem.sRule );
+            rule.bExclude = elem.bExclude;
+            vCompiledRules.push_back( rule );
         }
     }
 
-    return true;
+    mapMatchedNames.clear();
+    vIncludedTypes.clear();
+    vExcludedTypes.clear();
+
+    //Check the patterns against all itemfactory items
+    const auto &itypes = item_controller->get_all_itypes();
+    size_t iNumTypes = 0;
+    for( auto &p : itypes ) {
+        iNumTypes = std::max( iNumTypes, p.second->index + 1 );
+    }
+    vIncludedTypes.resize( iNumTypes, false );
+    vExcludedTypes.resize( iNumTypes, false );
+    if( vCompiledRules.empty() ) {
+        return;
+    }
+    for( auto &p : itypes ) {
+        const pickup_rule_match match = match_pickup_rules( p.second->nname( 1 ) );
+        vIncludedTypes[p.second->index] = match.bInclude;
+        vExcludedTypes[p.second->index] = match.bExclude;
+    }
+}
+
+bool checkPickupRules( const std::string &sItemName, const itype *type )
+{
+    const pickup_rule_match match = find_pickup_rules( sItemName, type );
+    return match.bInclude && !match.bExclude;
+}
+
+bool checkExcludeRules( const std::string &sItemName, const itype *type )
+{
+    return !find_pickup_rules( sItemName, type ).bExclude;
 }
 
 void save_reset_changes(bool bReset)
@@ -737,7 +772,19 @@ std::string trim_rule(std::string sPattern)
     return sPattern;
 }
 
+static std::vector<std::string> compile_pattern( const std::string &sPattern )
+{
+    std::vector<std::string> vPattern;
+    split( trim_rule( sPattern ), '*', vPattern );
+    return vPattern;
+}
+
 bool auto_pickup_match(std::string sText, std::string sPattern)
+{
+    return auto_pickup_match( sText, compile_pattern( sPattern ) );
+}
+
+static bool auto_pickup_match( std::string sText, const std::vector<std::string> &vPattern )
 {
     //case insenitive search
 
@@ -759,11 +806,6 @@ bool auto_pickup_match(std::string sText, std::string sPattern)
     }
 
     int iPos;
-    std::vector<std::string> vPattern;
-
-    sPattern = trim_rule(sPattern);
-
-    split(sPattern, '*', vPattern);
     size_t iNum = vPattern.size();
 
     if (iNum == 0) { //should never happen
@@ -776,7 +818,7 @@ bool auto_pickup_match(std::string sText, std::string sPattern)
         return false;
     }
 
-    for (std::vector<std::string>::iterator it = vPattern.begin();
+    for (std::vector<std::string>::const_iterator it = vPattern.begin();
          it != vPattern.end(); ++it) {
         if (it == vPattern.begin() && *it != "") { //beginning: ^vPat[i]
             if (sText.length() < it->length() ||
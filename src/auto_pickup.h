@@ -7,6 +7,8 @@
 #include <locale>
 #include <algorithm>
 
+struct itype;
+
 enum apu_type {
     APU_MERGED = 0,
     APU_GLOBAL,
@@ -37,7 +39,6 @@ class cPickupRules
         ~cPickupRules() {};
 };
 
-extern std::map<std::string, std::string> mapAutoPickupItems;
 extern std::vector<cPickupRules> vAutoPickupRules[5];
 
 void test_pattern(int iCurrentPage, int iCurrentLine);
@@ -46,8 +47,19 @@ void merge_vector();
 bool hasPickupRule(std::string sRule);
 void addPickupRule(std::string sRule);
 void removePickupRule(std::string sRule);
-void createPickupRules(const std::string sItemNameIn = "");
-bool checkExcludeRules(const std::string sItemNameIn);
+/**
+ * Compiles the active rules and matches them against the names of all item types,
+ * must be called whenever @ref vAutoPickupRules[APU_MERGED] changes.
+ */
+void createPickupRules();
+/**
+ * Whether an item should be picked up according to the rules (an include rule matches,
+ * no exclude rule does). The name is expected to be `item::tname( 1, false )`, if it's
+ * the plain name of the type, the precomputed result for the type is used.
+ */
+bool checkPickupRules( const std::string &sItemName, const itype *type );
+/** Returns false if an exclude rule matches the item, see @ref checkPickupRules. */
+bool checkExcludeRules( const std::string &sItemName, const itype *type );
 void save_reset_changes(bool bReset);
 void show_auto_pickup();
 void load_auto_pickup(bool bCharacter);
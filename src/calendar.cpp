@@ -5,6 +5,8 @@
 #include "translations.h"
 #include "game.h"
 
+static const option_handle<int> opt_season_length( "SEASON_LENGTH", true );
+
 calendar calendar::start;
 calendar calendar::turn;
 
@@ -248,11 +250,12 @@ std::string calendar::print_time(bool just_hour) const
 {
     std::stringstream time_string;
     int hour_param;
+    static const option_handle<std::string> opt_24_hour( "24_HOUR" );
 
-    if (OPTIONS["24_HOUR"] == "military") {
+    if (opt_24_hour == "military") {
         hour_param = hour % 24;
         time_string << string_format("%02d%02d.%02d", hour_param, minute, second);
-    } else if (OPTIONS["24_HOUR"] == "24h") {
+    } else if (opt_24_hour == "24h") {
         hour_param = hour % 24;
         if (just_hour) {
             time_string << hour_param;
@@ -377,10 +380,10 @@ std::string calendar::day_of_week() const
 
 int calendar::season_length()
 {
-    if( ACTIVE_WORLD_OPTIONS.empty() || int(ACTIVE_WORLD_OPTIONS["SEASON_LENGTH"]) == 0 ) {
+    if( opt_season_length == 0 ) {
         return 14; // default
     }
-    return int(ACTIVE_WORLD_OPTIONS["SEASON_LENGTH"]);
+    return opt_season_length;
 }
 
 void calendar::sync()
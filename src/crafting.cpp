@@ -1375,7 +1375,7 @@ item recipe::create_result(handedness handed) const
         newit.charges = 0;
     }
     if( newit.has_flag( "VARSIZE" ) ) {
-        newit.item_tags.insert( "FIT" );
+        newit.set_flag( "FIT" );
     }
     return newit;
 }
@@ -1409,7 +1409,7 @@ std::vector<item> recipe::create_byproducts(int batch) const
                     newit.charges = 0;
                 }
                 if( newit.has_flag( "VARSIZE" ) ) {
-                    newit.item_tags.insert( "FIT" );
+                    newit.set_flag( "FIT" );
                 }
                 bps.push_back(newit);
             }
@@ -1421,7 +1421,7 @@ std::vector<item> recipe::create_byproducts(int batch) const
                 }
                 newit.charges *= batch;
                 if( newit.has_flag( "VARSIZE" ) ) {
-                    newit.item_tags.insert( "FIT" );
+                    newit.set_flag( "FIT" );
                 }
                 bps.push_back(newit);
             }
@@ -1608,7 +1608,7 @@ void set_item_food(item &newit)
     int bday_tmp = newit.bday % 3600; // fuzzy birthday for stacking reasons
     newit.bday = int(newit.bday) + 3600 - bday_tmp;
     if (newit.has_flag("EATEN_HOT")) { // hot foods generated
-        newit.item_tags.insert("HOT");
+        newit.set_flag("HOT");
         newit.item_counter = 600;
         newit.active = true;
     }
@@ -722,57 +722,48 @@ void Creature::add_eff_effects(effect e, bool reduced)
  
 void Creature::add_effect(efftype_id eff_id, int dur, body_part bp, bool permanent, int intensity)
 {
+    effect_type &type = effect_types[eff_id];
     // Mutate to a main (HP'd) body_part if necessary.
-    if (effect_types[eff_id].get_main_parts()) {
+    if (type.get_main_parts()) {
         bp = mutate_to_main_part(bp);
     }
 
-    bool found = false;
+    const efftype_index eff_index = get_efftype_index( eff_id );
     // Check if we already have it
-    auto matching_map = effects.find(eff_id);
-    if (matching_map != effects.end()) {
-        auto found_effect = effects[eff_id].find(bp);
-        if (found_effect != effects[eff_id].end()) {
-            found = true;
-            effect &e = found_effect->second;
-            // If we do, mod the duration, factoring in the mod value
-            e.mod_duration(dur * e.get_dur_add_perc() / 100);
-            // Limit to max duration
-            if (e.get_max_duration() > 0 && e.get_duration() > e.get_max_duration()) {
-                e.set_duration(e.get_max_duration());
-            }
-            // Adding a permanent effect makes it permanent
-            if( e.is_permanent() ) {
-                e.pause_effect();
-            }
-            // Set intensity if value is given
-            if (intensity > 0) {
-                e.set_intensity(intensity);
-            // Else intensity uses the type'd step size if it already exists
-            } else if (e.get_int_add_val() != 0) {
-                e.mod_intensity(e.get_int_add_val());
-            }
-            
-            // Bound intensity by [1, max intensity]
-            if (e.get_intensity() < 1) {
-                add_msg( m_debug, "Bad intensity, ID: %s", e.get_id().c_str() );
-                e.set_intensity(1);
-            } else if (e.get_intensity() > e.get_max_intensity()) {
-                e.set_intensity(e.get_max_intensity());
-            }
+    effect *found_effect = effects.find( eff_index, bp );
+    if( found_effect != nullptr ) {
+        effect &e = *found_effect;
+        // If we do, mod the duration, factoring in the mod value
+        e.mod_duration(dur * e.get_dur_add_perc() / 100);
+        // Limit to max duration
+        if (e.get_max_duration() > 0 && e.get_duration() > e.get_max_duration()) {
+            e.set_duration(e.get_max_duration());
         }
-    }
-    
-    if (found == false) {
-        // If we don't already have it then add a new one
-        if (effect_types.find(eff_id) == effect_types.end()) {
-            return;
+        // Adding a permanent effect makes it permanent
+        if( e.is_permanent() ) {
+            e.pause_effect();
+        }
+        // Set intensity if value is given
+        if (intensity > 0) {
+            e.set_intensity(intensity);
+        // Else intensity uses the type'd step size if it already exists
+        } else if (e.get_int_add_val() != 0) {
+            e.mod_intensity(e.get_int_add_val());
         }
-        effect new_eff(&effect_types[eff_id], dur, bp, permanent, intensity);
-        effect &e = new_eff;
+
+        // Bound intensity by [1, max intensity]
+        if (e.get_intensity() < 1) {
+            add_msg( m_debug, "Bad intensity, ID: %s", e.get_id().c_str() );
+            e.set_intensity(1);
+        } else if (e.get_intensity() > e.get_max_intensity()) {
+            e.set_intensity(e.get_max_intensity());
+        }
+    } else {
+        // If we don't already have it then add a new one
+        effect new_eff(&type, dur, bp, permanent, intensity);
         // Bound to max duration
-        if (e.get_max_duration() > 0 && e.get_duration() > e.get_max_duration()) {
-            e.set_duration(e.get_max_duration());
+        if (new_eff.get_max_duration() > 0 && new_eff.get_duration() > new_eff.get_max_duration()) {
+            new_eff.set_duration(new_eff.get_max_duration());
         }
         // Bound new effect intensity by [1, max intensity]
         if (new_eff.get_intensity() < 1) {
@@ -781,17 +772,17 @@ void Creature::add_effect(efftype_id eff_id, int dur, body_part bp, bool permane
         } else if (new_eff.get_intensity() > new_eff.get_max_intensity()) {
             new_eff.set_intensity(new_eff.get_max_intensity());
         }
-        effects[eff_id][bp] = new_eff;
+        effect &e = effects.set( eff_index, bp, new_eff );
         if (is_player()) {
             // Only print the message if we didn't already have it
-            if(effect_types[eff_id].get_apply_message() != "") {
-                     add_msg(effect_types[eff_id].gain_game_message_type(),
-                             _(effect_types[eff_id].get_apply_message().c_str()));
+            if(type.get_apply_message() != "") {
+                     add_msg(type.gain_game_message_type(),
+                             _(type.get_apply_message().c_str()));
             }
             add_memorial_log(pgettext("memorial_male",
-                                           effect_types[eff_id].get_apply_memorial_log().c_str()),
+                                           type.get_apply_memorial_log().c_str()),
                                   pgettext("memorial_female",
-                                           effect_types[eff_id].get_apply_memorial_log().c_str()));
+                                           type.get_apply_memorial_log().c_str()));
         }
         // Perform any effect addition effects.
         bool reduced = has_effect(e.get_resist_effect()) || has_trait(e.get_resist_trait());
@@ -815,11 +806,12 @@ void Creature::clear_effects()
 }
 bool Creature::remove_effect(efftype_id eff_id, body_part bp)
 {
-    if (!has_effect(eff_id, bp)) {
+    const efftype_index eff_index = get_efftype_index( eff_id );
+    if (!has_effect(eff_index, bp)) {
         //Effect doesn't exist, so do nothing
         return false;
     }
-    
+
     if (is_player()) {
         // Print the removal message and add the memorial log if needed
         if(effect_types[eff_id].get_remove_message() != "") {
@@ -831,61 +823,49 @@ bool Creature::remove_effect(efftype_id eff_id, body_part bp)
                               pgettext("memorial_female",
                                        effect_types[eff_id].get_remove_memorial_log().c_str()));
     }
-    
+
     // num_bp means remove all of a given effect id
-    if (bp == num_bp) {
-        effects.erase(eff_id);
-    } else {
-        effects[eff_id].erase(bp);
-        // If there are no more effects of a given type remove the type map
-        if (effects[eff_id].empty()) {
-            effects.erase(eff_id);
-        }
-    }
+    effects.erase( eff_index, bp );
     return true;
 }
 bool Creature::has_effect(efftype_id eff_id, body_part bp) const
+{
+    return has_effect( get_efftype_index( eff_id ), bp );
+}
+bool Creature::has_effect(efftype_index eff_index, body_part bp) const
 {
     // num_bp means anything targeted or not
     if (bp == num_bp) {
-        return effects.find( eff_id ) != effects.end();
+        return effects.has( eff_index );
     } else {
-        auto got_outer = effects.find(eff_id);
-        if(got_outer != effects.end()) {
-            auto got_inner = got_outer->second.find(bp);
-            if (got_inner != got_outer->second.end()) {
-                return true;
-            }
-        }
-        return false;
+        return effects.find( eff_index, bp ) != nullptr;
     }
 }
 effect Creature::get_effect(efftype_id eff_id, body_part bp) const
 {
-    auto got_outer = effects.find(eff_id);
-    if(got_outer != effects.end()) {
-        auto got_inner = got_outer->second.find(bp);
-        if (got_inner != got_outer->second.end()) {
-            return got_inner->second;
-        }
+    const effect *found = effects.find( get_efftype_index( eff_id ), bp );
+    if( found != nullptr ) {
+        return *found;
     }
     return effect();
 }
 int Creature::get_effect_dur(efftype_id eff_id, body_part bp) const
 {
-    if(has_effect(eff_id, bp)) {
-        effect tmp = get_effect(eff_id, bp);
-        return tmp.get_duration();
-    }
-    return 0;
+    return get_effect_dur( get_efftype_index( eff_id ), bp );
+}
+int Creature::get_effect_dur(efftype_index eff_index, body_part bp) const
+{
+    const effect *found = effects.find( eff_index, bp );
+    return found != nullptr ? found->get_duration() : 0;
 }
 int Creature::get_effect_int(efftype_id eff_id, body_part bp) const
 {
-    if(has_effect(eff_id, bp)) {
-        effect tmp = get_effect(eff_id, bp);
-        return tmp.get_intensity();
-    }
-    return 0;
+    return get_effect_int( get_efftype_index( eff_id ), bp );
+}
+int Creature::get_effect_int(efftype_index eff_index, body_part bp) const
+{
+    const effect *found = effects.find( eff_index, bp );
+    return found != nullptr ? found->get_intensity() : 0;
 }
 void Creature::process_effects()
 {
@@ -896,16 +876,14 @@ void Creature::process_effects()
     std::vector<body_part> rem_bps;
     
     // Decay/removal of effects
-    for( auto &elem : effects ) {
-        for( auto &_it : elem.second ) {
-            // Add any effects that others remove to the removal list
-            for( const auto removed_effect : _it.second.get_removes_effects() ) {
-                rem_ids.push_back( removed_effect );
-                rem_bps.push_back(num_bp);
-            }
-            // Run decay effects, marking effects for removal as necessary.
-            _it.second.decay( rem_ids, rem_bps, calendar::turn, is_player() );
+    for( auto &eff : effects ) {
+        // Add any effects that others remove to the removal list
+        for( const auto &removed_effect : eff.get_removes_effects() ) {
+            rem_ids.push_back( removed_effect );
+            rem_bps.push_back(num_bp);
         }
+        // Run decay effects, marking effects for removal as necessary.
+        eff.decay( rem_ids, rem_bps, calendar::turn, is_player() );
     }
     
     // Actually remove effects. This should be the last thing done in process_effects().
@@ -261,12 +261,16 @@ class Creature
         /** Check if creature has the matching effect. bp = num_bp means to check if the Creature has any effect
          *  of the matching type, targeted or untargeted. */
         bool has_effect(efftype_id eff_id, body_part bp = num_bp) const;
+        /** Same as above, but doesn't need to look up the effect id, see @ref get_efftype_index. */
+        bool has_effect(efftype_index eff_index, body_part bp = num_bp) const;
         /** Return the effect that matches the given arguments exactly. */
         effect get_effect(efftype_id eff_id, body_part bp = num_bp) const;
         /** Returns the duration of the matching effect. Returns 0 if effect doesn't exist. */
         int get_effect_dur(efftype_id eff_id, body_part bp = num_bp) const;
+        int get_effect_dur(efftype_index eff_index, body_part bp = num_bp) const;
         /** Returns the intensity of the matching effect. Returns 0 if effect doesn't exist. */
         int get_effect_int(efftype_id eff_id, body_part bp = num_bp) const;
+        int get_effect_int(efftype_index eff_index, body_part bp = num_bp) const;
 
         // Methods for setting/getting misc key/value pairs.
         void set_value( const std::string key, const std::string value );
@@ -467,8 +471,7 @@ class Creature
         Creature *killer; // whoever killed us. this should be NULL unless we are dead
         void set_killer( Creature *killer );
 
-        // Storing body_part as an int to make things easier for hash and JSON
-        std::unordered_map<std::string, std::unordered_map<body_part, effect, std::hash<int>>> effects;
+        effect_table effects;
         // Miscellaneous key/value pairs.
         std::unordered_map<std::string, std::string> values;
 
@@ -2,9 +2,53 @@
 #include "mongroup.h"
 #include "output.h"
 #include "debug.h"
+#include "map.h"
+
+#include <algorithm>
+
+static const int TILE_GRID_WIDTH = SEEX * MAPSIZE;
+static const int TILE_GRID_HEIGHT = SEEY * MAPSIZE;
 
 Creature_tracker::Creature_tracker()
+    : monsters_by_tile( TILE_GRID_WIDTH * TILE_GRID_HEIGHT, tile_entry{ -1, 0 } )
+    , tile_grid_complete( true )
+{
+}
+
+Creature_tracker::tile_entry *Creature_tracker::tile_at( const tripoint &p )
+{
+    if( p.x < 0 || p.x >= TILE_GRID_WIDTH || p.y < 0 || p.y >= TILE_GRID_HEIGHT ) {
+        return nullptr;
+    }
+    return &monsters_by_tile[p.x * TILE_GRID_HEIGHT + p.y];
+}
+
+const Creature_tracker::tile_entry *Creature_tracker::tile_at( const tripoint &p ) const
+{
+    return const_cast<Creature_tracker *>( this )->tile_at( p );
+}
+
+void Creature_tracker::set_location( const tripoint &p, const size_t index )
 {
+    monsters_by_location[p] = index;
+    tile_entry *const tile = tile_at( p );
+    if( tile == nullptr ) {
+        return;
+    }
+    if( tile->index >= 0 && tile->z != p.z ) {
+        tile_grid_complete = false;
+    }
+    tile->index = index;
+    tile->z = p.z;
+}
+
+void Creature_tracker::erase_location( const tripoint &p )
+{
+    monsters_by_location.erase( p );
+    tile_entry *const tile = tile_at( p );
+    if( tile != nullptr && tile->z == p.z ) {
+        tile->index = -1;
+    }
 }
 
 Creature_tracker::~Creature_tracker()
@@ -26,6 +70,14 @@ monster &Creature_tracker::find(int index)
 
 int Creature_tracker::mon_at( const tripoint &coords ) const
 {
+    const tile_entry *const tile = tile_at( coords );
+    if( tile != nullptr && tile_grid_complete ) {
+        if( tile->index < 0 || tile->z != coords.z || monsters_list[tile->index]->is_dead() ) {
+            return -1;
+        }
+        return tile->index;
+    }
+
     const auto iter = monsters_by_location.find( coords );
     if( iter != monsters_by_location.end() ) {
         const int critter_id = iter->second;
@@ -53,7 +105,7 @@ bool Creature_tracker::add( monster &critter )
         return false;
     }
 
-    monsters_by_location[critter.pos3()] = monsters_list.size();
+    set_location( critter.pos3(), monsters_list.size() );
     monsters_list.push_back(new monster(critter));
     return true;
 }
@@ -81,8 +133,8 @@ bool Creature_tracker::update_pos(const monster &critter, const tripoint &new_po
                  new_pos.x, new_pos.y, new_pos.z, new_critter_id);
     } else if( critter_id >= 0 ) {
         if( &critter == monsters_list[critter_id] ) {
-            monsters_by_location.erase( old_pos );
-            monsters_by_location[new_pos] = critter_id;
+            erase_location( old_pos );
+            set_location( new_pos, critter_id );
             success = true;
         } else {
             debugmsg("update_zombie_pos: old location %d,%d had zombie %d instead",
@@ -107,7 +159,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
     if( pos_iter != monsters_by_location.end() ) {
         const auto &other = find( pos_iter->second );
         if( &other == &critter ) {
-            monsters_by_location.erase( pos_iter );
+            erase_location( loc );
         }
     }
 }
@@ -130,6 +182,10 @@ void Creature_tracker::remove( const int idx )
     for( auto &elem : monsters_by_location ) {
         if( elem.second > (size_t)idx ) {
             --elem.second;
+            tile_entry *const tile = tile_at( elem.first );
+            if( tile != nullptr && tile->z == elem.first.z ) {
+                tile->index = elem.second;
+            }
         }
     }
 }
@@ -141,14 +197,18 @@ void Creature_tracker::clear()
     }
     monsters_list.clear();
     monsters_by_location.clear();
+    std::fill( monsters_by_tile.begin(), monsters_by_tile.end(), tile_entry{ -1, 0 } );
+    tile_grid_complete = true;
 }
 
 void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    std::fill( monsters_by_tile.begin(), monsters_by_tile.end(), tile_entry{ -1, 0 } );
+    tile_grid_complete = true;
     for( size_t i = 0; i < monsters_list.size(); i++ ) {
         monster &critter = *monsters_list[i];
-        monsters_by_location[critter.pos3()] = i;
+        set_location( critter.pos3(), i );
     }
 }
 
@@ -33,6 +33,24 @@ class Creature_tracker
         std::unordered_map<tripoint, size_t> monsters_by_location;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+
+        /** An entry of @ref monsters_by_location that is mirrored in @ref monsters_by_tile. */
+        struct tile_entry {
+            int index;
+            int z;
+        };
+        /**
+         * Dense copy of the entries of @ref monsters_by_location that are inside the
+         * reality bubble, so @ref mon_at does not need to hash. Only x and y are used as
+         * index, if two entries differ only in z, the grid is incomplete and mon_at falls
+         * back to the map until the next @ref rebuild_cache.
+         */
+        std::vector<tile_entry> monsters_by_tile;
+        bool tile_grid_complete;
+        tile_entry *tile_at( const tripoint &p );
+        const tile_entry *tile_at( const tripoint &p ) const;
+        void set_location( const tripoint &p, size_t index );
+        void erase_location( const tripoint &p );
 };
 
 #endif
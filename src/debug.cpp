@@ -8,6 +8,13 @@
 #include <iosfwd>
 #include <fstream>
 #include <streambuf>
+#include <sstream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
 #include <sys/stat.h>
 
 #ifndef _MSC_VER
@@ -32,6 +39,19 @@ static int debugClass = D_MAIN;
 
 bool debug_mode = false;
 
+// Pointer, not the collector itself, a thread_local object would need a destructor.
+static thread_local debugmsg_collector *active_collector = nullptr;
+
+debugmsg_collector::debugmsg_collector() : previous( active_collector )
+{
+    active_collector = this;
+}
+
+debugmsg_collector::~debugmsg_collector()
+{
+    active_collector = previous;
+}
+
 void realDebugmsg( const char *filename, const char *line, const char *mes, ... )
 {
     va_list ap;
@@ -39,6 +59,10 @@ void realDebugmsg( const char *filename, const char *line, const char *mes, ...
     const std::string text = vstring_format( mes, ap );
     va_end( ap );
     DebugLog( D_ERROR, D_MAIN ) << filename << ":" << line << " " << text;
+    if( active_collector != nullptr ) {
+        active_collector->messages.push_back( std::string( filename ) + ":" + line + " " + text );
+        return;
+    }
     fold_and_print( stdscr, 0, 0, getmaxx( stdscr ), c_ltred, "DEBUG: %s\n  Press spacebar...",
                     text.c_str() );
     while( getch() != ' ' ) {
@@ -73,17 +97,153 @@ void *tracePtrs[TRACE_SIZE];
 // Debug Includes                                                   {{{2
 // ---------------------------------------------------------------------
 
-// Null OStream                                                     {{{2
+// Time stamps                                                      {{{2
 // ---------------------------------------------------------------------
 
-struct NullBuf : public std::streambuf {
-    NullBuf() {}
-    int overflow( int c )
-    {
-        return c;
+struct time_info {
+    int hours;
+    int minutes;
+    int seconds;
+    int mseconds;
+
+    template <typename Stream>
+    friend Stream& operator<<(Stream& out, time_info const& t) {
+        using char_t = typename Stream::char_type;
+        using base   = std::basic_ostream<char_t>;
+
+        static_assert(std::is_base_of<base, Stream>::value, "");
+
+        out << t.hours << ':' << t.minutes << ':' << t.seconds << '.' << t.mseconds;
+
+        return out;
     }
 };
 
+time_info get_time( const std::chrono::system_clock::time_point &time ) noexcept {
+    auto const tt      = std::chrono::system_clock::to_time_t( time );
+    auto const msecs   = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             time.time_since_epoch() ).count() % 1000;
+    // Called from the writer thread and from any thread after shutdown.
+    struct tm current;
+#if (defined _WIN32 || defined WINDOWS)
+    localtime_s( &current, &tt );
+#else
+    localtime_r( &tt, &current );
+#endif
+
+    return time_info { current.tm_hour, current.tm_min, current.tm_sec,
+            static_cast<int>( msecs ) };
+}
+
+// Asynchronous log writer                                          {{{2
+// ---------------------------------------------------------------------
+
+/**
+ * A logged line is formatted by the logging thread into a thread local stream.
+ * At the end of the logging statement, the finished line is moved into a
+ * fixed size lock-free ring buffer, from where a background thread writes it
+ * to the log file. Formatting the time stamp is left to that thread as well.
+ *
+ * Memory use is bounded: the ring buffer has a fixed number of slots and lines
+ * are truncated to a maximal length. Lines that don't fit into the ring buffer
+ * and lines exceeding the rate limit of their debug class are dropped, the
+ * number of dropped lines is written to the log instead.
+ */
+struct LogEntry {
+    std::atomic<size_t> sequence;
+    std::chrono::system_clock::time_point time;
+    std::string text;
+};
+
+/** Bounded multi-producer multi-consumer queue (see Dmitry Vyukov's design). */
+class LogRing
+{
+    public:
+        // Must be a power of two.
+        static constexpr size_t capacity = 2048;
+        static constexpr size_t max_line_length = 4096;
+
+        LogRing()
+        {
+            for( size_t i = 0; i < capacity; i++ ) {
+                entries[i].sequence.store( i, std::memory_order_relaxed );
+            }
+            enqueue_pos.store( 0, std::memory_order_relaxed );
+            dequeue_pos.store( 0, std::memory_order_relaxed );
+        }
+
+        /** Moves text into the queue, returns false if the queue is full. */
+        bool push( const std::chrono::system_clock::time_point &time, std::string &text )
+        {
+            size_t pos = enqueue_pos.load( std::memory_order_relaxed );
+            LogEntry *entry;
+            while( true ) {
+                entry = &entries[pos & ( capacity - 1 )];
+                const size_t seq = entry->sequence.load( std::memory_order_acquire );
+                const intptr_t dif = intptr_t( seq ) - intptr_t( pos );
+                if( dif == 0 ) {
+                    if( enqueue_pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+                        break;
+                    }
+                } else if( dif < 0 ) {
+                    return false;
+                } else {
+                    pos = enqueue_pos.load( std::memory_order_relaxed );
+                }
+            }
+            if( text.size() > max_line_length ) {
+                text.resize( max_line_length );
+            }
+            entry->time = time;
+            entry->text.swap( text );
+            entry->sequence.store( pos + 1, std::memory_order_release );
+            return true;
+        }
+
+        /** Moves the oldest line out of the queue, returns false if the queue is empty. */
+        bool pop( std::chrono::system_clock::time_point &time, std::string &text )
+        {
+            size_t pos = dequeue_pos.load( std::memory_order_relaxed );
+            LogEntry *entry;
+            while( true ) {
+                entry = &entries[pos & ( capacity - 1 )];
+                const size_t seq = entry->sequence.load( std::memory_order_acquire );
+                const intptr_t dif = intptr_t( seq ) - intptr_t( pos + 1 );
+                if( dif == 0 ) {
+                    if( dequeue_pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+                        break;
+                    }
+                } else if( dif < 0 ) {
+                    return false;
+                } else {
+                    pos = dequeue_pos.load( std::memory_order_relaxed );
+                }
+            }
+            time = entry->time;
+            text.swap( entry->text );
+            // Don't keep a large buffer around in the slot.
+            entry->text.clear();
+            entry->sequence.store( pos + capacity, std::memory_order_release );
+            return true;
+        }
+
+    private:
+        LogEntry entries[capacity];
+        std::atomic<size_t> enqueue_pos;
+        std::atomic<size_t> dequeue_pos;
+};
+
+/** Number of bits in DebugClass, each one has its own rate limit. */
+static constexpr int debug_class_count = 30;
+/** Lines per second and debug class that are written, the rest is dropped. */
+static constexpr int max_lines_per_second = 100;
+
+struct RateLimit {
+    std::atomic<long> second;
+    std::atomic<int> count;
+    std::atomic<int> dropped;
+};
+
 // DebugFile OStream Wrapper                                        {{{2
 // ---------------------------------------------------------------------
 
@@ -92,33 +252,179 @@ struct DebugFile {
     ~DebugFile();
     void init( std::string filename );
     void deinit();
+    /** Whether deinit has been called, lines go to stderr from then on. */
+    std::atomic<bool> shut_down;
+
+    /** Queue a finished line, or count it as dropped. */
+    void enqueue( const std::chrono::system_clock::time_point &time, std::string &text );
+    /** Whether a line of this class exceeds the rate limit (it is counted as dropped then). */
+    bool rate_limited( DebugClass cl );
 
     std::ofstream &currentTime();
     std::ofstream file;
     std::string filename;
-};
 
-static NullBuf nullBuf;
-static std::ostream nullStream( &nullBuf );
+    private:
+        /** Body of the writer thread. */
+        void write_loop();
+        /** Write all queued lines and the drop counters to the file. */
+        void write_queued();
+
+        LogRing queue;
+        std::thread writer;
+        std::atomic<bool> running;
+        std::mutex wakeup_mutex;
+        std::condition_variable wakeup;
+        std::atomic<int> dropped_full;
+        RateLimit rate_limits[debug_class_count];
+};
 
 // DebugFile OStream Wrapper                                        {{{2
 // ---------------------------------------------------------------------
 
 static DebugFile debugFile;
 
+/** A line the current thread is writing, see @ref LogRing. */
+struct PendingLine {
+    std::ostringstream stream;
+    std::chrono::system_clock::time_point time;
+
+    void commit()
+    {
+        std::string text = stream.str();
+        stream.str( std::string() );
+        stream.clear();
+        debugFile.enqueue( time, text );
+    }
+};
+
+/**
+ * The lines the current thread is writing. Usually only one, but the arguments
+ * of a logging statement may log lines of their own. The streams are reused.
+ */
+struct PendingLines {
+    std::vector<std::unique_ptr<PendingLine>> lines;
+    size_t active = 0;
+};
+
+static PendingLines &pending_lines()
+{
+    static thread_local PendingLines lines;
+    return lines;
+}
+
+DebugLogLine::~DebugLogLine()
+{
+    if( out == nullptr ) {
+        return;
+    }
+    // Nested lines end before the line they are nested in.
+    PendingLines &pending = pending_lines();
+    pending.lines[--pending.active]->commit();
+}
+
 DebugFile::DebugFile()
+    : shut_down( false )
+    , running( false )
+    , dropped_full( 0 )
 {
+    for( auto &limit : rate_limits ) {
+        limit.second = 0;
+        limit.count = 0;
+        limit.dropped = 0;
+    }
 }
 
 DebugFile::~DebugFile()
 {
-    if( file.is_open() ) {
-        deinit();
+    // Only does something without deinitDebug, when exit() is called early
+    // on. The writer thread runs even if the file could not be opened.
+    deinit();
+}
+
+void DebugFile::enqueue( const std::chrono::system_clock::time_point &time, std::string &text )
+{
+    if( shut_down ) {
+        std::cerr << get_time( time ) << " " << text << std::endl;
+        return;
+    }
+    if( !queue.push( time, text ) ) {
+        dropped_full++;
+        return;
+    }
+    wakeup.notify_one();
+}
+
+bool DebugFile::rate_limited( const DebugClass cl )
+{
+    int index = 0;
+    while( index + 1 < debug_class_count && !( cl & ( 1 << index ) ) ) {
+        index++;
+    }
+    RateLimit &limit = rate_limits[index];
+    const long now = std::chrono::duration_cast<std::chrono::seconds>(
+                         std::chrono::steady_clock::now().time_since_epoch() ).count();
+    if( limit.second.exchange( now ) != now ) {
+        limit.count = 0;
+    }
+    if( ++limit.count > max_lines_per_second ) {
+        limit.dropped++;
+        return true;
+    }
+    return false;
+}
+
+void DebugFile::write_loop()
+{
+    while( running ) {
+        write_queued();
+        std::unique_lock<std::mutex> lock( wakeup_mutex );
+        // Lines are batched, a line that is queued without waking us is
+        // written after the timeout.
+        wakeup.wait_for( lock, std::chrono::milliseconds( 100 ) );
+    }
+    write_queued();
+}
+
+void DebugFile::write_queued()
+{
+    std::chrono::system_clock::time_point time;
+    std::string text;
+    bool wrote = false;
+    while( queue.pop( time, text ) ) {
+        file << "\n" << get_time( time ) << " " << text;
+        wrote = true;
+    }
+    const int full = dropped_full.exchange( 0 );
+    if( full > 0 ) {
+        file << "\n";
+        currentTime() << " : " << full << " lines dropped, the log queue was full.";
+        wrote = true;
+    }
+    for( int i = 0; i < debug_class_count; i++ ) {
+        const int limited = rate_limits[i].dropped.exchange( 0 );
+        if( limited > 0 ) {
+            file << "\n";
+            currentTime() << " : " << limited << " lines dropped, more than " << max_lines_per_second <<
+                          " lines per second of class " << DebugClass( 1 << i );
+            wrote = true;
+        }
+    }
+    if( wrote ) {
+        file.flush();
     }
 }
 
 void DebugFile::deinit()
 {
+    if( shut_down.exchange( true ) ) {
+        return;
+    }
+    if( writer.joinable() ) {
+        running = false;
+        wakeup.notify_one();
+        writer.join();
+    }
     file << "\n";
     currentTime() << " : Log shutdown.\n";
     file << "-----------------------------------------\n\n";
@@ -140,6 +446,8 @@ void DebugFile::init( std::string filename )
     file.open( filename.c_str(), std::ios::out | std::ios::app );
     file << "\n\n-----------------------------------------\n";
     currentTime() << " : Starting log.";
+    running = true;
+    writer = std::thread( &DebugFile::write_loop, this );
     if( rename_failed ) {
         DebugLog( D_ERROR, DC_ALL ) << "Moving the previous log file to " << oldfile << " failed.\n" <<
                                        "Check the file permissions. This program will continue to use the previous log file.";
@@ -247,66 +555,36 @@ std::ostream &operator<<( std::ostream &out, DebugClass cl )
     return out;
 }
 
-struct time_info {
-    int hours;
-    int minutes;
-    int seconds;
-    int mseconds;
-
-    template <typename Stream>
-    friend Stream& operator<<(Stream& out, time_info const& t) {
-        using char_t = typename Stream::char_type;
-        using base   = std::basic_ostream<char_t>;
-
-        static_assert(std::is_base_of<base, Stream>::value, "");
-
-        out << t.hours << ':' << t.minutes << ':' << t.seconds << '.' << t.mseconds;
-
-        return out;
-    }
-};
-
-#ifdef _MSC_VER
-time_info get_time() noexcept {
-    SYSTEMTIME time {};
-
-    GetLocalTime(&time);
-
-    return time_info { static_cast<int>(time.wHour), static_cast<int>(time.wMinute),
-            static_cast<int>(time.wSecond), static_cast<int>(time.wMilliseconds) };
-}
-#else
-time_info get_time() noexcept {
-    timeval tv;
-    gettimeofday( &tv, nullptr );
-
-    auto const tt      = time_t {tv.tv_sec};
-    auto const current = localtime( &tt );
-
-    return time_info { current->tm_hour, current->tm_min, current->tm_sec,
-            static_cast<int>(tv.tv_usec / 1000.0 + 0.5) };
-}
-#endif
-
 std::ofstream &DebugFile::currentTime()
 {
-    return (file << get_time());
+    file << get_time( std::chrono::system_clock::now() );
+    return file;
 }
 
-std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
+DebugLogLine DebugLog( DebugLevel lev, DebugClass cl )
 {
     // Error are always logged, they are important,
     // Messages from D_MAIN come from debugmsg and are equally important.
     if( ( ( lev & debugLevel ) && ( cl & debugClass ) ) || lev & D_ERROR || cl & D_MAIN ) {
-        debugFile.file << std::endl;
-        debugFile.currentTime() << " ";
+        // But messages from a hot loop must not bring the game to a halt,
+        // errors and debugmsg are never dropped.
+        if( !( lev & D_ERROR ) && !( cl & D_MAIN ) && debugFile.rate_limited( cl ) ) {
+            return DebugLogLine( nullptr );
+        }
+        PendingLines &pending = pending_lines();
+        if( pending.active == pending.lines.size() ) {
+            pending.lines.emplace_back( new PendingLine() );
+        }
+        PendingLine &line = *pending.lines[pending.active++];
+        line.time = std::chrono::system_clock::now();
+        std::ostream &out = line.stream;
         if( lev != debugLevel ) {
-            debugFile.file << lev;
+            out << lev;
         }
         if( cl != debugClass ) {
-            debugFile.file << cl;
+            out << cl;
         }
-        debugFile.file << ": ";
+        out << ": ";
 
         // Backtrace on error.
 #if !(defined _WIN32 || defined WINDOWS || defined __CYGWIN__)
@@ -314,16 +592,16 @@ std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
             int count = backtrace( tracePtrs, TRACE_SIZE );
             char **funcNames = backtrace_symbols( tracePtrs, count );
             for( int i = 0; i < count; ++i ) {
-                debugFile.file << "\n\t(" << funcNames[i] << "), ";
+                out << "\n\t(" << funcNames[i] << "), ";
             }
-            debugFile.file << "\n\t";
+            out << "\n\t";
             free( funcNames );
         }
 #endif
 
-        return debugFile.file;
+        return DebugLogLine( &out );
     }
-    return nullStream;
+    return DebugLogLine( nullptr );
 }
 
 // vim:tw=72:sw=1:fdm=marker:fdl=0:
@@ -19,7 +19,8 @@
  * It returns a reference to an outputs stream. Simply write your message into
  * that stream (using the << operators).
  * DebugLog always returns a stream that starts on a new line. Don't add a
- * newline at the end of your debug message.
+ * newline at the end of your debug message. The line is written when the
+ * statement ends, don't keep the returned object around.
  * If the specific debug level or class have been disabled, the message is
  * actually discarded, otherwise it is written to a log file (FILENAMES["debug"]).
  * If a single source file contains mostly messages for the same debug class
@@ -42,6 +43,7 @@
 // Includes                                                         {{{1
 // ---------------------------------------------------------------------
 #include <iostream>
+#include <string>
 #include <vector>
 
 #define STRING2(x) #x
@@ -57,6 +59,27 @@
 // Don't use this, use debugmsg instead.
 void realDebugmsg( const char *name, const char *line, const char *mes, ... );
 
+/**
+ * While an instance of this exists, @ref debugmsg on the calling thread only logs
+ * the message and adds it to @ref messages instead of showing it. Worker threads
+ * must not use the screen, the main thread shows the messages after the work is done.
+ */
+class debugmsg_collector
+{
+    public:
+        debugmsg_collector();
+        ~debugmsg_collector();
+
+        debugmsg_collector( const debugmsg_collector & ) = delete;
+        debugmsg_collector &operator=( const debugmsg_collector & ) = delete;
+
+        /** The collected messages, each prefixed with its source file and line. */
+        std::vector<std::string> messages;
+
+    private:
+        debugmsg_collector *previous;
+};
+
 // Enumerations                                                     {{{1
 // ---------------------------------------------------------------------
 
@@ -97,7 +120,10 @@ enum DebugClass {
 
 /** Initializes the debugging system, called exactly once from main() */
 void setupDebug();
-/** Opposite of setupDebug, shuts the debugging system down. */
+/**
+ * Opposite of setupDebug, shuts the debugging system down. Call it last, lines that
+ * are logged afterwards are only written to stderr.
+ */
 void deinitDebug();
 
 // Function Declatations                                            {{{1
@@ -118,8 +144,38 @@ void limitDebugClass( int );
 // Debug Only                                                       {{{1
 // ---------------------------------------------------------------------
 
+/**
+ * A line of the debug log, returned by @ref DebugLog. The line is complete and handed
+ * to the log writer when this temporary is destroyed at the end of the statement.
+ */
+class DebugLogLine
+{
+    public:
+        DebugLogLine( std::ostream *out ) : out( out ) {
+        }
+        DebugLogLine( DebugLogLine &&other ) : out( other.out ) {
+            other.out = nullptr;
+        }
+        ~DebugLogLine();
+
+        DebugLogLine( const DebugLogLine & ) = delete;
+        DebugLogLine &operator=( const DebugLogLine & ) = delete;
+
+        template<typename T>
+        DebugLogLine &operator<<( const T &value ) {
+            if( out != nullptr ) {
+                *out << value;
+            }
+            return *this;
+        }
+
+    private:
+        /** Null if the line is not logged. */
+        std::ostream *out;
+};
+
 // See documentation at the top.
-std::ostream &DebugLog( DebugLevel, DebugClass );
+DebugLogLine DebugLog( DebugLevel, DebugClass );
 
 // OStream operators                                                {{{1
 // ---------------------------------------------------------------------
@@ -1036,6 +1036,7 @@ int editmap::edit_fld()
                     }
                 }
                 update_fmenu_entry( &fmenu, cur_field, idx );
+                g->m.set_transparency_cache_dirty();
                 update_view(true);
                 sel_field = fmenu.selected;
                 sel_fdensity = fsel_dens;
@@ -1054,6 +1055,7 @@ int editmap::edit_fld()
                     }
                 }
             }
+            g->m.set_transparency_cache_dirty();
             update_view(true);
             sel_field = fmenu.selected;
             sel_fdensity = 0;
@@ -1653,6 +1655,7 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                             submap *destsm = g->m.get_submap_at_grid(target_sub.x + x, target_sub.y + y);
                             submap *srcsm = tmpmap.get_submap_at_grid(x, y);
                             destsm->is_uniform = false;
+                            destsm->dirty = true;
                             srcsm->is_uniform = false;
 
                             for( auto & v : destsm->vehicles ) {
@@ -1682,6 +1685,7 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                             for ( int sx = 0; sx < 12; sx++ ) { // copy fields
                                 for ( int sy = 0; sy < 12; sy++ ) {
                                     destsm->fld[sx][sy] = srcsm->fld[sx][sy];
+                                    destsm->update_field_tile( sx, sy );
                                 }
                             }
                             destsm->field_count = srcsm->field_count; // and count
@@ -1694,6 +1698,8 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                             for (int x = 0; x < SEEX; ++x) {
                                 for (int y = 0; y < SEEY; ++y) {
                                     destsm->itm[x][y].swap( srcsm->itm[x][y] );
+                                    destsm->update_item_tile( x, y );
+                                    srcsm->update_item_tile( x, y );
                                     destsm->cosmetics[x][y].swap( srcsm->cosmetics[x][y] );
                                 }
                             }
@@ -1712,6 +1718,7 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                         }
                     }
                     g->m.reset_vehicle_cache();
+                    g->m.set_pathing_cache_dirty();
 
                     //~ message when applying the map generator
                     popup(_("Changed 4 submaps\n%s"), s.c_str());
@@ -4,9 +4,23 @@
 #include "player.h"
 #include <map>
 #include <sstream>
+#include <algorithm>
 
 std::map<std::string, effect_type> effect_types;
 
+efftype_index get_efftype_index( const efftype_id &id )
+{
+    // Never cleared, the indices must not change while creatures store them.
+    static std::unordered_map<efftype_id, efftype_index> indices;
+    auto iter = indices.find( id );
+    if( iter != indices.end() ) {
+        return iter->second;
+    }
+    const efftype_index index = indices.size();
+    indices[id] = index;
+    return index;
+}
+
 void weed_msg(player *p) {
     int howhigh = p->get_effect_dur("weed_high");
     int smarts = p->get_int();
@@ -1064,6 +1078,8 @@ void load_effect_type(JsonObject &jo)
 {
     effect_type new_etype;
     new_etype.id = jo.get_string("id");
+    // Give the type its index now, not in the middle of a game turn.
+    get_efftype_index( new_etype.id );
 
     if(jo.has_member("name")) {
         JsonArray jsarr = jo.get_array("name");
@@ -1152,6 +1168,116 @@ void reset_effect_types()
     effect_types.clear();
 }
 
+effect_table::effect_table( const effect_table &other )
+{
+    *this = other;
+}
+
+effect_table &effect_table::operator=( const effect_table &other )
+{
+    if( this == &other ) {
+        return *this;
+    }
+    slots.clear();
+    slots.reserve( other.slots.size() );
+    for( auto &s : other.slots ) {
+        slots.push_back( slot{ s.type, s.bp, std::unique_ptr<effect>( new effect( *s.eff ) ) } );
+    }
+    return *this;
+}
+
+static bool slot_before( const efftype_index type_a, const body_part bp_a,
+                         const efftype_index type_b, const body_part bp_b )
+{
+    return type_a < type_b || ( type_a == type_b && bp_a < bp_b );
+}
+
+effect_table::container::iterator effect_table::lower_bound( const efftype_index type,
+        const body_part bp )
+{
+    return std::lower_bound( slots.begin(), slots.end(), key( type, bp ),
+    []( const slot & s, const key & k ) {
+        return slot_before( s.type, s.bp, k.first, k.second );
+    } );
+}
+
+effect_table::container::const_iterator effect_table::lower_bound( const efftype_index type,
+        const body_part bp ) const
+{
+    return std::lower_bound( slots.begin(), slots.end(), key( type, bp ),
+    []( const slot & s, const key & k ) {
+        return slot_before( s.type, s.bp, k.first, k.second );
+    } );
+}
+
+effect *effect_table::find( const efftype_index type, const body_part bp )
+{
+    auto iter = lower_bound( type, bp );
+    if( iter == slots.end() || iter->type != type || iter->bp != bp ) {
+        return nullptr;
+    }
+    return iter->eff.get();
+}
+
+const effect *effect_table::find( const efftype_index type, const body_part bp ) const
+{
+    auto iter = lower_bound( type, bp );
+    if( iter == slots.end() || iter->type != type || iter->bp != bp ) {
+        return nullptr;
+    }
+    return iter->eff.get();
+}
+
+bool effect_table::has( const efftype_index type ) const
+{
+    // body_part values start at 0, this finds the first effect of the type.
+    auto iter = lower_bound( type, body_part( 0 ) );
+    return iter != slots.end() && iter->type == type;
+}
+
+effect &effect_table::set( const efftype_index type, const body_part bp, const effect &eff )
+{
+    auto iter = lower_bound( type, bp );
+    if( iter != slots.end() && iter->type == type && iter->bp == bp ) {
+        *iter->eff = eff;
+        return *iter->eff;
+    }
+    iter = slots.insert( iter, slot{ type, bp, std::unique_ptr<effect>( new effect( eff ) ) } );
+    return *iter->eff;
+}
+
+bool effect_table::erase( const efftype_index type, const body_part bp )
+{
+    if( bp != num_bp ) {
+        auto iter = lower_bound( type, bp );
+        if( iter == slots.end() || iter->type != type || iter->bp != bp ) {
+            return false;
+        }
+        slots.erase( iter );
+        return true;
+    }
+    auto first = lower_bound( type, body_part( 0 ) );
+    auto last = first;
+    while( last != slots.end() && last->type == type ) {
+        ++last;
+    }
+    if( first == last ) {
+        return false;
+    }
+    slots.erase( first, last );
+    return true;
+}
+
+std::vector<effect_table::key> effect_table::keys() const
+{
+    std::vector<key> result;
+    result.reserve( slots.size() );
+    for( auto &s : slots ) {
+        result.push_back( key( s.type, s.bp ) );
+    }
+    return result;
+}
+
 void effect::serialize(JsonOut &json) const
 {
     json.start_object();
@@ -7,6 +7,9 @@
 #include "enums.h"
 #include <unordered_map>
 #include <tuple>
+#include <vector>
+#include <memory>
+#include <iterator>
 
 class effect_type;
 class Creature;
@@ -14,6 +17,16 @@ class player;
 
 extern std::map<std::string, effect_type> effect_types;
 
+/** Compact integer id of an effect type, see @ref get_efftype_index. */
+typedef int efftype_index;
+
+/**
+ * Returns the integer index of the effect type id. Indices are assigned when effect
+ * types are loaded (or when an id is first used) and stay the same until the program
+ * ends. Code that checks an effect often should keep the index in a static variable.
+ */
+efftype_index get_efftype_index( const efftype_id &id );
+
 /** Handles the large variety of weed messages. */
 void weed_msg(player *p);
 
@@ -240,6 +253,109 @@ class effect : public JsonSerializer, public JsonDeserializer
 
 };
 
+/**
+ * The effects of a creature, sorted by effect type index and body part.
+ * Creatures only have a few effects at a time, searching a small sorted vector of integer
+ * keys is much faster than hashing the effect id string.
+ * The effect objects are allocated separately, references to them stay valid when other
+ * effects are added or removed (but not if the effect itself is removed).
+ */
+class effect_table
+{
+    private:
+        struct slot {
+            efftype_index type;
+            body_part bp;
+            std::unique_ptr<effect> eff;
+        };
+        typedef std::vector<slot> container;
+
+        template<typename Base, typename Value>
+        class iterator_base : public std::iterator<std::forward_iterator_tag, Value>
+        {
+            public:
+                iterator_base( const Base &it ) : it( it ) { }
+                Value &operator*() const
+                {
+                    return *it->eff;
+                }
+                Value *operator->() const
+                {
+                    return it->eff.get();
+                }
+                iterator_base &operator++()
+                {
+                    ++it;
+                    return *this;
+                }
+                bool operator==( const iterator_base &rhs ) const
+                {
+                    return it == rhs.it;
+                }
+                bool operator!=( const iterator_base &rhs ) const
+                {
+                    return it != rhs.it;
+                }
+            private:
+                Base it;
+        };
+
+    public:
+        typedef iterator_base<container::iterator, effect> iterator;
+        typedef iterator_base<container::const_iterator, const effect> const_iterator;
+        typedef std::pair<efftype_index, body_part> key;
+
+        effect_table() = default;
+        effect_table( const effect_table &other );
+        effect_table( effect_table && ) = default;
+        effect_table &operator=( const effect_table &other );
+        effect_table &operator=( effect_table && ) = default;
+
+        iterator begin()
+        {
+            return iterator( slots.begin() );
+        }
+        iterator end()
+        {
+            return iterator( slots.end() );
+        }
+        const_iterator begin() const
+        {
+            return const_iterator( slots.begin() );
+        }
+        const_iterator end() const
+        {
+            return const_iterator( slots.end() );
+        }
+        bool empty() const
+        {
+            return slots.empty();
+        }
+        void clear()
+        {
+            slots.clear();
+        }
+
+        /** Returns the effect of the given type on the body part, or nullptr. */
+        effect *find( efftype_index type, body_part bp );
+        const effect *find( efftype_index type, body_part bp ) const;
+        /** Returns whether there is an effect of the given type on any body part (or untargeted). */
+        bool has( efftype_index type ) const;
+        /** Stores the effect, replacing the existing effect of that type on that body part. */
+        effect &set( efftype_index type, body_part bp, const effect &eff );
+        /** Removes the effect of the type from the body part, bp = num_bp means from all body
+         *  parts. Returns whether anything was removed. */
+        bool erase( efftype_index type, body_part bp );
+        /** Returns the keys of all effects, to iterate over while effects are added or removed. */
+        std::vector<key> keys() const;
+
+    private:
+        container::iterator lower_bound( efftype_index type, body_part bp );
+        container::const_iterator lower_bound( efftype_index type, body_part bp ) const;
+
+        container slots;
+};
+
 void load_effect_type(JsonObject &jo);
 void reset_effect_types();
 
@@ -409,23 +409,17 @@ void map::create_hot_air( int x, int y, int density )
 
 bool map::process_fields()
 {
+ rng_stream_scope rng_scope( RNG_FIELD );
  bool found_field = false;
+ const map &cmap = *this;
  for (int x = 0; x < my_MAPSIZE; x++) {
   for (int y = 0; y < my_MAPSIZE; y++) {
-   submap * const current_submap = get_submap_at_grid(x, y);
-   if (current_submap->field_count > 0)
-    found_field |= process_fields_in_submap(current_submap, x, y);
+   if (cmap.get_submap_at_grid(x, y)->field_count > 0)
+    found_field |= process_fields_in_submap(get_submap_at_grid(x, y), x, y);
   }
  }
- if (found_field) {
-     // For now, just always dirty the transparency cache
-     // when a field might possibly be changed.
-     // TODO: check if there are any fields(mostly fire)
-     //       that frequently change, if so set the dirty
-     //       flag, otherwise only set the dirty flag if
-     //       something actually changed
-     set_transparency_cache_dirty();
- }
+ // The transparency cache is dirtied by process_fields_in_submap and add_field
+ // when a field that blocks sight changes.
  return found_field;
 }
 
@@ -440,6 +434,8 @@ bool map::process_fields_in_submap( submap *const current_submap,
 {
     // Realistically this is always true, this function only gets called if fields exist.
     bool found_field = false;
+    // Fields age even if nothing else happens to them.
+    current_submap->dirty = true;
     //Holds m.field_at(x,y).findField(fd_some_field) type returns.
     // Just to avoid typing that long string for a temp value.
     field_entry *tmpfld = NULL;
@@ -450,6 +446,10 @@ bool map::process_fields_in_submap( submap *const current_submap,
     //Loop through all tiles in this submap indicated by current_submap
     for (int locx = 0; locx < SEEX; locx++) {
         for (int locy = 0; locy < SEEY; locy++) {
+            // Skip the (usually many) tiles without fields.
+            if( !current_submap->field_tiles[locx * SEEY + locy] ) {
+                continue;
+            }
             // This is a translation from local coordinates to submap coords.
             // All submaps are in one long 1d array.
             int x = locx + submap_x * SEEX;
@@ -462,6 +462,9 @@ bool map::process_fields_in_submap( submap *const current_submap,
                 field_entry * cur = &it->second;
 
                 curtype = cur->getFieldType();
+                // Only changes of fields that block sight affect the transparency cache.
+                const bool opaque = fieldlist[curtype].is_opaque();
+                const int old_density = cur->getFieldDensity();
                 // Setting our return value. fd_null really doesn't exist anymore,
                 // its there for legacy support.
                 if (!found_field && curtype != fd_null) {
@@ -494,7 +497,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
                     case fd_gibs_veggy:
                     case fd_gibs_insect:
                     case fd_gibs_invertebrate:
-                        if (has_flag("SWIMMABLE", x, y)) { // Dissipate faster in water
+                        if (has_flag_ter_or_furn(TFLAG_SWIMMABLE, x, y)) { // Dissipate faster in water
                             cur->setFieldAge(cur->getFieldAge() + 250);
                         }
                         break;
@@ -502,10 +505,10 @@ bool map::process_fields_in_submap( submap *const current_submap,
                     case fd_acid:
                     {
                         std::vector<item> contents;
-                        if (has_flag("SWIMMABLE", x, y)) { // Dissipate faster in water
+                        if (has_flag_ter_or_furn(TFLAG_SWIMMABLE, x, y)) { // Dissipate faster in water
                             cur->setFieldAge(cur->getFieldAge() + 20);
                         }
-                        if( has_flag( "SEALED", x, y ) ) {
+                        if( has_flag_ter_or_furn( TFLAG_SEALED, x, y ) ) {
                             break;
                         }
                         auto items = i_at(x, y);
@@ -551,7 +554,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
 
                         // TODO-MATERIALS: use fire resistance
                     case fd_fire: {
-                        const bool is_sealed = has_flag( "SEALED", x, y );
+                        const bool is_sealed = has_flag_ter_or_furn( TFLAG_SEALED, x, y );
                         auto items_here = i_at(x, y);
                         // explosions will destroy items on this square, iterating
                         // backwards makes sure that every item is visited.
@@ -778,9 +781,9 @@ bool map::process_fields_in_submap( submap *const current_submap,
                         // If the flames are in a brazier, they're fully contained,
                         // so skip consuming terrain
                         if((tr_brazier != tr_at(x, y).loadid) &&
-                           (has_flag("FIRE_CONTAINER", x, y) != true )) {
+                           (has_flag_ter_or_furn(TFLAG_FIRE_CONTAINER, x, y) != true )) {
                             // Consume the terrain we're on
-                            if (has_flag("FLAMMABLE", x, y) && one_in(32 - cur->getFieldDensity() * 10)) {
+                            if (has_flag_ter_or_furn(TFLAG_FLAMMABLE, x, y) && one_in(32 - cur->getFieldDensity() * 10)) {
                                 //The fire feeds on the ground itself until max density.
                                 cur->setFieldAge(cur->getFieldAge() - cur->getFieldDensity() *
                                                  cur->getFieldDensity() * 40);
@@ -789,7 +792,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
                                     destroy(x, y, true);
                                 }
 
-                            } else if (has_flag("FLAMMABLE_ASH", x, y) &&
+                            } else if (has_flag_ter_or_furn(TFLAG_FLAMMABLE_ASH, x, y) &&
                                        one_in(32 - cur->getFieldDensity() * 10)) {
                                 //The fire feeds on the ground itself until max density.
                                 cur->setFieldAge(cur->getFieldAge() - cur->getFieldDensity() *
@@ -800,7 +803,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
                                     furn_set(x, y, f_ash);
                                 }
 
-                            } else if (has_flag("FLAMMABLE_HARD", x, y) &&
+                            } else if (has_flag_ter_or_furn(TFLAG_FLAMMABLE_HARD, x, y) &&
                                        one_in(62 - cur->getFieldDensity() * 10)) {
                                 //The fire feeds on the ground itself until max density.
                                 cur->setFieldAge(cur->getFieldAge() - cur->getFieldDensity() *
@@ -810,7 +813,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
                                     destroy(x, y, true);
                                 }
 
-                            } else if (terlist[ter(x, y)].has_flag("SWIMMABLE")) {
+                            } else if (has_flag_ter(TFLAG_SWIMMABLE, x, y)) {
                                 cur->setFieldAge(cur->getFieldAge() + 800);
                                 // Flames die quickly on water
                             }
@@ -821,7 +824,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
 
                         // If the flames are REALLY big, they contribute to adjacent flames
                         if (cur->getFieldAge() < 0 && tr_brazier != tr_at(x, y).loadid &&
-                            (has_flag("FIRE_CONTAINER", x, y) != true  ) ) {
+                            (has_flag_ter_or_furn(TFLAG_FIRE_CONTAINER, x, y) != true  ) ) {
                             if(cur->getFieldDensity() == 3) {
                                 // Randomly offset our x/y shifts by 0-2, to randomly pick
                                 // a square to spread to
@@ -912,11 +915,11 @@ bool map::process_fields_in_submap( submap *const current_submap,
                                     }
                                     if ((i != 0 || j != 0) && rng(1, 100) < spread_chance &&
                                           cur->getFieldAge() < 200 && tr_brazier != tr_at(x, y).loadid &&
-                                          (has_flag("FIRE_CONTAINER", x, y) != true ) &&
+                                          (has_flag_ter_or_furn(TFLAG_FIRE_CONTAINER, x, y) != true ) &&
                                           (in_pit == (ter(fx, fy) == t_pit)) &&
-                                          ((cur->getFieldDensity() >= 2 && (has_flag("FLAMMABLE", fx, fy) && one_in(20))) ||
-                                          (cur->getFieldDensity() >= 2  && (has_flag("FLAMMABLE_ASH", fx, fy) && one_in(10))) ||
-                                          (cur->getFieldDensity() == 3  && (has_flag("FLAMMABLE_HARD", fx, fy) && one_in(10))) ||
+                                          ((cur->getFieldDensity() >= 2 && (has_flag_ter_or_furn(TFLAG_FLAMMABLE, fx, fy) && one_in(20))) ||
+                                          (cur->getFieldDensity() >= 2  && (has_flag_ter_or_furn(TFLAG_FLAMMABLE_ASH, fx, fy) && one_in(10))) ||
+                                          (cur->getFieldDensity() == 3  && (has_flag_ter_or_furn(TFLAG_FLAMMABLE_HARD, fx, fy) && one_in(10))) ||
                                           flammable_items_at(fx, fy) || nearwebfld )) {
                                         add_field(fx, fy, fd_fire, 1); //Nearby open flammable ground? Set it on fire.
                                         tmpfld = nearby_field.findField(fd_fire);
@@ -955,7 +958,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
                                         if (move_cost(fx, fy) > 0 &&
                                             (rng(0, 100) <= smoke || (nosmoke && one_in(40))) &&
                                             rng(3, 35) < cur->getFieldDensity() * 5 && cur->getFieldAge() < 1000 &&
-                                            (has_flag("SUPPRESS_SMOKE", x, y) != true )) {
+                                            (has_flag_ter_or_furn(TFLAG_SUPPRESS_SMOKE, x, y) != true )) {
                                             smoke--;
                                             add_field(fx, fy, fd_smoke, rng(1, cur->getFieldDensity())); //Add smoke!
                                         }
@@ -1077,6 +1080,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
                                 tmpfld = wandering_field.findField(fd_toxic_gas);
                                 if (tmpfld && tmpfld->getFieldDensity() < 3) {
                                     tmpfld->setFieldDensity(tmpfld->getFieldDensity() + 1);
+                                    set_transparency_cache_dirty();
                                 } else {
                                     add_field(i, j, fd_toxic_gas, 3);
                                 }
@@ -1346,9 +1350,9 @@ bool map::process_fields_in_submap( submap *const current_submap,
                         { //Needed for variable scope
                             int offset_x = x + rng(-1,1);
                             int offset_y = y + rng(-1,1); //pick a random adjacent tile and attempt to set that on fire
-                            if( has_flag("FLAMMABLE", offset_x, offset_y) ||
-                                has_flag("FLAMMABLE_ASH",offset_x, offset_y) ||
-                                has_flag("FLAMMABLE_HARD", offset_x, offset_y) ) {
+                            if( has_flag_ter_or_furn(TFLAG_FLAMMABLE, offset_x, offset_y) ||
+                                has_flag_ter_or_furn(TFLAG_FLAMMABLE_ASH, offset_x, offset_y) ||
+                                has_flag_ter_or_furn(TFLAG_FLAMMABLE_HARD, offset_x, offset_y) ) {
                                 add_field(offset_x, offset_y , fd_fire, 1);
                             }
 
@@ -1397,14 +1401,21 @@ bool map::process_fields_in_submap( submap *const current_submap,
                     }
                     if (should_dissipate == true || !cur->isAlive()) { // Totally dissapated.
                         current_submap->field_count--;
+                        if( opaque ) {
+                            set_transparency_cache_dirty();
+                        }
                         it = current_submap->fld[locx][locy].removeField(cur->getFieldType());
                         continue;
                     }
                 }
+                if( opaque && cur->getFieldDensity() != old_density ) {
+                    set_transparency_cache_dirty();
+                }
                 if (!skipIterIncr)
                     ++it;
                 skipIterIncr = false;
             }
+            current_submap->update_field_tile( locx, locy );
         }
     }
     return found_field;
@@ -26,6 +26,12 @@ struct field_t {
  */
  bool transparent[3];
 
+ // Whether a field of this type blocks line of sight at any density.
+ bool is_opaque() const
+ {
+     return !transparent[0] || !transparent[1] || !transparent[2];
+ }
+
  //Dangerous tiles ask you before you step in them.
  bool dangerous[3];
 
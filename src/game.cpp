@@ -52,6 +52,7 @@
 #include "npc.h"
 #include "scenario.h"
 #include "mission.h"
+#include "mapgen.h"
 
 #include <map>
 #include <set>
@@ -65,6 +66,7 @@
 #include <cassert>
 #include <iterator>
 #include <ctime>
+#include <chrono>
 
 #if (defined _WIN32 || defined __WIN32__)
 #   include "platform_win.h"
@@ -73,6 +75,24 @@
 
 #define dbg(x) DebugLog((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
 
+// Turns per batch while fast-forwarding, see game::update_fast_forward.
+static const int FAST_FORWARD_TURNS = 10;
+
+// Options that are read every turn or every redraw.
+static const option_handle<bool> opt_autosave( "AUTOSAVE" );
+static const option_handle<int> opt_autosave_turns( "AUTOSAVE_TURNS" );
+static const option_handle<int> opt_map_memory_budget( "MAP_MEMORY_BUDGET" );
+static const option_handle<bool> opt_driving_view_offset( "DRIVING_VIEW_OFFSET" );
+static const option_handle<bool> opt_animations( "ANIMATIONS" );
+static const option_handle<bool> opt_animation_rain( "ANIMATION_RAIN" );
+static const option_handle<bool> opt_animation_sct( "ANIMATION_SCT" );
+static const option_handle<bool> opt_vehicle_dir_indicator( "VEHICLE_DIR_INDICATOR" );
+static const option_handle<int> opt_safemode_proximity( "SAFEMODEPROXIMITY" );
+static const option_handle<int> opt_autosafemode_turns( "AUTOSAFEMODETURNS" );
+static const option_handle<bool> opt_auto_pickup( "AUTO_PICKUP" );
+static const option_handle<bool> opt_auto_pickup_safemode( "AUTO_PICKUP_SAFEMODE" );
+static const option_handle<bool> opt_auto_pickup_adjacent( "AUTO_PICKUP_ADJACENT" );
+
 void advanced_inv(); // player_activity.cpp
 void intro();
 nc_color sev(int a); // Right now, ONLY used for scent debugging....
@@ -92,6 +112,7 @@ bool is_valid_in_w_terrain(int x, int y)
 // This is the main game set-up process.
 game::game() :
     new_game(false),
+    headless(false),
     uquit(QUIT_NO),
     w_terrain(NULL),
     w_overmap(NULL),
@@ -106,10 +127,13 @@ game::game() :
     dangerous_proximity(5),
     safe_mode(SAFE_MODE_ON),
     mostseen(0),
+    fast_forward(false),
     gamemode(NULL),
     lookHeight(13),
     tileset_zoom(16)
 {
+    npc_grid_generation = 0;
+    processing_explosions = false;
     world_generator = new worldfactory();
     // do nothing, everything that was in here is moved to init_data() which is called immediately after g = new game; in main.cpp
     // The reason for this move is so that g is not uninitialized when it gets to installing the parts into vehicles.
@@ -128,6 +152,8 @@ void game::load_static_data()
     // Only need to load names once, they do not depend on mods
     init_names();
     narrow_sidebar = OPTIONS["SIDEBAR_STYLE"] == "narrow";
+    // Item names depend on the language and on ITEM_HEALTH_BAR.
+    add_options_listener( item::clear_name_cache );
     fullscreen = false;
     was_fullscreen = false;
 
@@ -191,6 +217,98 @@ void game::check_all_mod_data()
     }
 }
 
+bool game::pregen_world( const std::string &worldname, const int radius )
+{
+    // Nothing may wait for a key press, errors from mapgen are printed instead.
+    debugmsg_collector collector;
+    bool had_errors = false;
+    const auto print_errors = [&collector, &had_errors]() {
+        for( auto &message : collector.messages ) {
+            fprintf( stderr, "%s\n", message.c_str() );
+        }
+        had_errors = had_errors || !collector.messages.empty();
+        collector.messages.clear();
+    };
+
+    world_generator->get_all_worlds();
+    print_errors();
+    if( world_generator->all_worlds.count( worldname ) == 0 ) {
+        fprintf( stderr, "pregen_world: there is no world named \"%s\"\n", worldname.c_str() );
+        return false;
+    }
+    WORLDPTR world = world_generator->all_worlds[worldname];
+    world_generator->set_active_world( world );
+    setup();
+    MAPBUFFER.load( world->world_name );
+    // Some mapgen depends on the scenario, there is no character yet.
+    scen = scenario::generic();
+    // Mapgen places static NPCs, which need their factions and the next free ids.
+    if( !load_master( worldname ) ) {
+        create_factions();
+    }
+
+    // New characters start in the (0,0) overmap, see start_location::setup.
+    const point center( OMAPX / 2, OMAPY / 2 );
+    // Parts of mapgen (e.g. vehicle damage) still refer to g->m, so it has to be valid.
+    const tripoint center_sm = overmapbuffer::omt_to_sm_copy( tripoint( center.x, center.y, 0 ) );
+    m.load( center_sm.x - MAPSIZE / 2, center_sm.y - MAPSIZE / 2, 0, false );
+    const int num_tiles = ( 2 * radius + 1 ) * ( 2 * radius + 1 );
+    // Tiles are generated and saved in batches of rows, so only one batch is in memory.
+    const int batch_size = 256;
+
+    const auto start = std::chrono::steady_clock::now();
+    int num_done = 0;
+    size_t num_generated = 0;
+    std::vector<tripoint> batch;
+    for( int y = center.y - radius; y <= center.y + radius; y++ ) {
+        for( int x = center.x - radius; x <= center.x + radius; x++ ) {
+            batch.push_back( overmapbuffer::omt_to_sm_copy( tripoint( x, y, 0 ) ) );
+        }
+        if( (int)batch.size() < batch_size && y < center.y + radius ) {
+            continue;
+        }
+        num_generated += generate_overmap_tiles( batch, calendar::turn );
+        num_done += batch.size();
+        batch.clear();
+        try {
+            // Keeps the submaps of g->m, but unloads everything else.
+            MAPBUFFER.save();
+        } catch( std::ios::failure & ) {
+            print_errors();
+            fprintf( stderr, "pregen_world: failed to save the maps\n" );
+            return false;
+        }
+        print_errors();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        const double rate = num_generated / std::max( elapsed.count(), 0.001 );
+        printf( _( "Generating world %s: %d/%d overmap terrain tiles (%.1f tiles/s)\n" ),
+                worldname.c_str(), num_done, num_tiles, rate );
+        fflush( stdout );
+        DebugLog( D_INFO, D_MAIN ) << "pregen_world: " << num_done << "/" << num_tiles
+                                   << " tiles done, " << num_generated << " generated, "
+                                   << rate << " tiles/s";
+    }
+
+    try {
+        overmap_buffer.save();
+    } catch( std::ios::failure & ) {
+        print_errors();
+        fprintf( stderr, "pregen_world: failed to save the overmaps\n" );
+        return false;
+    }
+    if( !save_factions_missions_npcs() ) {
+        print_errors();
+        fprintf( stderr, "pregen_world: failed to save the factions and missions\n" );
+        return false;
+    }
+    print_errors();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    DebugLog( D_INFO, D_MAIN ) << "pregen_world: generated " << num_generated << " of "
+                               << num_tiles << " tiles in " << elapsed.count() << " seconds";
+    return !had_errors;
+}
+
 void game::load_core_data()
 {
     // core data can be loaded only once and must be first
@@ -555,6 +673,7 @@ void game::setup()
     clear_zombies();
     coming_to_stairs.clear();
     active_npc.clear();
+    player::npc_position_generation++;
     factions.clear();
     mission::clear_all();
     items_dragged.clear();
@@ -704,6 +823,7 @@ void game::load_npcs()
             temp->die( nullptr );
         } else {
             active_npc.push_back(temp);
+            player::npc_position_generation++;
         }
     }
 }
@@ -1003,7 +1123,7 @@ static int veh_lumi(vehicle *veh)
 
 void game::calc_driving_offset(vehicle *veh)
 {
-    if (veh == nullptr || !OPTIONS["DRIVING_VIEW_OFFSET"]) {
+    if (veh == nullptr || !opt_driving_view_offset) {
         set_driving_view_offset(point(0, 0));
         return;
     }
@@ -1117,6 +1237,7 @@ bool game::do_turn()
         gamemode->per_turn();
         calendar::turn.increment();
     }
+    update_fast_forward();
     process_events();
     mission::process_all();
     if (calendar::turn.hours() == 0 && calendar::turn.minutes() == 0 &&
@@ -1402,12 +1523,19 @@ bool game::do_turn()
     }
 
     // Auto-save if autosave is enabled
-    if (OPTIONS["AUTOSAVE"] &&
-        calendar::turn % ((int)OPTIONS["AUTOSAVE_TURNS"]) == 0 &&
+    if (opt_autosave &&
+        calendar::turn % opt_autosave_turns.get() == 0 &&
         !u.is_dead_state()) {
         autosave();
     }
 
+    if( opt_map_memory_budget > 0 && calendar::turn % 100 == 0 ) {
+        // Overmaps get at most half of the budget, submaps whatever they leave.
+        const size_t budget = size_t( opt_map_memory_budget.get() ) * 1024 * 1024;
+        const size_t overmap_bytes = overmap_buffer.enforce_budget( budget / 2 );
+        MAPBUFFER.enforce_budget( budget > overmap_bytes ? budget - overmap_bytes : 0 );
+    }
+
     update_weather();
 
     // The following happens when we stay still; 10/40 minutes overdue for spawn
@@ -1472,31 +1600,35 @@ bool game::do_turn()
 
     m.vehmove();
 
-    // Process power and fuel consumption for all vehicles, including off-map ones.
+    // Process power and fuel consumption for the vehicles in the reality bubble.
     // m.vehmove used to do this, but now it only give them moves instead.
-    for( auto &elem : MAPBUFFER ) {
-        tripoint sm_loc = elem.first;
-        point sm_topleft = overmapbuffer::sm_to_ms_copy(sm_loc.x, sm_loc.y);
-        point in_reality = m.getlocal(sm_topleft);
-
-        submap *sm = elem.second;
-
-        for( auto &_i : sm->vehicles ) {
-            auto veh = _i;
-
-            veh->power_parts( sm_loc );
-            veh->idle( sm_loc.z == get_levz() && m.inbounds(in_reality.x, in_reality.y) );
-        }
-    }
+    // Vehicles elsewhere are caught up with the turns they missed when they return.
+    const tripoint abs_sub = m.get_abs_sub();
+    for( auto &wrapped_veh : m.get_vehicles() ) {
+        vehicle *veh = wrapped_veh.v;
+        const tripoint sm_loc( abs_sub.x + wrapped_veh.i, abs_sub.y + wrapped_veh.j, get_levz() );
+        veh->catch_up( sm_loc );
+        veh->power_parts( sm_loc );
+        veh->idle( true );
+        veh->last_update_turn = calendar::turn;
+        // The vehicle might leave the reality bubble before the next save.
+        submap *const sm = MAPBUFFER.find_submap( sm_loc );
+        if( sm != nullptr ) {
+            sm->dirty = true;
+        }
+    }
+    // Fields and scent tick every turn even when fast-forwarding, their rules are random or
+    // not linear. Some active items only depend on the time passed, they go in batches.
     m.process_fields();
-    m.process_active_items();
+    m.process_active_items( fast_forward ? FAST_FORWARD_TURNS : 1 );
     m.creature_in_field( u );
 
     // Apply sounds from previous turn to monster and NPC AI.
     sounds::process_sounds();
     // Update vision caches for monsters. If this turns out to be expensive,
     // consider a stripped down cache just for monsters.
-    m.build_map_cache();
+    // Vision must stay current (see hostile_in_view), only the light changes slowly enough.
+    m.build_map_cache( !fast_forward || calendar::turn % FAST_FORWARD_TURNS == 0 );
     monmove();
     update_stair_monsters();
     u.process_turn();
@@ -1588,13 +1720,55 @@ void game::process_events()
     }
 }
 
+void game::update_fast_forward()
+{
+    const activity_type act = u.activity.type;
+    if( !u.in_sleep_state() && act != ACT_WAIT && act != ACT_WAIT_WEATHER && act != ACT_CRAFT &&
+        act != ACT_LONGCRAFT && act != ACT_READ && act != ACT_TRAIN ) {
+        fast_forward = false;
+        return;
+    }
+    // Batches start at a full batch of turns, but a hostile ends them on any turn.
+    if( !fast_forward && calendar::turn % FAST_FORWARD_TURNS != 0 ) {
+        return;
+    }
+    // A sleeping player does not notice monsters, only noise and damage wake them up.
+    if( u.in_sleep_state() || !hostile_in_view() ) {
+        fast_forward = true;
+        return;
+    }
+    if( fast_forward ) {
+        // Let mon_info ask whether to stop right now instead of at the next regular redraw.
+        fast_forward = false;
+        m.build_map_cache();
+        draw();
+    }
+}
+
+bool game::hostile_in_view()
+{
+    for( size_t i = 0; i < num_zombies(); i++ ) {
+        monster &critter = zombie( i );
+        if( !critter.is_dead() && !critter.type->has_flag( MF_VERMIN ) &&
+            critter.attitude( &u ) == MATT_ATTACK && u.sees( critter ) ) {
+            return true;
+        }
+    }
+    for( auto &p : active_npc ) {
+        if( p->attitude == NPCATT_KILL && u.sees( *p ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void game::process_activity()
 {
     if( u.activity.type == ACT_NULL ) {
         return;
     }
 
-    if( int(calendar::turn) % 50 == 0 ) {
+    if( int(calendar::turn) % ( fast_forward ? 300 : 50 ) == 0 ) {
         draw();
     }
 
@@ -1676,6 +1850,7 @@ bool game::cancel_activity_query(const char *message, ...)
 
 void game::update_weather()
 {
+    rng_stream_scope rng_scope( RNG_WEATHER );
     if (calendar::turn >= nextweather) {
         if(!has_generator) {
             weather_generator weatherGen(weatherSeed);
@@ -2153,7 +2328,7 @@ input_context game::get_player_input(std::string &action)
         ctxt.register_action("QUIT");
     }
 
-    if (OPTIONS["ANIMATIONS"]) {
+    if (opt_animations) {
         int iStartX = (TERRAIN_WINDOW_WIDTH > 121) ? (TERRAIN_WINDOW_WIDTH - 121) / 2 : 0;
         int iStartY = (TERRAIN_WINDOW_HEIGHT > 121) ? (TERRAIN_WINDOW_HEIGHT - 121) / 2 : 0;
         int iEndX = (TERRAIN_WINDOW_WIDTH > 121) ? TERRAIN_WINDOW_WIDTH - (TERRAIN_WINDOW_WIDTH - 121) / 2 :
@@ -2190,7 +2365,7 @@ input_context game::get_player_input(std::string &action)
         inp_mngr.set_timeout(125);
         // Force at least one animation frame if the player is dead.
         while( handle_mouseview(ctxt, action) || uquit == QUIT_WATCH ) {
-            if (bWeatherEffect && OPTIONS["ANIMATION_RAIN"]) {
+            if (bWeatherEffect && opt_animation_rain) {
                 /*
                 Location to add rain drop animation bits! Since it refreshes w_terrain it can be added to the animation section easily
                 Get tile information from above's weather information:
@@ -2226,7 +2401,7 @@ input_context game::get_player_input(std::string &action)
                 }
             }
             // don't bother calculating SCT if we won't show it
-            if (uquit != QUIT_WATCH && OPTIONS["ANIMATION_SCT"]) {
+            if (uquit != QUIT_WATCH && opt_animation_sct) {
 #ifdef TILES
                 if (!use_tiles) {
 #endif
@@ -3575,7 +3750,9 @@ void game::load(std::string worldname, std::string name)
 
 void game::load_world_modfiles(WORLDPTR world)
 {
-    popup_nowait(_("Please wait while the world data loads"));
+    if( !headless ) {
+        popup_nowait(_("Please wait while the world data loads"));
+    }
     load_core_data();
     if (world != NULL) {
         load_artifacts(world->world_path + "/artifacts.gsav");
@@ -3619,7 +3796,9 @@ bool game::save_factions_missions_npcs()
         fclose_exclusive(fout, masterfile.c_str());
         return true;
     } catch (std::ios::failure &) {
-        popup(_("Failed to save factions to %s"), masterfile.c_str());
+        if( !headless ) {
+            popup(_("Failed to save factions to %s"), masterfile.c_str());
+        }
         return false;
     }
 }
@@ -3934,6 +4113,7 @@ void game::debug()
         if (tmp != overmap::invalid_tripoint) {
             //First offload the active npcs.
             active_npc.clear();
+            player::npc_position_generation++;
             while( num_zombies() > 0 ) {
                 despawn_monster( 0 );
             }
@@ -3996,7 +4176,7 @@ void game::debug()
         popup_top(
             s.c_str(),
             u.posx(), u.posy(), get_levx(), get_levy(),
-            otermap[overmap_buffer.ter(u.global_omt_location())].name.c_str(),
+            otermap[overmap_buffer.get_ter(u.global_omt_location())].name.c_str(),
             int(calendar::turn), int(nextspawn),
             (ACTIVE_WORLD_OPTIONS["RANDOM_NPC"] == "true" ? _("NPCs are going to spawn.") :
              _("NPCs are NOT going to spawn.")),
@@ -4100,7 +4280,7 @@ void game::debug()
             if (p->has_destination()) {
                 data << string_format(_("Destination: %d:%d (%s)"),
                         p->goal.x, p->goal.y,
-                        otermap[overmap_buffer.ter(p->goal)].name.c_str()) << std::endl;
+                        otermap[overmap_buffer.get_ter(p->goal)].name.c_str()) << std::endl;
             } else {
                 data << _("No destination.") << std::endl;
             }
@@ -4729,7 +4909,7 @@ void game::draw_sidebar()
         wprintz(time_window, c_white, "]");
     }
 
-    const oter_id &cur_ter = overmap_buffer.ter(u.global_omt_location());
+    const oter_id &cur_ter = overmap_buffer.get_ter(u.global_omt_location());
 
     std::string tername = otermap[cur_ter].name;
     werase(w_location);
@@ -4752,7 +4932,7 @@ void game::draw_sidebar()
     mvwprintz(day_window, 0, sideStyle ? 0 : 41, c_white, _("%s, day %d"),
               season_name_upper(calendar::turn.get_season()).c_str(), calendar::turn.days() + 1);
     if (safe_mode != SAFE_MODE_OFF || autosafemode != 0) {
-        int iPercent = int((turnssincelastmon * 100) / OPTIONS["AUTOSAFEMODETURNS"]);
+        int iPercent = int((turnssincelastmon * 100) / opt_autosafemode_turns.get());
         wmove(w_status, sideStyle ? 4 : 1, getmaxx(w_status) - 4);
         const char *letters[] = { "S", "A", "F", "E" };
         for (int i = 0; i < 4; i++) {
@@ -4885,7 +5065,7 @@ void game::draw_ter(int posx, int posy, bool looking)
 void game::draw_veh_dir_indicator(void)
 {
     // don't draw indicator if doing look_around()
-    if (OPTIONS["VEHICLE_DIR_INDICATOR"]) {
+    if (opt_vehicle_dir_indicator) {
         vehicle *veh = m.veh_at(u.posx(), u.posy());
         if (!veh) {
             debugmsg("game::draw_veh_dir_indicator: no vehicle!");
@@ -5153,7 +5333,7 @@ void game::draw_minimap()
                 ter_color = c_cyan;
                 ter_sym = 'c';
             } else {
-                const oter_id &cur_ter = overmap_buffer.ter(omx, omy, get_levz());
+                const oter_id &cur_ter = overmap_buffer.get_ter(omx, omy, get_levz());
                 ter_sym = otermap[cur_ter].sym;
                 if (overmap_buffer.is_explored(omx, omy, get_levz())) {
                     ter_color = c_dkgray;
@@ -5243,6 +5423,17 @@ float game::ground_natural_light_level() const
     return std::max(0.0f, ret);
 }
 
+float game::ground_natural_light_level( const calendar &when, const point &location ) const
+{
+    weather_type w = weatherGen.get_weather_conditions( location, when );
+    // Same as in update_weather.
+    if( w == WEATHER_SUNNY && when.is_night() ) {
+        w = WEATHER_CLEAR;
+    }
+    const float ret = (float)when.sunlight() + weather_data( w ).light_modifier;
+    return std::max( 0.0f, ret );
+}
+
 float game::natural_light_level() const
 {
     float ret = 0;
@@ -5327,7 +5518,7 @@ faction *game::faction_by_ident(std::string id)
 
 Creature *game::is_hostile_nearby()
 {
-    int distance = (OPTIONS["SAFEMODEPROXIMITY"] <= 0) ? 60 : OPTIONS["SAFEMODEPROXIMITY"];
+    int distance = (opt_safemode_proximity <= 0) ? 60 : opt_safemode_proximity;
     return is_hostile_within(distance);
 }
 
@@ -5376,7 +5567,7 @@ int game::mon_info(WINDOW *w)
 
     std::string sbuff;
     int newseen = 0;
-    const int iProxyDist = (OPTIONS["SAFEMODEPROXIMITY"] <= 0) ? 60 : OPTIONS["SAFEMODEPROXIMITY"];
+    const int iProxyDist = (opt_safemode_proximity <= 0) ? 60 : opt_safemode_proximity;
     // 7 0 1    unique_types uses these indices;
     // 6 8 2    0-7 are provide by direction_from()
     // 5 4 3    8 is used for local monsters (for when we explain them below)
@@ -5487,7 +5678,7 @@ int game::mon_info(WINDOW *w)
         }
     } else if (autosafemode && newseen == 0) { // Auto-safemode
         turnssincelastmon++;
-        if (turnssincelastmon >= OPTIONS["AUTOSAFEMODETURNS"] && safe_mode == SAFE_MODE_OFF) {
+        if (turnssincelastmon >= opt_autosafemode_turns && safe_mode == SAFE_MODE_OFF) {
             safe_mode = SAFE_MODE_ON;
         }
     }
@@ -5646,6 +5837,7 @@ void game::cleanup_dead()
             n->die( nullptr ); // make sure this has been called to create corpses etc.
             const int npc_id = n->getID();
             it = active_npc.erase( it );
+            player::npc_position_generation++;
             overmap_buffer.remove_npc( npc_id );
         } else {
             it++;
@@ -5655,6 +5847,8 @@ void game::cleanup_dead()
 
 void game::monmove()
 {
+    static const efftype_index effect_controlled = get_efftype_index( "controlled" );
+    rng_stream_scope rng_scope( RNG_MONSTER );
     cleanup_dead();
 
     // Make sure these don't match the first time around.
@@ -5717,7 +5911,7 @@ void game::monmove()
         while (critter.moves > 0 && !critter.is_dead()) {
             critter.made_footstep = false;
             // Controlled critters don't make their own plans
-            if (!critter.has_effect("controlled")) {
+            if (!critter.has_effect(effect_controlled)) {
                 // Formulate a path to follow
                 critter.plan( monster_factions );
             }
@@ -5784,55 +5978,104 @@ void game::monmove()
 
 void game::do_blast(const int x, const int y, const int power, const int radius, const bool fire)
 {
-    int dam;
-    for (int i = x - radius; i <= x + radius; i++) {
-        for (int j = y - radius; j <= y + radius; j++) {
-            if (i == x && j == y) {
-                dam = 3 * power;
-            } else {
-                dam = 3 * power / (rl_dist(x, y, i, j));
+    // The pressure spreads from the center like a flood fill. It only passes
+    // tiles that are open (or permeable, or were just blown open), so walls
+    // that survive the blast shield whatever is behind them.
+    const int width = 2 * radius + 1;
+    std::vector<bool> reached( width * width, false );
+    std::vector<point> blasted;
+    blasted.push_back( point( x, y ) );
+    reached[radius * width + radius] = true;
+    // Terrain is bashed first, in the order the wave reaches it. The caches are
+    // invalidated once instead of being updated for every broken tile.
+    m.set_pathing_cache_dirty();
+    for( size_t n = 0; n < blasted.size(); n++ ) {
+        const int i = blasted[n].x;
+        const int j = blasted[n].y;
+        const int dam = ( i == x && j == y ) ? 3 * power : 3 * power / rl_dist( x, y, i, j );
+        m.bash(i, j, dam);
+        m.bash(i, j, dam); // Double up for tough doors, etc.
+        if( n > 0 && m.move_cost( i, j ) == 0 && !m.has_flag( TFLAG_PERMEABLE, i, j ) ) {
+            continue;
+        }
+        for( int ni = i - 1; ni <= i + 1; ni++ ) {
+            for( int nj = j - 1; nj <= j + 1; nj++ ) {
+                if( abs( ni - x ) > radius || abs( nj - y ) > radius || !m.inbounds( ni, nj ) ) {
+                    continue;
+                }
+                const int index = ( ni - x + radius ) * width + ( nj - y + radius );
+                if( !reached[index] ) {
+                    reached[index] = true;
+                    blasted.push_back( point( ni, nj ) );
+                }
             }
-            m.bash(i, j, dam);
-            m.bash(i, j, dam); // Double up for tough doors, etc.
+        }
+    }
 
-            int mon_hit = mon_at(i, j), npc_hit = npc_at(i, j);
-            if (mon_hit != -1) {
-                monster &critter = critter_tracker.find(mon_hit);
-                critter.apply_damage( nullptr, bp_torso, rng( dam / 2, long( dam * 1.5 ) ) ); // TODO: player's fault?
-                critter.check_dead_state();
-            }
+    // Then everything on the reached tiles gets hurt.
+    for( auto &p : blasted ) {
+        const int i = p.x;
+        const int j = p.y;
+        const int dam = ( i == x && j == y ) ? 3 * power : 3 * power / rl_dist( x, y, i, j );
+        int mon_hit = mon_at(i, j), npc_hit = npc_at(i, j);
+        if (mon_hit != -1) {
+            monster &critter = critter_tracker.find(mon_hit);
+            critter.apply_damage( nullptr, bp_torso, rng( dam / 2, long( dam * 1.5 ) ) ); // TODO: player's fault?
+            critter.check_dead_state();
+        }
 
-            int vpart;
-            vehicle *veh = m.veh_at(i, j, vpart);
-            if (veh) {
-                veh->damage(vpart, dam, fire ? 2 : 1, false);
-            }
+        int vpart;
+        vehicle *veh = m.veh_at(i, j, vpart);
+        if (veh) {
+            veh->damage(vpart, dam, fire ? 2 : 1, false);
+        }
 
-            player *n = nullptr;
-            if (npc_hit != -1) {
-                n = active_npc[npc_hit];
-            } else if( u.posx() == i && u.posy() == j ) {
-                add_msg(m_bad, _("You're caught in the explosion!"));
-                n = &u;
-            }
-            if( n != nullptr ) {
-                n->deal_damage( nullptr, bp_torso, damage_instance( DT_BASH, rng( dam / 2, long( dam * 1.5 ) ) ) );
-                n->deal_damage( nullptr, bp_head, damage_instance( DT_BASH, rng( dam / 3, dam ) ) );
-                n->deal_damage( nullptr, bp_leg_l, damage_instance( DT_BASH, rng( dam / 3, dam ) ) );
-                n->deal_damage( nullptr, bp_leg_r, damage_instance( DT_BASH, rng( dam / 3, dam ) ) );
-                n->deal_damage( nullptr, bp_arm_l, damage_instance( DT_BASH, rng( dam / 3, dam ) ) );
-                n->deal_damage( nullptr, bp_arm_r, damage_instance( DT_BASH, rng( dam / 3, dam ) ) );
-                n->check_dead_state();
-            }
-            if (fire) {
-                m.add_field(i, j, fd_fire, dam / 10);
-            }
+        player *n = nullptr;
+        if (npc_hit != -1) {
+            n = active_npc[npc_hit];
+        } else if( u.posx() == i && u.posy() == j ) {
+            add_msg(m_bad, _("You're caught in the explosion!"));
+            n = &u;
+        }
+        if( n != nullptr ) {
+            n->deal_damage( nullptr, bp_torso, damage_instance( DT_BASH, rng( dam / 2, long( dam * 1.5 ) ) ) );
+            n->deal_damage( nullptr, bp_head, damage_instance( DT_BASH, rng( dam / 3, dam ) ) );
+            n->deal_damage( nullptr, bp_leg_l, damage_instance( DT_BASH, rng( dam / 3, dam ) ) );
+            n->deal_damage( nullptr, bp_leg_r, damage_instance( DT_BASH, rng( dam / 3, dam ) ) );
+            n->deal_damage( nullptr, bp_arm_l, damage_instance( DT_BASH, rng( dam / 3, dam ) ) );
+            n->deal_damage( nullptr, bp_arm_r, damage_instance( DT_BASH, rng( dam / 3, dam ) ) );
+            n->check_dead_state();
+        }
+        if (fire) {
+            m.add_field(i, j, fd_fire, dam / 10);
         }
     }
 }
 
 void game::explosion(int x, int y, int power, int shrapnel, bool fire, bool blast)
 {
+    pending_explosions.push_back( explosion_data{ x, y, power, shrapnel, fire, blast } );
+    if( processing_explosions ) {
+        // Chain reaction, the outermost call handles it once the current one is done.
+        return;
+    }
+    processing_explosions = true;
+    for( size_t i = 0; i < pending_explosions.size(); i++ ) {
+        // Copied, do_explosion may add to the vector.
+        const explosion_data ex = pending_explosions[i];
+        do_explosion( ex );
+    }
+    pending_explosions.clear();
+    processing_explosions = false;
+}
+
+void game::do_explosion( const explosion_data &ex )
+{
+    const int x = ex.x;
+    const int y = ex.y;
+    const int power = ex.power;
+    const int shrapnel = ex.shrapnel;
+    const bool fire = ex.fire;
     int radius = int(sqrt(double(power / 4)));
     int dam;
     int noise = power * (fire ? 2 : 10);
@@ -5844,7 +6087,7 @@ void game::explosion(int x, int y, int power, int shrapnel, bool fire, bool blas
     } else {
         sounds::sound(x, y, 3, _("a loud pop!"));
     }
-    if (blast) {
+    if (ex.blast) {
         do_blast(x, y, power, radius, fire);
         // Draw the explosion
         draw_explosion(x, y, radius, c_red);
@@ -6494,7 +6737,7 @@ void game::emp_blast(int x, int y)
         // TODO: More effects?
         //e-handcuffs effects
         if (u.weapon.type->id == "e_handcuffs" && u.weapon.charges > 0){
-            u.weapon.item_tags.erase("NO_UNWIELD");
+            u.weapon.unset_flag("NO_UNWIELD");
             u.weapon.charges = 0;
             u.weapon.active = false;
             add_msg(m_good, _("The %s on your wrists spark briefly, then release your hands!"), u.weapon.tname().c_str());
@@ -6511,6 +6754,29 @@ void game::emp_blast(int x, int y)
 
 int game::npc_at(const int x, const int y) const
 {
+    static const int width = SEEX * MAPSIZE;
+    static const int height = SEEY * MAPSIZE;
+    if( x >= 0 && x < width && y >= 0 && y < height ) {
+        if( npc_grid_generation != player::npc_position_generation ) {
+            npc_grid.assign( width * height, -1 );
+            // Walk backwards so the first NPC on a tile wins, like the scan below.
+            for( int i = (int)active_npc.size() - 1; i >= 0; i-- ) {
+                const npc *p = active_npc[i];
+                if( p->posx() >= 0 && p->posx() < width && p->posy() >= 0 && p->posy() < height ) {
+                    npc_grid[p->posx() * height + p->posy()] = i;
+                }
+            }
+            npc_grid_generation = player::npc_position_generation;
+        }
+        const int index = npc_grid[x * height + y];
+        if( index < 0 ) {
+            return -1;
+        }
+        if( !active_npc[index]->is_dead() ) {
+            return index;
+        }
+        // A dead NPC may share its tile with a living one, fall back to the scan.
+    }
     for (size_t i = 0; i < active_npc.size(); i++) {
         if (active_npc[i]->posx() == x && active_npc[i]->posy() == y && !active_npc[i]->is_dead()) {
             return (int)i;
@@ -8696,7 +8962,7 @@ bool game::list_items_match(const item *item, std::string sPattern)
 
         std::string namepat = pat;
         std::transform( namepat.begin(), namepat.end(), namepat.begin(), tolower );
-        if( lcmatch( item->tname(), namepat ) ) {
+        if( item->cached_tname_lower().find( namepat ) != std::string::npos ) {
             return !exclude;
         }
 
@@ -8749,14 +9015,14 @@ std::vector<map_item_stack> game::find_nearby_items(int iRadius)
             m.sees_some_items( points_p_it.x, points_p_it.y, u ) ) {
 
             for( auto &elem : m.i_at( points_p_it.x, points_p_it.y ) ) {
-                const std::string name = elem.tname();
+                const std::string name = elem.cached_tname();
 
                 if( temp_items.find( name ) == temp_items.end() ||
                     ( iLastX != points_p_it.x || iLastY != points_p_it.y ) ) {
                     iLastX = points_p_it.x;
                     iLastY = points_p_it.y;
 
-                    if (std::find(vOrder.begin(), vOrder.end(), name) == vOrder.end()) {
+                    if( temp_items.find( name ) == temp_items.end() ) {
                         vOrder.push_back(name);
                         temp_items[name] =
                             map_item_stack( &elem, points_p_it.x - u.posx(), points_p_it.y - u.posy() );
@@ -11916,8 +12182,8 @@ bool game::plmove(int dx, int dy)
         }
 
         //Autopickup
-        if (OPTIONS["AUTO_PICKUP"] && (!OPTIONS["AUTO_PICKUP_SAFEMODE"] || mostseen == 0) &&
-            ((m.i_at(u.posx(), u.posy())).size() || OPTIONS["AUTO_PICKUP_ADJACENT"])) {
+        if (opt_auto_pickup && (!opt_auto_pickup_safemode || mostseen == 0) &&
+            ((m.i_at(u.posx(), u.posy())).size() || opt_auto_pickup_adjacent)) {
             Pickup::pick_up(u.posx(), u.posy(), -1);
         }
 
@@ -12572,8 +12838,8 @@ void game::vertical_move(int movez, bool force)
                 // Already has a note -> never add an AUTO-note
                 continue;
             }
-            const oter_id &ter = overmap_buffer.ter(cursx, cursy, z_before);
-            const oter_id &ter2 = overmap_buffer.ter(cursx, cursy, z_after);
+            const oter_id &ter = overmap_buffer.get_ter(cursx, cursy, z_before);
+            const oter_id &ter2 = overmap_buffer.get_ter(cursx, cursy, z_after);
             if (!!OPTIONS["AUTO_NOTES"]) {
                 if( movez == +1 && otermap[ter].has_flag(known_up) &&
                     !otermap[ter2].has_flag(known_down) ) {
@@ -12631,6 +12897,7 @@ void game::vertical_move(int movez, bool force)
 
     // Clear currently active npcs and reload them
     active_npc.clear();
+    player::npc_position_generation++;
     load_npcs();
     refresh_all();
 }
@@ -12681,6 +12948,7 @@ void game::update_map(int &x, int &y)
             (*it)->posx() > SEEX * (MAPSIZE + 2) || (*it)->posy() > SEEY * (MAPSIZE + 2) ) {
             //Remove the npc from the active list. It remains in the overmap list.
             it = active_npc.erase(it);
+            player::npc_position_generation++;
         } else {
             it++;
         }
@@ -12727,7 +12995,7 @@ void game::update_overmap_seen()
             int sight_points = dist;
             for (std::vector<point>::const_iterator it = line.begin();
                  it != line.end() && sight_points >= 0; ++it) {
-                const oter_id &ter = overmap_buffer.ter(it->x, it->y, ompos.z);
+                const oter_id &ter = overmap_buffer.get_ter(it->x, it->y, ompos.z);
                 const int cost = otermap[ter].see_cost;
                 sight_points -= cost;
             }
@@ -13224,204 +13492,7 @@ void game::nuke(int x, int y)
 
 bool game::spread_fungus(int x, int y)
 {
-    int growth = 1;
-    for (int i = x - 1; i <= x + 1; i++) {
-        for (int j = y - 1; j <= y + 1; j++) {
-            if (i == x && j == y) {
-                continue;
-            }
-            if (m.has_flag("FUNGUS", i, j)) {
-                growth += 1;
-            }
-        }
-    }
-
-    bool converted = false;
-    if (!m.has_flag_ter("FUNGUS", x, y)) {
-        // Terrain conversion
-        if (m.has_flag_ter("DIGGABLE", x, y)) {
-            if (x_in_y(growth * 10, 100)) {
-                m.ter_set(x, y, t_fungus);
-                converted = true;
-            }
-        } else if (m.has_flag("FLAT", x, y)) {
-            if (m.has_flag("INDOORS", x, y)) {
-                if (x_in_y(growth * 10, 500)) {
-                    m.ter_set(x, y, t_fungus_floor_in);
-                    converted = true;
-                }
-            } else if (m.has_flag("SUPPORTS_ROOF", x, y)) {
-                if (x_in_y(growth * 10, 1000)) {
-                    m.ter_set(x, y, t_fungus_floor_sup);
-                    converted = true;
-                }
-            } else {
-                if (x_in_y(growth * 10, 2500)) {
-                    m.ter_set(x, y, t_fungus_floor_out);
-                    converted = true;
-                }
-            }
-        } else if (m.has_flag("SHRUB", x, y)) {
-            if (x_in_y(growth * 10, 200)) {
-                m.ter_set(x, y, t_shrub_fungal);
-                converted = true;
-            } else if (x_in_y(growth, 1000)) {
-                m.ter_set(x, y, t_marloss);
-                converted = true;
-            }
-        } else if (m.has_flag("THIN_OBSTACLE", x, y)) {
-            if (x_in_y(growth * 10, 150)) {
-                m.ter_set(x, y, t_fungus_mound);
-                converted = true;
-            }
-        } else if (m.has_flag("YOUNG", x, y)) {
-            if (x_in_y(growth * 10, 500)) {
-                m.ter_set(x, y, t_tree_fungal_young);
-                converted = true;
-            }
-        } else if (m.has_flag("WALL", x, y)) {
-            if (x_in_y(growth * 10, 5000)) {
-                converted = true;
-                if (m.ter_at(x, y).sym == LINE_OXOX) {
-                    m.ter_set(x, y, t_fungus_wall_h);
-                } else if (m.ter_at(x, y).sym == LINE_XOXO) {
-                    m.ter_set(x, y, t_fungus_wall_v);
-                } else {
-                    m.ter_set(x, y, t_fungus_wall);
-                }
-            }
-        }
-        // Furniture conversion
-        if (converted) {
-            if (m.has_flag("FLOWER", x, y)) {
-                m.furn_set(x, y, f_flower_fungal);
-            } else if (m.has_flag("ORGANIC", x, y)) {
-                if (m.furn_at(x, y).movecost == -10) {
-                    m.furn_set(x, y, f_fungal_mass);
-                } else {
-                    m.furn_set(x, y, f_fungal_clump);
-                }
-            } else if (m.has_flag("PLANT", x, y)) {
-                for (size_t k = 0; k < m.i_at(x, y).size(); k++) {
-                    m.i_rem(x, y, k);
-                }
-                item seeds("fungal_seeds", int(calendar::turn));
-                m.add_item_or_charges(x, y, seeds);
-            }
-        }
-        return true;
-    } else {
-        // Everything is already fungus
-        if (growth == 9) {
-            return false;
-        }
-        for (int i = x - 1; i <= x + 1; i++) {
-            for (int j = y - 1; j <= y + 1; j++) {
-                // One spread on average
-                if (!m.has_flag("FUNGUS", i, j) && one_in(9 - growth)) {
-                    //growth chance is 100 in X simplified
-                    if (m.has_flag("DIGGABLE", i, j)) {
-                        m.ter_set(i, j, t_fungus);
-                        converted = true;
-                    } else if (m.has_flag("FLAT", i, j)) {
-                        if (m.has_flag("INDOORS", i, j)) {
-                            if (one_in(5)) {
-                                m.ter_set(i, j, t_fungus_floor_in);
-                                converted = true;
-                            }
-                        } else if (m.has_flag("SUPPORTS_ROOF", i, j)) {
-                            if (one_in(10)) {
-                                m.ter_set(i, j, t_fungus_floor_sup);
-                                converted = true;
-                            }
-                        } else {
-                            if (one_in(25)) {
-                                m.ter_set(i, j, t_fungus_floor_out);
-                                converted = true;
-                            }
-                        }
-                    } else if (m.has_flag("SHRUB", i, j)) {
-                        if (one_in(2)) {
-                            m.ter_set(i, j, t_shrub_fungal);
-                            converted = true;
-                        } else if (one_in(25)) {
-                            m.ter_set(i, j, t_marloss);
-                            converted = true;
-                        }
-                    } else if (m.has_flag("THIN_OBSTACLE", i, j)) {
-                        if (x_in_y(10, 15)) {
-                            m.ter_set(i, j, t_fungus_mound);
-                            converted = true;
-                        }
-                    } else if (m.has_flag("YOUNG", i, j)) {
-                        if (one_in(5)) {
-                            if (m.get_field_strength( tripoint(x, y, get_levz()), fd_fungal_haze) != 0) {
-                                if (one_in(3)) { // young trees are Vulnerable
-                                    m.ter_set(i, j, t_fungus);
-                                    m.add_spawn("mon_fungal_blossom", 1, x, y);
-                                    if (u.sees(x, y)) {
-                                    add_msg(m_warning, _("The young tree blooms forth into a fungal blossom!"));
-                                    }
-                                } else if (one_in(2)) {
-                                    m.ter_set(i, j, t_marloss_tree);
-                                }
-                            } else {
-                                m.ter_set(i, j, t_tree_fungal_young);
-                            }
-                            converted = true;
-                        }
-                    } else if (m.has_flag("TREE", i, j)) {
-                        if (one_in(10)) {
-                            if (m.get_field_strength( tripoint(x, y, get_levz()), fd_fungal_haze) != 0) {
-                                if (one_in(4)) {
-                                    m.ter_set(i, j, t_fungus);
-                                    m.add_spawn("mon_fungal_blossom", 1, x, y);
-                                    if (u.sees(x, y)) {
-                                    add_msg(m_warning, _("The tree blooms forth into a fungal blossom!"));
-                                    }
-                                } else if (one_in(3)) {
-                                    m.ter_set(i, j, t_marloss_tree);
-                                }
-                            } else {
-                                m.ter_set(i, j, t_tree_fungal);
-                            }
-                            converted = true;
-                        }
-                    } else if (m.has_flag("WALL", i, j)) {
-                        if (one_in(50)) {
-                            converted = true;
-                            if (m.ter_at(i, j).sym == LINE_OXOX) {
-                                m.ter_set(i, j, t_fungus_wall_h);
-                            } else if (m.ter_at(i, j).sym == LINE_XOXO) {
-                                m.ter_set(i, j, t_fungus_wall_v);
-                            } else {
-                                m.ter_set(i, j, t_fungus_wall);
-                            }
-                        }
-                    }
-
-                    if (converted) {
-                        if (m.has_flag("FLOWER", i, j)) {
-                            m.furn_set(i, j, f_flower_fungal);
-                        } else if (m.has_flag("ORGANIC", i, j)) {
-                            if (m.furn_at(i, j).movecost == -10) {
-                                m.furn_set(i, j, f_fungal_mass);
-                            } else {
-                                m.furn_set(i, j, f_fungal_clump);
-                            }
-                        } else if (m.has_flag("PLANT", i, j)) {
-                            for (size_t k = 0; k < m.i_at(i, j).size(); k++) {
-                                m.i_rem(i, j, k);
-                            }
-                            item seeds("fungal_seeds", int(calendar::turn));
-                            m.add_item_or_charges(x, y, seeds);
-                        }
-                    }
-                }
-            }
-        }
-        return false;
-    }
+    return m.spread_fungus( x, y );
 }
 
 std::vector<faction *> game::factions_at(int x, int y)
@@ -94,6 +94,14 @@ class game
         void load_static_data();
         /** Loads core data and all mods. */
         void check_all_mod_data();
+        /**
+         * Generates and saves all overmap terrain tiles within the given radius (in overmap
+         * terrain tiles) around the center of the first overmap, where new characters start.
+         * Used by the --pregen-world command line option, runs without user interface:
+         * progress is printed to stdout, errors (including any @ref debugmsg) to stderr.
+         * @return false if the world does not exist, saving failed or there were errors.
+         */
+        bool pregen_world( const std::string &worldname, int radius );
     protected:
         /** Loads core dynamic data. */
         void load_core_data();
@@ -112,6 +120,11 @@ class game
         bool game_error();
         /** True if the game has just started or loaded, else false. */
         bool new_game;
+        /**
+         * Set when running without user interface (see @ref pregen_world): curses has been
+         * ended, nothing may draw on the screen or wait for a key. Used in main.cpp.
+         */
+        bool headless;
         /** Used in main.cpp to determine what type of quit is being performed. */
         quit_status uquit;
         /** Saving and loading functions. */
@@ -149,7 +162,11 @@ class game
         void add_event(event_type type, int on_turn, int faction_id = -1);
         void add_event(event_type type, int on_turn, int faction_id, tripoint where);
         bool event_queued(event_type type);
-        /** Create explosion at (x, y) of intensity (power) with (shrapnel) chunks of shrapnel. */
+        /**
+         * Create explosion at (x, y) of intensity (power) with (shrapnel) chunks of shrapnel.
+         * Explosions caused by another explosion (fuel tanks, explosive terrain, ...)
+         * are queued and handled after it by the outermost call.
+         */
         void explosion(int x, int y, int power, int shrapnel, bool fire, bool blast = true);
         /** Triggers a flashbang explosion at (x, y). */
         void flashbang(int x, int y, bool player_immune = false);
@@ -264,6 +281,11 @@ class game
         std::vector<faction *> factions_at(int x, int y);
         int &scent(int x, int y);
         float ground_natural_light_level() const;
+        /**
+         * Same as above, but at another time, with the weather that the weather
+         * generator yields for that time at the given (absolute map square) location.
+         */
+        float ground_natural_light_level( const calendar &when, const point &location ) const;
         float natural_light_level() const;
         unsigned char light_level();
         void reset_light_level();
@@ -413,6 +435,19 @@ class game
 
         bionic_id random_good_bionic() const; // returns a non-faulty, valid bionic
 
+        /** Arguments of a call to @ref explosion that is waiting in @ref pending_explosions. */
+        struct explosion_data {
+            int x;
+            int y;
+            int power;
+            int shrapnel;
+            bool fire;
+            bool blast;
+        };
+        std::vector<explosion_data> pending_explosions;
+        bool processing_explosions;
+        /** Applies a single explosion, the actual work of @ref explosion. */
+        void do_explosion( const explosion_data &ex );
         // Helper because explosion was getting too big.
         void do_blast( const int x, const int y, const int power, const int radius, const bool fire );
 
@@ -638,6 +673,16 @@ class game
         void rustCheck();        // Degrades practice levels
         void process_events();   // Processes and enacts long-term events
         void process_activity(); // Processes and enacts the player's activity
+        /**
+         * Decides whether the coming turns can be fast-forwarded: the player is asleep or busy
+         * with a long activity and nothing hostile is in view. While fast-forwarding, the
+         * lightmap is only rebuilt, active items that only depend on the time passed are only
+         * processed and the screen is only redrawn once per batch of turns. Anything that wakes
+         * the player or cancels the activity, or a hostile coming into view, ends it on the
+         * same turn.
+         */
+        void update_fast_forward();
+        bool hostile_in_view(); // Whether the player sees a hostile monster or NPC
         void update_weather();   // Updates the temperature and weather patten
         void hallucinate(const int x, const int y); // Prints hallucination junk to the screen
         int  mon_info(WINDOW *); // Prints a list of nearby monsters
@@ -690,6 +735,13 @@ class game
         // ########################## DATA ################################
 
         Creature_tracker critter_tracker;
+        /**
+         * Index into @ref active_npc for each tile of the reality bubble, or -1.
+         * Rebuilt by @ref npc_at whenever @ref player::npc_position_generation changes,
+         * i.e. when an NPC moves or @ref active_npc changes.
+         */
+        mutable std::vector<int> npc_grid;
+        mutable unsigned npc_grid_generation;
 
         int last_target; // The last monster targeted
         bool last_target_was_npc;
@@ -699,6 +751,7 @@ class game
         bool autosafemode; // is autosafemode enabled?
         bool safemodeveh; // safemode while driving?
         int turnssincelastmon; // needed for auto run mode
+        bool fast_forward; // see update_fast_forward
         //  quit_status uquit;    // Set to true if the player quits ('Q')
         bool bVMonsterLookFire;
         calendar nextspawn; // The turn on which monsters will spawn next.
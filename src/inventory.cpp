@@ -69,25 +69,31 @@ bool inventory::is_sorted() const
 
 inventory &inventory::operator+= (const inventory &rhs)
 {
-    for (size_t i = 0; i < rhs.size(); i++) {
-        add_stack(rhs.const_stack(i));
+    build_stack_index();
+    for( auto &stack : rhs.items ) {
+        add_stack( stack );
     }
+    clear_stack_index();
     return *this;
 }
 
 inventory &inventory::operator+= (const std::list<item> &rhs)
 {
+    build_stack_index();
     for( const auto &rh : rhs ) {
         add_item( rh, false, false );
     }
+    clear_stack_index();
     return *this;
 }
 
 inventory &inventory::operator+= (const std::vector<item> &rhs)
 {
+    build_stack_index();
     for( const auto &rh : rhs ) {
         add_item( rh, true );
     }
+    clear_stack_index();
     return *this;
 }
 
@@ -391,20 +397,24 @@ item &inventory::add_item(item newit, bool keep_invlet, bool assign_invlet)
 
 
     // See if we can't stack this item.
-    for( auto &elem : items ) {
-        std::list<item>::iterator it_ref = elem.begin();
-        if( it_ref->stacks_with( newit ) ) {
-            if( it_ref->merge_charges( newit ) ) {
-                return *it_ref;
+    const invstack::iterator match = find_stack_for( newit );
+    if( keep_invlet && assign_invlet ) {
+        for( auto elem = items.begin(); elem != match; ++elem ) {
+            if( elem->front().invlet == newit.invlet ) {
+                // If keep_invlet is true, we'll be forcing other items out of their current invlet.
+                assign_empty_invlet( elem->front() );
             }
-            newit.invlet = it_ref->invlet;
-            elem.push_back( newit );
-            return elem.back();
-        } else if( keep_invlet && assign_invlet && it_ref->invlet == newit.invlet ) {
-            // If keep_invlet is true, we'll be forcing other items out of their current invlet.
-            assign_empty_invlet(*it_ref);
         }
     }
+    if( match != items.end() ) {
+        std::list<item>::iterator it_ref = match->begin();
+        if( it_ref->merge_charges( newit ) ) {
+            return *it_ref;
+        }
+        newit.invlet = it_ref->invlet;
+        match->push_back( newit );
+        return match->back();
+    }
 
     // Couldn't stack the item, proceed.
     if(!reuse_cached_letter) {
@@ -414,9 +424,51 @@ item &inventory::add_item(item newit, bool keep_invlet, bool assign_invlet)
     std::list<item> newstack;
     newstack.push_back(newit);
     items.push_back(newstack);
+    if( use_stack_index ) {
+        stack_index[newit.stacking_hash()].push_back( --items.end() );
+    }
     return items.back().back();
 }
 
+invstack::iterator inventory::find_stack_for( const item &it )
+{
+    if( !use_stack_index ) {
+        for( auto elem = items.begin(); elem != items.end(); ++elem ) {
+            if( elem->front().stacks_with( it ) ) {
+                return elem;
+            }
+        }
+        return items.end();
+    }
+    const auto bucket = stack_index.find( it.stacking_hash() );
+    if( bucket == stack_index.end() ) {
+        return items.end();
+    }
+    // The stacks in the bucket are in inventory order, so this is the same stack as the
+    // one found by the loop above.
+    for( auto &elem : bucket->second ) {
+        if( elem->front().stacks_with( it ) ) {
+            return elem;
+        }
+    }
+    return items.end();
+}
+
+void inventory::build_stack_index()
+{
+    stack_index.clear();
+    for( auto elem = items.begin(); elem != items.end(); ++elem ) {
+        stack_index[elem->front().stacking_hash()].push_back( elem );
+    }
+    use_stack_index = true;
+}
+
+void inventory::clear_stack_index()
+{
+    stack_index.clear();
+    use_stack_index = false;
+}
+
 void inventory::add_item_keep_invlet(item newit)
 {
     add_item(newit, true);
@@ -474,9 +526,11 @@ void inventory::restack(player *p)
     }
 
     //re-add non-matching items
+    build_stack_index();
     for( auto &elem : to_restack ) {
         add_item( elem );
     }
+    clear_stack_index();
 }
 
 static long count_charges_in_list(const itype *type, const map_stack &items)
@@ -492,6 +546,7 @@ static long count_charges_in_list(const itype *type, const map_stack &items)
 void inventory::form_from_map(point origin, int range, bool assign_invlet)
 {
     items.clear();
+    build_stack_index();
     for (int x = origin.x - range; x <= origin.x + range; x++) {
         for (int y = origin.y - range; y <= origin.y + range; y++) {
             if (g->m.has_furn(x, y) && g->m.accessible_furniture(origin.x, origin.y, x, y, range)) {
@@ -503,7 +558,7 @@ void inventory::form_from_map(point origin, int range, bool assign_invlet)
                     if (ammo != NULL) {
                         furn_item.charges = count_charges_in_list(ammo, g->m.i_at(x, y));
                     }
-                    furn_item.item_tags.insert("PSEUDO");
+                    furn_item.set_flag("PSEUDO");
                     add_item(furn_item);
                 }
             }
@@ -537,7 +592,7 @@ void inventory::form_from_map(point origin, int range, bool assign_invlet)
             if (terrain_id == t_cvdmachine) {
                 item cvd_machine("cvd_machine", 0);
                 cvd_machine.charges = 1;
-                cvd_machine.item_tags.insert("PSEUDO");
+                cvd_machine.set_flag("PSEUDO");
                 add_item(cvd_machine);
             }
             // kludge that can probably be done better to check specifically for toilet water to use in
@@ -595,7 +650,7 @@ void inventory::form_from_map(point origin, int range, bool assign_invlet)
                 if (kpart >= 0) {
                     item hotplate("hotplate", 0);
                     hotplate.charges = veh->fuel_left("battery");
-                    hotplate.item_tags.insert("PSEUDO");
+                    hotplate.set_flag("PSEUDO");
                     add_item(hotplate);
 
                     item water("water_clean", 0);
@@ -603,59 +658,60 @@ void inventory::form_from_map(point origin, int range, bool assign_invlet)
                     add_item(water);
 
                     item pot("pot", 0);
-                    pot.item_tags.insert("PSEUDO");
+                    pot.set_flag("PSEUDO");
                     add_item(pot);
                     item pan("pan", 0);
-                    pan.item_tags.insert("PSEUDO");
+                    pan.set_flag("PSEUDO");
                     add_item(pan);
                 }
                 if (weldpart >= 0) {
                     item welder("welder", 0);
                     welder.charges = veh->fuel_left("battery");
-                    welder.item_tags.insert("PSEUDO");
+                    welder.set_flag("PSEUDO");
                     add_item(welder);
 
                     item soldering_iron("soldering_iron", 0);
                     soldering_iron.charges = veh->fuel_left("battery");
-                    soldering_iron.item_tags.insert("PSEUDO");
+                    soldering_iron.set_flag("PSEUDO");
                     add_item(soldering_iron);
                 }
                 if (craftpart >= 0) {
                     item vac_sealer("vac_sealer", 0);
                     vac_sealer.charges = veh->fuel_left("battery");
-                    vac_sealer.item_tags.insert("PSEUDO");
+                    vac_sealer.set_flag("PSEUDO");
                     add_item(vac_sealer);
 
                     item dehydrator("dehydrator", 0);
                     dehydrator.charges = veh->fuel_left("battery");
-                    dehydrator.item_tags.insert("PSEUDO");
+                    dehydrator.set_flag("PSEUDO");
                     add_item(dehydrator);
 
                     item press("press", 0);
                     press.charges = veh->fuel_left("battery");
-                    press.item_tags.insert("PSEUDO");
+                    press.set_flag("PSEUDO");
                     add_item(press);
                 }
                 if (forgepart >= 0) {
                     item forge("forge", 0);
                     forge.charges = veh->fuel_left("battery");
-                    forge.item_tags.insert("PSEUDO");
+                    forge.set_flag("PSEUDO");
                     add_item(forge);
                 }
                 if (chempart >= 0) {
                     item hotplate("hotplate", 0);
                     hotplate.charges = veh->fuel_left("battery");
-                    hotplate.item_tags.insert("PSEUDO");
+                    hotplate.set_flag("PSEUDO");
                     add_item(hotplate);
 
                     item chemistry_set("chemistry_set", 0);
                     chemistry_set.charges = veh->fuel_left("battery");
-                    chemistry_set.item_tags.insert("PSEUDO");
+                    chemistry_set.set_flag("PSEUDO");
                     add_item(chemistry_set);
                 }
             }
         }
     }
+    clear_stack_index();
 }
 
 template<typename Locator>
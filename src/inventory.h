@@ -6,6 +6,7 @@
 
 #include <list>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -294,6 +295,20 @@ class inventory
         template<typename Locator> item remove_item_internal(const Locator &locator);
         template<typename Locator> std::list<item> reduce_stack_internal(const Locator &type, int amount);
 
+        /**
+         * Finding the stack of a new item in @ref add_item compares it with every stack. While
+         * many items are added at once, the stacks are indexed by the @ref item::stacking_hash of
+         * their first item instead (in the order of @ref items). Items can be changed through
+         * references at any other time, so the index is only kept between @ref build_stack_index
+         * and @ref clear_stack_index.
+         */
+        std::unordered_map<size_t, std::vector<invstack::iterator>> stack_index;
+        bool use_stack_index = false;
+        void build_stack_index();
+        void clear_stack_index();
+        /** Returns the first stack the item stacks with, or items.end(). */
+        invstack::iterator find_stack_for(const item &it);
+
         invstack items;
         bool sorted;
 };
@@ -138,7 +138,7 @@ void item::make_corpse( mtype *mt, unsigned int turn )
     make( "corpse" );
     active = mt->has_flag( MF_REVIVES );
     if( active && isReviveSpecial ) {
-        item_tags.insert( "REVIVE_SPECIAL" );
+        set_flag( "REVIVE_SPECIAL" );
     }
     corpse = mt;
     bday = turn;
@@ -194,6 +194,8 @@ void item::init() {
     fridge = 0;
     rot = 0;
     last_rot_check = 0;
+    tags_and_vars_generation = 0;
+    name_cache.reset();
 }
 
 void item::make( const std::string new_type )
@@ -231,17 +233,17 @@ void item::make_handed( const handedness handed )
     if( armor == nullptr ) {
         return;
     }
-    item_tags.erase( "RIGHT" );
-    item_tags.erase( "LEFT" );
+    unset_flag( "RIGHT" );
+    unset_flag( "LEFT" );
     // Always reset the coverage, so to prevent inconsistencies.
     covered_bodyparts = armor->covers;
     if( !armor->sided.any() || handed == NONE ) {
         return;
     }
     if( handed == RIGHT ) {
-        item_tags.insert( "RIGHT" );
+        set_flag( "RIGHT" );
     } else {
-        item_tags.insert( "LEFT" );
+        set_flag( "LEFT" );
     }
     make_sided_if( *armor, covered_bodyparts, handed, bp_arm_l, bp_arm_r );
     make_sided_if( *armor, covered_bodyparts, handed, bp_hand_l, bp_hand_r );
@@ -256,6 +258,7 @@ void item::clear()
     // init(); // this should not go here either, or make() should not use it...
     item_tags.clear();
     item_vars.clear();
+    tags_and_vars_generation++;
 }
 
 bool item::is_null() const
@@ -393,6 +396,141 @@ bool item::stacks_with( const item &rhs ) const
     return true;
 }
 
+size_t item::stacking_hash() const
+{
+    // Only properties that must be equal in stacks_with can be used here.
+    size_t result = std::hash<std::tuple<const itype *, long, int, int, bool>>()(
+        std::make_tuple( type, count_by_charges() ? 0 : charges, damage, burnt, active ) );
+    const std::hash<std::string> hash_string;
+    for( auto &tag : item_tags ) {
+        result = result * 31 + hash_string( tag );
+    }
+    for( auto &var : item_vars ) {
+        result = result * 31 + hash_string( var.first );
+        result = result * 31 + hash_string( var.second );
+    }
+    if( goes_bad() ) {
+        result = result * 31 + bday;
+    }
+    if( corpse != nullptr ) {
+        result = result * 31 + hash_string( corpse->id );
+    }
+    return result * 31 + contents.size();
+}
+
+/** Bumped by @ref item::clear_name_cache, part of every name cache key. */
+static int name_cache_generation = 0;
+
+/**
+ * The properties of a single item that @ref item::tname depends on. The key of an item
+ * is a list of these, the item itself followed by its contents (recursively).
+ */
+struct item::name_cache_entry {
+    const itype *type;
+    long charges;
+    int damage;
+    int burnt;
+    bool active;
+    int bigness;
+    int rot_stage;
+    const mtype *corpse;
+    std::string name;
+    unsigned tags_and_vars_generation;
+    size_t num_contents;
+};
+
+struct item::name_cache_data {
+    std::vector<name_cache_entry> key;
+    // For the "(used)" suffix, see already_used_by_player
+    int player_id;
+    int generation;
+    /** The names for the arguments of tname that have been asked for. */
+    std::vector<std::tuple<unsigned int, bool, std::string>> names;
+    /** Lower case version of tname() */
+    std::string lower_name;
+};
+
+int item::name_rot_stage() const
+{
+    if( !is_food() ) {
+        return 0;
+    }
+    return rotten() ? 3 : is_going_bad() ? 2 : rot < 100 ? 1 : 0;
+}
+
+void item::add_name_cache_key( std::vector<name_cache_entry> &key ) const
+{
+    key.push_back( name_cache_entry{ type, charges, damage, burnt, active, bigness,
+                                     name_rot_stage(), corpse, name, tags_and_vars_generation,
+                                     contents.size() } );
+    for( auto &content : contents ) {
+        content.add_name_cache_key( key );
+    }
+}
+
+bool item::matches_name_cache_key( const std::vector<name_cache_entry> &key, size_t &index ) const
+{
+    // The item fields are public and changed directly all over the place, so the cache
+    // can not be invalidated from setters, instead everything tname uses is compared.
+    // Tags and vars are private, their setters bump tags_and_vars_generation.
+    if( index >= key.size() ) {
+        return false;
+    }
+    const name_cache_entry &entry = key[index++];
+    if( entry.type != type || entry.charges != charges || entry.damage != damage ||
+        entry.burnt != burnt || entry.active != active || entry.bigness != bigness ||
+        entry.corpse != corpse || entry.num_contents != contents.size() ||
+        entry.rot_stage != name_rot_stage() || entry.name != name ||
+        entry.tags_and_vars_generation != tags_and_vars_generation ) {
+        return false;
+    }
+    for( auto &content : contents ) {
+        if( !content.matches_name_cache_key( key, index ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::string &item::cached_tname( const unsigned int quantity, const bool with_prefix ) const
+{
+    size_t index = 0;
+    if( !name_cache || name_cache->player_id != g->u.getID() ||
+        name_cache->generation != name_cache_generation ||
+        !matches_name_cache_key( name_cache->key, index ) || index != name_cache->key.size() ) {
+        auto data = std::make_shared<name_cache_data>();
+        add_name_cache_key( data->key );
+        data->player_id = g->u.getID();
+        data->generation = name_cache_generation;
+        data->names.emplace_back( 1, true, tname() );
+        data->lower_name = std::get<2>( data->names.back() );
+        std::transform( data->lower_name.begin(), data->lower_name.end(),
+                        data->lower_name.begin(), tolower );
+        name_cache = data;
+    }
+    for( auto &name : name_cache->names ) {
+        if( std::get<0>( name ) == quantity && std::get<1>( name ) == with_prefix ) {
+            return std::get<2>( name );
+        }
+    }
+    // The data may be shared with copies of this item, so it is extended in a copy.
+    auto data = std::make_shared<name_cache_data>( *name_cache );
+    data->names.emplace_back( quantity, with_prefix, tname( quantity, with_prefix ) );
+    name_cache = data;
+    return std::get<2>( name_cache->names.back() );
+}
+
+const std::string &item::cached_tname_lower() const
+{
+    cached_tname();
+    return name_cache->lower_name;
+}
+
+void item::clear_name_cache()
+{
+    name_cache_generation++;
+}
+
 bool item::merge_charges( const item &rhs )
 {
     if( !count_by_charges() || !stacks_with( rhs ) ) {
@@ -418,6 +556,7 @@ void item::set_var( const std::string &name, const int value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    tags_and_vars_generation++;
 }
 
 int item::get_var( const std::string &name, const int default_value ) const
@@ -435,6 +574,7 @@ void item::set_var( const std::string &name, const long value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    tags_and_vars_generation++;
 }
 
 long item::get_var( const std::string &name, const long default_value ) const
@@ -449,6 +589,7 @@ long item::get_var( const std::string &name, const long default_value ) const
 void item::set_var( const std::string &name, const double value )
 {
     item_vars[name] = string_format( "%f", value );
+    tags_and_vars_generation++;
 }
 
 double item::get_var( const std::string &name, const double default_value ) const
@@ -463,6 +604,7 @@ double item::get_var( const std::string &name, const double default_value ) cons
 void item::set_var( const std::string &name, const std::string &value )
 {
     item_vars[name] = value;
+    tags_and_vars_generation++;
 }
 
 std::string item::get_var( const std::string &name, const std::string &default_value ) const
@@ -487,6 +629,24 @@ bool item::has_var( const std::string &name ) const
 void item::erase_var( const std::string &name )
 {
     item_vars.erase( name );
+    tags_and_vars_generation++;
+}
+
+bool item::has_own_flag( const std::string &flag ) const
+{
+    return item_tags.count( flag ) > 0;
+}
+
+void item::set_flag( const std::string &flag )
+{
+    item_tags.insert( flag );
+    tags_and_vars_generation++;
+}
+
+void item::unset_flag( const std::string &flag )
+{
+    item_tags.erase( flag );
+    tags_and_vars_generation++;
 }
 
 bool itag2ivar( std::string &item_tag, std::map<std::string, std::string> &item_vars ) {
@@ -1659,13 +1819,14 @@ std::string item::tname( unsigned int quantity, bool with_prefix ) const
 
 // MATERIALS-TODO: put this in json
     std::string damtext = "";
-    if ((damage != 0 || ( OPTIONS["ITEM_HEALTH_BAR"] && is_armor() )) && !is_null() && with_prefix) {
+    static const option_handle<bool> opt_item_health_bar( "ITEM_HEALTH_BAR" );
+    if ((damage != 0 || ( opt_item_health_bar && is_armor() )) && !is_null() && with_prefix) {
         if( damage < 0 )  {
             if( damage < -1 ) {
                 damtext = rm_prefix(_("<dam_adj>bugged "));
             } else if (is_gun())  {
                 damtext = rm_prefix(_("<dam_adj>accurized "));
-            } else if ( OPTIONS["ITEM_HEALTH_BAR"] ) {
+            } else if ( opt_item_health_bar ) {
                 auto const &nc_text = get_item_hp_bar(damage);
                 damtext = "<color_" + string_from_color(nc_text.second) + ">" + nc_text.first + " </color>";
             } else {
@@ -1678,7 +1839,7 @@ std::string item::tname( unsigned int quantity, bool with_prefix ) const
                 if (damage == 3) damtext = rm_prefix(_("<dam_adj>mangled "));
                 if (damage == 4) damtext = rm_prefix(_("<dam_adj>pulped "));
 
-            } else if ( OPTIONS["ITEM_HEALTH_BAR"] ) {
+            } else if ( opt_item_health_bar ) {
                 auto const &nc_text = get_item_hp_bar(damage);
                 damtext = "<color_" + string_from_color(nc_text.second) + ">" + nc_text.first + " </color>";
 
@@ -4412,6 +4573,7 @@ void item::mark_as_used_by_player(const player &p)
     }
     // and always end with a ';'
     used_by_ids += string_format( "%d;", p.getID() );
+    tags_and_vars_generation++;
 }
 
 itype *item::get_curammo() const
@@ -4511,18 +4673,18 @@ int item::processing_speed() const
     return 1;
 }
 
-bool item::process_food( player * /*carrier*/, point pos )
+bool item::process_food( player * /*carrier*/, point pos, const int turns )
 {
     calc_rot( pos );
     if( item_tags.count( "HOT" ) > 0 ) {
-        item_counter--;
+        item_counter -= std::min<unsigned>( item_counter, turns );
         if( item_counter == 0 ) {
-            item_tags.erase( "HOT" );
+            unset_flag( "HOT" );
         }
     } else if( item_tags.count( "COLD" ) > 0 ) {
-        item_counter--;
+        item_counter -= std::min<unsigned>( item_counter, turns );
         if( item_counter == 0 ) {
-            item_tags.erase( "COLD" );
+            unset_flag( "COLD" );
         }
     }
     return false;
@@ -4701,17 +4863,17 @@ void item::reset_cable( player* p )
     }
 }
 
-bool item::process_wet( player * /*carrier*/, point /*pos*/ )
+bool item::process_wet( player * /*carrier*/, point /*pos*/, const int turns )
 {
-    item_counter--;
+    item_counter -= std::min<unsigned>( item_counter, turns );
     if( item_counter == 0 ) {
         const it_tool *tool = dynamic_cast<const it_tool *>( type );
         if( tool != nullptr && tool->revert_to != "null" ) {
             make( tool->revert_to );
         }
-        item_tags.erase( "WET" );
+        unset_flag( "WET" );
         if( !has_flag( "ABSORBENT" ) ) {
-            item_tags.insert( "ABSORBENT" );
+            set_flag( "ABSORBENT" );
         }
         active = false;
     }
@@ -4884,7 +5046,31 @@ bool item::process_charger_gun( player *carrier, point pos )
     return false;
 }
 
-bool item::process( player *carrier, point pos, bool activate )
+bool item::can_process_in_batches() const
+{
+    for( auto &elem : contents ) {
+        if( elem.needs_processing() && !elem.can_process_in_batches() ) {
+            return false;
+        }
+    }
+    if( is_artifact() ) {
+        return false;
+    }
+    if( !active ) {
+        return true;
+    }
+    if( is_corpse() ) {
+        return false;
+    }
+    // See process: drying items are not processed any further.
+    if( has_flag( "WET" ) ) {
+        return true;
+    }
+    return is_food() && !has_flag( "LITCIG" ) && !has_flag( "CABLE_SPOOL" ) && !is_tool() &&
+           !is_charger_gun();
+}
+
+bool item::process( player *carrier, point pos, bool activate, const int turns )
 {
     const bool preserves = type->container && type->container->preserves;
     for( auto it = contents.begin(); it != contents.end(); ) {
@@ -4893,7 +5079,7 @@ bool item::process( player *carrier, point pos, bool activate )
             // is not changed, the item is still fresh.
             it->last_rot_check = calendar::turn;
         }
-        if( it->process( carrier, pos, activate ) ) {
+        if( it->process( carrier, pos, activate, turns ) ) {
             it = contents.erase( it );
         } else {
             ++it;
@@ -4918,13 +5104,13 @@ bool item::process( player *carrier, point pos, bool activate )
     if( !active ) {
         return false;
     }
-    if( is_food() &&  process_food( carrier, pos ) ) {
+    if( is_food() &&  process_food( carrier, pos, turns ) ) {
         return true;
     }
     if( is_corpse() && process_corpse( carrier, pos ) ) {
         return true;
     }
-    if( has_flag( "WET" ) && process_wet( carrier, pos ) ) {
+    if( has_flag( "WET" ) && process_wet( carrier, pos, turns ) ) {
         // Drying items are never destroyed, but we want to exit so they don't get processed as tools.
         return false;
     }
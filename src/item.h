@@ -8,6 +8,7 @@
 #include <bitset>
 #include <unordered_set>
 #include <set>
+#include <memory>
 #include "artifact.h"
 #include "itype.h"
 #include "mtype.h"
@@ -148,6 +149,22 @@ public:
     nc_color color(player *u) const;
     nc_color color_in_inventory() const;
     std::string tname(unsigned int quantity = 1, bool with_prefix = true) const; // item name (includes damage, freshness, etc)
+    /**
+     * Same as `tname()`, but the result is stored in the item and reused as long as
+     * none of the properties that the name depends on have changed.
+     * The returned reference is valid until the item changes or is destroyed, or until
+     * this is called again with other arguments.
+     */
+    const std::string &cached_tname( unsigned int quantity = 1, bool with_prefix = true ) const;
+    /**
+     * Lower case version of @ref cached_tname, for case insensitive searches.
+     */
+    const std::string &cached_tname_lower() const;
+    /**
+     * Invalidates the cached names of all items, must be called when something changes
+     * that affects all item names (e.g. the language or the item health bar option).
+     */
+    static void clear_name_cache();
     std::string display_name(unsigned int quantity = 1) const; // name for display (includes charges, etc)
     void use();
     bool burn(int amount = 1); // Returns true if destroyed
@@ -210,6 +227,11 @@ public:
 
  bool invlet_is_okay();
         bool stacks_with( const item &rhs ) const;
+        /**
+         * Hash of the properties compared by @ref stacks_with. Items that stack have the
+         * same hash, items with different hashes never stack.
+         */
+        size_t stacking_hash() const;
         /**
          * Merge charges of the other item into this item.
          * @return true if the items have been merged, otherwise false.
@@ -427,19 +449,27 @@ public:
      * location of the carrier.
      * @param passive Whether the item should be activated (true), or
      * processed as an active item.
+     * @param turns Number of turns to process at once, more than 1 is only
+     * allowed if @ref can_process_in_batches.
      * @return true if the item has been destroyed by the processing. The caller
      * should than delete the item wherever it was stored.
      * Returns false if the item is not destroyed.
      */
-    bool process(player *carrier, point pos, bool activate);
+    bool process(player *carrier, point pos, bool activate, int turns = 1);
+    /**
+     * Whether processing this item only depends on the number of turns passed
+     * (food and drying items), so processing it for several turns at once has
+     * the same outcome as processing it every turn.
+     */
+    bool can_process_in_batches() const;
 protected:
     // Sub-functions of @ref process, they handle the processing for different
     // processing types, just to make the process function cleaner.
     // The interface is the same as for @ref process.
-    bool process_food(player *carrier, point pos);
+    bool process_food(player *carrier, point pos, int turns);
     bool process_corpse(player *carrier, point pos);
     bool process_artifact(player *carrier, point pos);
-    bool process_wet(player *carrier, point pos);
+    bool process_wet(player *carrier, point pos, int turns);
     bool process_litcig(player *carrier, point pos);
     bool process_cable(player *carrier, point pos);
     bool process_tool(player *carrier, point pos);
@@ -653,6 +683,20 @@ public:
         void erase_var( const std::string &name );
         /*@}*/
 
+        /**
+         * @name Item specific flags
+         *
+         * Flags of this very item, as opposed to the flags of its type. @ref has_flag checks
+         * both. They can only be changed through these functions so that the name cache
+         * notices the change.
+         */
+        /*@{*/
+        /** Whether the item itself (not its type) has the flag. */
+        bool has_own_flag( const std::string &flag ) const;
+        void set_flag( const std::string &flag );
+        void unset_flag( const std::string &flag );
+        /*@}*/
+
         /**
          * @name Armor related functions.
          *
@@ -922,8 +966,27 @@ public:
         std::bitset<num_bp> covered_bodyparts;
         itype* curammo;
         std::map<std::string, std::string> item_vars;
+        std::set<std::string> item_tags; // generic item specific flags
+        /**
+         * Bumped whenever @ref item_tags or @ref item_vars change, the name cache compares
+         * this instead of the containers.
+         */
+        unsigned tags_and_vars_generation;
         // TODO: make a pointer to const
         mtype* corpse;
+        struct name_cache_entry;
+        struct name_cache_data;
+        /** Shared between copies of this item, it's replaced, never changed, on refresh. */
+        mutable std::shared_ptr<const name_cache_data> name_cache;
+        /** Appends the properties used in @ref tname of this item and its contents to key. */
+        void add_name_cache_key( std::vector<name_cache_entry> &key ) const;
+        /**
+         * Whether the properties used in @ref tname equal the ones in key, starting at index.
+         * index is advanced past the entries of this item and its contents.
+         */
+        bool matches_name_cache_key( const std::vector<name_cache_entry> &key, size_t &index ) const;
+        /** Freshness of food as far as @ref tname is concerned. */
+        int name_rot_stage() const;
 public:
  char invlet;             // Inventory letter
  long charges;
@@ -939,7 +1002,6 @@ public:
    int note;            // Associated dynamic text snippet.
    int irridation;      // Tracks radiation dosage.
  };
- std::set<std::string> item_tags; // generic item specific flags
  unsigned item_counter; // generic counter to be used with item flags
  int mission_id; // Refers to a mission in game's master list
  int player_id; // Only give a mission to the right player!
@@ -515,6 +515,7 @@ itype *Item_factory::find_template(Item_tag id)
                                            "  You think it wants to be a %s.", id.c_str());
     bad_itype->sym = '.';
     bad_itype->color = c_white;
+    bad_itype->index = m_templates.size();
     m_templates[id] = bad_itype;
     return bad_itype;
 }
@@ -526,6 +527,8 @@ void Item_factory::add_item_type(itype *new_type)
         return;
     }
     auto &entry = m_templates[new_type->id];
+    // Replacing a type keeps its index, new types are appended.
+    new_type->index = entry != nullptr ? entry->index : m_templates.size() - 1;
     delete entry;
     entry = new_type;
 }
@@ -851,13 +854,9 @@ void Item_factory::load_basic_info(JsonObject &jo, itype *new_item_template)
 {
     std::string new_id = jo.get_string("id");
     new_item_template->id = new_id;
-    if (m_templates.count(new_id) > 0) {
-        // New item already exists. Because mods are loaded after
-        // core data, we override it. This allows mods to change
-        // item from core data.
-        delete m_templates[new_id];
-    }
-    m_templates[new_id] = new_item_template;
+    // If the item already exists, it's replaced. Because mods are loaded after
+    // core data, this allows mods to change item from core data.
+    add_item_type( new_item_template );
 
     // And then proceed to assign the correct field
     new_item_template->price = jo.get_int("price");
@@ -59,7 +59,7 @@ item Single_item_creator::create_single(int birthday, RecursionList &rec) const
         return item(null_item_id, birthday);
     }
     if( one_in( 3 ) && tmp.has_flag( "VARSIZE" ) ) {
-        tmp.item_tags.insert( "FIT" );
+        tmp.set_flag( "FIT" );
     }
     if (modifier.get() != NULL) {
         modifier->modify(tmp);
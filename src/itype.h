@@ -12,6 +12,7 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <limits>
 #include <bitset>
 #include <memory>
 
@@ -378,6 +379,11 @@ struct itype {
     // can be used as lookup key in master itype map
     // Used for save files; aligns to itype_id above.
     std::string id;
+    /**
+     * Dense index of this type, assigned by the @ref Item_factory. Can be used to store
+     * data about item types in a vector instead of a map keyed by the id.
+     */
+    size_t index = std::numeric_limits<size_t>::max();
     /**
      * Slots for various item type properties. Each slot may contain a valid pointer or null, check
      * this before using it.
@@ -36,14 +36,14 @@
 
 void remove_double_ammo_mod( item &it, player &p )
 {
-    if( !it.item_tags.count( "DOUBLE_AMMO" ) ) {
+    if( !it.has_own_flag( "DOUBLE_AMMO" ) ) {
         return;
     }
     p.add_msg_if_player( _( "You remove the double battery capacity mod of your %s!" ),
                          it.tname().c_str() );
     item mod( "battery_compartment", calendar::turn );
     p.i_add_or_drop( mod, 1 );
-    it.item_tags.erase( "DOUBLE_AMMO" );
+    it.unset_flag( "DOUBLE_AMMO" );
     // Easier to remove all batteries than to check for the actual real maximum
     if( it.charges > 0 ) {
         item batteries( "battery", calendar::turn );
@@ -55,7 +55,7 @@ void remove_double_ammo_mod( item &it, player &p )
 
 void remove_recharge_mod( item &it, player &p )
 {
-    if( !it.item_tags.count( "RECHARGE" ) ) {
+    if( !it.has_own_flag( "RECHARGE" ) ) {
         return;
     }
     p.add_msg_if_player( _( "You remove the rechargeable powerpack from your %s!" ),
@@ -64,14 +64,14 @@ void remove_recharge_mod( item &it, player &p )
     mod.charges = it.charges;
     it.charges = 0;
     p.i_add_or_drop( mod, 1 );
-    it.item_tags.erase( "RECHARGE" );
-    it.item_tags.erase( "NO_UNLOAD" );
-    it.item_tags.erase( "NO_RELOAD" );
+    it.unset_flag( "RECHARGE" );
+    it.unset_flag( "NO_UNLOAD" );
+    it.unset_flag( "NO_RELOAD" );
 }
 
 void remove_atomic_mod( item &it, player &p )
 {
-    if( !it.item_tags.count( "ATOMIC_AMMO" ) ) {
+    if( !it.has_own_flag( "ATOMIC_AMMO" ) ) {
         return;
     }
     p.add_msg_if_player( _( "You remove the plutonium cells from your %s!" ), it.tname().c_str() );
@@ -79,10 +79,10 @@ void remove_atomic_mod( item &it, player &p )
     mod.charges = it.charges;
     it.charges = 0;
     p.i_add_or_drop( mod, 1 );
-    it.item_tags.erase( "ATOMIC_AMMO" );
-    it.item_tags.erase( "NO_UNLOAD" );
-    it.item_tags.erase( "RADIOACTIVE" );
-    it.item_tags.erase( "LEAK_DAM" );
+    it.unset_flag( "ATOMIC_AMMO" );
+    it.unset_flag( "NO_UNLOAD" );
+    it.unset_flag( "RADIOACTIVE" );
+    it.unset_flag( "LEAK_DAM" );
 }
 
 void remove_ups_mod( item &it, player &p )
@@ -94,9 +94,9 @@ void remove_ups_mod( item &it, player &p )
     item mod( "battery_ups", calendar::turn );
     p.i_add_or_drop( mod, 1 );
     it.charges = 0;
-    it.item_tags.erase( "USE_UPS" );
-    it.item_tags.erase( "NO_UNLOAD" );
-    it.item_tags.erase( "NO_RELOAD" );
+    it.unset_flag( "USE_UPS" );
+    it.unset_flag( "NO_UNLOAD" );
+    it.unset_flag( "NO_RELOAD" );
 }
 
 // Checks that the player does not have an active item with LITCIG flag.
@@ -2542,7 +2542,7 @@ static int repair_clothing(player *p, item *it, item *fix, int pos) {
             fix->damage++;
         } else if (rn >= 12 && fix->has_flag("VARSIZE") && !fix->has_flag("FIT")) {
             p->add_msg_if_player(m_good, _("You take your %s in, improving the fit."), fix->tname().c_str());
-            fix->item_tags.insert("FIT");
+            fix->set_flag("FIT");
         } else if (rn >= 12 && (fix->has_flag("FIT") || !fix->has_flag("VARSIZE"))) {
             p->add_msg_if_player(m_good, _("You make your %s extra sturdy."), fix->tname().c_str());
             fix->damage--;
@@ -2681,15 +2681,15 @@ int iuse::sew_advanced(player *p, item *it, bool, point)
                       _("Pad with leather"), _("Line with kevlar"), _("Repair clothing"),
                       _("Cancel"), NULL);
 
-    if( (choice == 1 || choice == 2 || choice == 3 || choice == 4) && mod->item_tags.count("wooled") +
-       mod->item_tags.count("furred") + mod->item_tags.count("leather_padded") + mod->item_tags.count("kevlar_padded") >= 2 ){
+    if( (choice == 1 || choice == 2 || choice == 3 || choice == 4) && mod->has_own_flag("wooled") +
+       mod->has_own_flag("furred") + mod->has_own_flag("leather_padded") + mod->has_own_flag("kevlar_padded") >= 2 ){
         p->add_msg_if_player(m_info,_("You can't modify this more than twice."));
         return 0;
     }
 
     switch (choice) {
     case 1: {
-        if(mod->item_tags.count("wooled")) {
+        if(mod->has_own_flag("wooled")) {
             p->add_msg_if_player(m_info,_("There's already a wool lining sewn in."));
             return 0;
         }
@@ -2754,17 +2754,17 @@ int iuse::sew_advanced(player *p, item *it, bool, point)
             p->add_msg_if_player(m_mixed, _("You sew in a wool lining on your %s, but waste a lot of thread."),
                                  mod->tname().c_str());
             p->consume_items(comps);
-            mod->item_tags.insert("wooled");
+            mod->set_flag("wooled");
             thread_used = rng(5, 14);
         } else {
             p->add_msg_if_player(m_good, _("You sew in a wool lining on your %s!"), mod->tname().c_str());
-            mod->item_tags.insert("wooled");
+            mod->set_flag("wooled");
             p->consume_items(comps);
         }
         return thread_used;
     }
     case 2: {
-        if(mod->item_tags.count("furred")) {
+        if(mod->has_own_flag("furred")) {
             p->add_msg_if_player(m_info,_("There's already a fur lining sewn in."));
             return 0;
         }
@@ -2829,17 +2829,17 @@ int iuse::sew_advanced(player *p, item *it, bool, point)
             p->add_msg_if_player(m_mixed, _("You sew in a fur lining on your %s, but waste a lot of thread."),
                                  mod->tname().c_str());
             p->consume_items(comps);
-            mod->item_tags.insert("furred");
+            mod->set_flag("furred");
             thread_used = rng(5, 14);
         } else {
             p->add_msg_if_player(m_good, _("You sew in a fur lining on your %s!"), mod->tname().c_str());
-            mod->item_tags.insert("furred");
+            mod->set_flag("furred");
             p->consume_items(comps);
         }
         return thread_used;
     }
     case 3: {
-        if(mod->item_tags.count("leather_padded")) {
+        if(mod->has_own_flag("leather_padded")) {
             p->add_msg_if_player(m_info,_("This is already padded with leather."));
             return 0;
         }
@@ -2903,18 +2903,18 @@ int iuse::sew_advanced(player *p, item *it, bool, point)
             p->add_msg_if_player(m_mixed, _("You pad your %s with leather, but waste a lot of thread."),
                                  mod->tname().c_str());
             p->consume_items(comps);
-            mod->item_tags.insert("leather_padded");
+            mod->set_flag("leather_padded");
             thread_used = rng(5, 14 + (rng(1, 3)));
         } else {
             p->add_msg_if_player(m_good, _("You pad your %s with leather!"), mod->tname().c_str());
-            mod->item_tags.insert("leather_padded");
+            mod->set_flag("leather_padded");
             p->consume_items(comps);
 
         }
         return thread_used;
     }
     case 4: {
-        if(mod->item_tags.count("kevlar_padded")) {
+        if(mod->has_own_flag("kevlar_padded")) {
             p->add_msg_if_player(m_info,_("This is already lined with kevlar."));
             return 0;
         }
@@ -2978,11 +2978,11 @@ int iuse::sew_advanced(player *p, item *it, bool, point)
             p->add_msg_if_player(m_mixed, _("You line your %s with kevlar, but waste a lot of thread."),
                                  mod->tname().c_str());
             p->consume_items(comps);
-            mod->item_tags.insert("kevlar_padded");
+            mod->set_flag("kevlar_padded");
             thread_used = rng(5, 14 + (rng(1, 3)));
         } else {
             p->add_msg_if_player(m_good, _("You line your %s with kevlar!"), mod->tname().c_str());
-            mod->item_tags.insert("kevlar_padded");
+            mod->set_flag("kevlar_padded");
             p->consume_items(comps);
 
         }
@@ -3028,7 +3028,7 @@ int iuse::extra_battery(player *p, item *, bool, point)
     remove_ups_mod(*modded, *p);
 
     p->add_msg_if_player( _( "You double the battery capacity of your %s!" ), modded->tname().c_str() );
-    modded->item_tags.insert("DOUBLE_AMMO");
+    modded->set_flag("DOUBLE_AMMO");
     return 1;
 }
 
@@ -3067,9 +3067,9 @@ int iuse::rechargeable_battery(player *p, item *it, bool, point)
 
     p->add_msg_if_player( _( "You replace the battery compartment of your %s with a rechargeable battery pack!" ), modded->tname().c_str() );
     modded->charges = it->charges;
-    modded->item_tags.insert("RECHARGE");
-    modded->item_tags.insert("NO_UNLOAD");
-    modded->item_tags.insert("NO_RELOAD");
+    modded->set_flag("RECHARGE");
+    modded->set_flag("NO_UNLOAD");
+    modded->set_flag("NO_RELOAD");
     return 1;
 }
 
@@ -3108,10 +3108,10 @@ int iuse::atomic_battery(player *p, item *it, bool, point)
     remove_ammo( modded, *p ); // remove batteries, item::charges is now plutonium
 
     p->add_msg_if_player( _( "You modify your %s to run off plutonium cells!" ), modded->tname().c_str() );
-    modded->item_tags.insert("ATOMIC_AMMO");
-    modded->item_tags.insert("RADIOACTIVE");
-    modded->item_tags.insert("LEAK_DAM");
-    modded->item_tags.insert("NO_UNLOAD");
+    modded->set_flag("ATOMIC_AMMO");
+    modded->set_flag("RADIOACTIVE");
+    modded->set_flag("LEAK_DAM");
+    modded->set_flag("NO_UNLOAD");
     modded->charges = it->charges;
     return 1;
 }
@@ -3153,9 +3153,9 @@ int iuse::ups_battery(player *p, item *, bool, point)
     remove_ammo(modded, *p);
 
     p->add_msg_if_player( _( "You modify your %s to run off a UPS!" ), modded->tname().c_str() );
-    modded->item_tags.insert("USE_UPS");
-    modded->item_tags.insert("NO_UNLOAD");
-    modded->item_tags.insert("NO_RELOAD");
+    modded->set_flag("USE_UPS");
+    modded->set_flag("NO_UNLOAD");
+    modded->set_flag("NO_RELOAD");
     //Perhaps keep the modded charges at 1 or 0?
     modded->charges = 0;
     return 1;
@@ -3205,7 +3205,7 @@ int iuse::fishing_rod(player *p, item *it, bool, point)
         return 0;
     }
     point op = overmapbuffer::ms_to_omt_copy( g->m.getabs( dirx, diry ) );
-    if( !otermap[overmap_buffer.ter(op.x, op.y, g->get_levz())].has_flag(river_tile) ) {
+    if( !otermap[overmap_buffer.get_ter(op.x, op.y, g->get_levz())].has_flag(river_tile) ) {
         p->add_msg_if_player(m_info, _("That water does not contain any fish.  Try a river instead."));
         return 0;
     }
@@ -3257,7 +3257,7 @@ int iuse::fish_trap(player *p, item *it, bool t, point pos)
             return 0;
         }
         point op = overmapbuffer::ms_to_omt_copy(g->m.getabs(dirx, diry));
-        if( !otermap[overmap_buffer.ter(op.x, op.y, g->get_levz())].has_flag(river_tile) ) {
+        if( !otermap[overmap_buffer.get_ter(op.x, op.y, g->get_levz())].has_flag(river_tile) ) {
             p->add_msg_if_player(m_info, _("That water does not contain any fish, try a river instead."));
             return 0;
         }
@@ -3288,7 +3288,7 @@ int iuse::fish_trap(player *p, item *it, bool t, point pos)
                 return 0;
             }
             point op = overmapbuffer::ms_to_omt_copy( g->m.getabs( pos.x, pos.y ) );
-           if( !otermap[overmap_buffer.ter(op.x, op.y, g->get_levz())].has_flag(river_tile) ) {
+           if( !otermap[overmap_buffer.get_ter(op.x, op.y, g->get_levz())].has_flag(river_tile) ) {
                 return 0;
             }
             int success = -50;
@@ -3696,7 +3696,7 @@ int iuse::solder_weld(player *p, item *it, bool, point)
                 } else if (rn >= 12 && fix->has_flag("VARSIZE") && !fix->has_flag("FIT")) {
                     p->add_msg_if_player(m_good, _("You take your %s in, improving the fit."),
                                          fix->tname().c_str());
-                    fix->item_tags.insert("FIT");
+                    fix->set_flag("FIT");
                 } else if (rn >= 12 && (fix->has_flag("FIT") || !fix->has_flag("VARSIZE"))) {
                     p->add_msg_if_player(m_good, _("You make your %s extra sturdy."), fix->tname().c_str());
                     fix->damage--;
@@ -6839,7 +6839,7 @@ static bool heat_item(player *p)
     if ((target->is_food()) && (target->has_flag("EATEN_HOT"))) {
         p->moves -= 300;
         add_msg(_("You heat up the food."));
-        target->item_tags.insert("HOT");
+        target->set_flag("HOT");
         target->active = true;
         target->item_counter = 600; // sets the hot food flag for 60 minutes
         return true;
@@ -7377,8 +7377,8 @@ int iuse::towel(player *p, item *it, bool t, point)
         }
 
         // WET, active items have their timer decremented every turn
-        it->item_tags.erase("ABSORBENT");
-        it->item_tags.insert("WET");
+        it->unset_flag("ABSORBENT");
+        it->set_flag("WET");
         it->active = true;
     }
     return it->type->charges_to_use();
@@ -7801,7 +7801,7 @@ void init_memory_card_with_random_stuff(player *, item *it)
                                       it->has_flag("MC_SCIENCE_STUFF")) && !(it->has_flag("MC_USED") ||
                                               it->has_flag("MC_HAS_DATA"))) {
 
-        it->item_tags.insert("MC_HAS_DATA");
+        it->set_flag("MC_HAS_DATA");
 
         bool encrypted = false;
 
@@ -8231,7 +8231,7 @@ int iuse::einktabletpc(player *p, item *it, bool t, point pos)
             if (0 == rchoice) {
                 return it->type->charges_to_use();
             } else {
-                it->item_tags.insert("HAS_RECIPE");
+                it->set_flag("HAS_RECIPE");
                 const auto rec_id = candidate_recipes[rchoice - 1];
                 it->set_var( "RECIPE", rec_id );
 
@@ -8638,7 +8638,7 @@ int iuse::camera(player *p, item *it, bool, point)
 
         mc->make("mobile_memory_card");
         mc->clear();
-        mc->item_tags.insert("MC_HAS_DATA");
+        mc->set_flag("MC_HAS_DATA");
 
         mc->set_var( "MC_MONSTER_PHOTOS", it->get_var( "CAMERA_MONSTER_PHOTOS" ) );
         p->add_msg_if_player(m_info, _("You upload monster photos to memory card."));
@@ -8654,7 +8654,7 @@ int iuse::ehandcuffs(player *p, item *it, bool t, point pos)
     if (t) {
 
         if (g->m.has_flag("SWIMMABLE", pos.x, pos.y)) {
-            it->item_tags.erase("NO_UNWIELD");
+            it->unset_flag("NO_UNWIELD");
             it->charges = 0;
             it->active = false;
             add_msg(m_good, _("%s automatically turned off!"), it->tname().c_str());
@@ -8664,7 +8664,7 @@ int iuse::ehandcuffs(player *p, item *it, bool t, point pos)
         if (it->charges == 0) {
 
             sounds::sound(pos.x, pos.y, 2, "Click.");
-            it->item_tags.erase("NO_UNWIELD");
+            it->unset_flag("NO_UNWIELD");
             it->active = false;
 
             if (p->has_item(it) && p->weapon.type->id == "e_handcuffs") {
@@ -8678,7 +8678,7 @@ int iuse::ehandcuffs(player *p, item *it, bool t, point pos)
             if (p->has_active_bionic("bio_shock") && p->power_level >= 2 && one_in(5)) {
                 p->charge_power(-2);
 
-                it->item_tags.erase("NO_UNWIELD");
+                it->unset_flag("NO_UNWIELD");
                 it->charges = 0;
                 it->active = false;
                 add_msg(m_good, _("The %s crackle with electricity from your bionic, then come off your hands!"), it->tname().c_str());
@@ -9207,7 +9207,7 @@ int iuse::multicooker(player *p, item *it, bool t, point pos)
             meal.active = true;
 
             if (meal.has_flag("EATEN_HOT")) {
-                meal.item_tags.insert("HOT");
+                meal.set_flag("HOT");
                 meal.item_counter = 600;
             }
 
@@ -9601,7 +9601,7 @@ int iuse::weather_tool(player *p, item *it, bool, point)
         if( veh ) {
             vehwindspeed = abs(veh->velocity / 100); // For mph
         }
-        const oter_id &cur_om_ter = overmap_buffer.ter(p->global_omt_location());
+        const oter_id &cur_om_ter = overmap_buffer.get_ter(p->global_omt_location());
         std::string omtername = otermap[cur_om_ter].name;
         int windpower = get_local_windpower(weatherPoint.windpower + vehwindspeed, omtername, g->is_sheltered(g->u.posx(), g->u.posy()));
 
@@ -302,6 +302,7 @@ long unfold_vehicle_iuse::use(player *p, item *it, bool /*t*/, point /*pos*/) co
                 dst.amount = src.amount;
                 dst.flags = src.flags;
             }
+            veh->physics_dirty = true;
         } catch(std::string e) {
             debugmsg("Error restoring vehicle: %s", e.c_str());
         }
@@ -44,9 +44,10 @@ void map::build_transparency_cache()
         &transparency_cache[0][0], MAPSIZE*SEEX * MAPSIZE*SEEY, LIGHT_TRANSPARENCY_CLEAR);
 
     // Traverse the submaps in order
+    const map &cmap = *this;
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
-            auto const cur_submap = get_submap_at_grid( smx, smy );
+            const submap *const cur_submap = cmap.get_submap_at_grid( smx, smy );
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -153,9 +154,10 @@ void map::generate_lightmap()
     // LIGHTMAP_CACHE_X = MAPSIZE * SEEX
     // LIGHTMAP_CACHE_Y = MAPSIZE * SEEY
     // Traverse the submaps in order
+    const map &cmap = *this;
     for (int smx = 0; smx < my_MAPSIZE; ++smx) {
         for (int smy = 0; smy < my_MAPSIZE; ++smy) {
-            auto const cur_submap = get_submap_at_grid( smx, smy );
+            const submap *const cur_submap = cmap.get_submap_at_grid( smx, smy );
 
             for (int sx = 0; sx < SEEX; ++sx) {
                 for (int sy = 0; sy < SEEY; ++sy) {
@@ -499,17 +501,17 @@ void map::build_seen_cache()
     const int offsetX = g->u.posx();
     const int offsetY = g->u.posy();
 
-    castLight( 1, 1.0f, 0.0f, 0, 1, 1, 0, offsetX, offsetY, 0 );
-    castLight( 1, 1.0f, 0.0f, 1, 0, 0, 1, offsetX, offsetY, 0 );
+    castLight( seen_cache, 1, 1.0f, 0.0f, 0, 1, 1, 0, offsetX, offsetY, 0 );
+    castLight( seen_cache, 1, 1.0f, 0.0f, 1, 0, 0, 1, offsetX, offsetY, 0 );
 
-    castLight( 1, 1.0f, 0.0f, 0, -1, 1, 0, offsetX, offsetY, 0 );
-    castLight( 1, 1.0f, 0.0f, -1, 0, 0, 1, offsetX, offsetY, 0 );
+    castLight( seen_cache, 1, 1.0f, 0.0f, 0, -1, 1, 0, offsetX, offsetY, 0 );
+    castLight( seen_cache, 1, 1.0f, 0.0f, -1, 0, 0, 1, offsetX, offsetY, 0 );
 
-    castLight( 1, 1.0f, 0.0f, 0, 1, -1, 0, offsetX, offsetY, 0 );
-    castLight( 1, 1.0f, 0.0f, 1, 0, 0, -1, offsetX, offsetY, 0 );
+    castLight( seen_cache, 1, 1.0f, 0.0f, 0, 1, -1, 0, offsetX, offsetY, 0 );
+    castLight( seen_cache, 1, 1.0f, 0.0f, 1, 0, 0, -1, offsetX, offsetY, 0 );
 
-    castLight( 1, 1.0f, 0.0f, 0, -1, -1, 0, offsetX, offsetY, 0 );
-    castLight( 1, 1.0f, 0.0f, -1, 0, 0, -1, offsetX, offsetY, 0 );
+    castLight( seen_cache, 1, 1.0f, 0.0f, 0, -1, -1, 0, offsetX, offsetY, 0 );
+    castLight( seen_cache, 1, 1.0f, 0.0f, -1, 0, 0, -1, offsetX, offsetY, 0 );
 
     int part;
     if ( vehicle *veh = veh_at( offsetX, offsetY, part ) ) {
@@ -560,22 +562,46 @@ void map::build_seen_cache()
             //
             // The naive solution of making the mirrors act like a second player
             // at an offset appears to give reasonable results though.
-            castLight( 1, 1.0f, 0.0f, 0, 1, 1, 0, mirror_pos.x, mirror_pos.y, offsetDistance );
-            castLight( 1, 1.0f, 0.0f, 1, 0, 0, 1, mirror_pos.x, mirror_pos.y, offsetDistance );
+            castLight( seen_cache, 1, 1.0f, 0.0f, 0, 1, 1, 0, mirror_pos.x, mirror_pos.y, offsetDistance );
+            castLight( seen_cache, 1, 1.0f, 0.0f, 1, 0, 0, 1, mirror_pos.x, mirror_pos.y, offsetDistance );
 
-            castLight( 1, 1.0f, 0.0f, 0, -1, 1, 0, mirror_pos.x, mirror_pos.y, offsetDistance );
-            castLight( 1, 1.0f, 0.0f, -1, 0, 0, 1, mirror_pos.x, mirror_pos.y, offsetDistance );
+            castLight( seen_cache, 1, 1.0f, 0.0f, 0, -1, 1, 0, mirror_pos.x, mirror_pos.y, offsetDistance );
+            castLight( seen_cache, 1, 1.0f, 0.0f, -1, 0, 0, 1, mirror_pos.x, mirror_pos.y, offsetDistance );
 
-            castLight( 1, 1.0f, 0.0f, 0, 1, -1, 0, mirror_pos.x, mirror_pos.y, offsetDistance );
-            castLight( 1, 1.0f, 0.0f, 1, 0, 0, -1, mirror_pos.x, mirror_pos.y, offsetDistance );
+            castLight( seen_cache, 1, 1.0f, 0.0f, 0, 1, -1, 0, mirror_pos.x, mirror_pos.y, offsetDistance );
+            castLight( seen_cache, 1, 1.0f, 0.0f, 1, 0, 0, -1, mirror_pos.x, mirror_pos.y, offsetDistance );
 
-            castLight( 1, 1.0f, 0.0f, 0, -1, -1, 0, mirror_pos.x, mirror_pos.y, offsetDistance );
-            castLight( 1, 1.0f, 0.0f, -1, 0, 0, -1, mirror_pos.x, mirror_pos.y, offsetDistance );
+            castLight( seen_cache, 1, 1.0f, 0.0f, 0, -1, -1, 0, mirror_pos.x, mirror_pos.y, offsetDistance );
+            castLight( seen_cache, 1, 1.0f, 0.0f, -1, 0, 0, -1, mirror_pos.x, mirror_pos.y, offsetDistance );
         }
     }
 }
 
-void map::castLight( int row, float start, float end, int xx, int xy, int yx, int yy,
+void map::build_fov_cache( bool (&fov)[MAPSIZE*SEEX][MAPSIZE*SEEY], const int x, const int y,
+                           const int range )
+{
+    if( !INBOUNDS( x, y ) ) {
+        return;
+    }
+    fov[x][y] = true;
+    // castLight's radius is 60 - offsetDistance
+    const int offsetDistance = 60 - range;
+
+    castLight( fov, 1, 1.0f, 0.0f, 0, 1, 1, 0, x, y, offsetDistance );
+    castLight( fov, 1, 1.0f, 0.0f, 1, 0, 0, 1, x, y, offsetDistance );
+
+    castLight( fov, 1, 1.0f, 0.0f, 0, -1, 1, 0, x, y, offsetDistance );
+    castLight( fov, 1, 1.0f, 0.0f, -1, 0, 0, 1, x, y, offsetDistance );
+
+    castLight( fov, 1, 1.0f, 0.0f, 0, 1, -1, 0, x, y, offsetDistance );
+    castLight( fov, 1, 1.0f, 0.0f, 1, 0, 0, -1, x, y, offsetDistance );
+
+    castLight( fov, 1, 1.0f, 0.0f, 0, -1, -1, 0, x, y, offsetDistance );
+    castLight( fov, 1, 1.0f, 0.0f, -1, 0, 0, -1, x, y, offsetDistance );
+}
+
+void map::castLight( bool (&output_cache)[MAPSIZE*SEEX][MAPSIZE*SEEY],
+                     int row, float start, float end, int xx, int xy, int yx, int yy,
                      const int offsetX, const int offsetY, const int offsetDistance )
 {
     float newStart = 0.0f;
@@ -605,7 +631,7 @@ void map::castLight( int row, float start, float end, int xx, int xy, int yx, in
                 float bright = (float) (1 - (rStrat.radius(deltaX, deltaY) / radius));
                 lightMap[currentX][currentY] = bright;
                 */
-                seen_cache[currentX][currentY] = true;
+                output_cache[currentX][currentY] = true;
             }
 
             if( blocked ) {
@@ -623,7 +649,7 @@ void map::castLight( int row, float start, float end, int xx, int xy, int yx, in
                     distance < radius ) {
                     //hit a wall within sight line
                     blocked = true;
-                    castLight(distance + 1, start, leftSlope, xx, xy, yx, yy,
+                    castLight(output_cache, distance + 1, start, leftSlope, xx, xy, yx, yy,
                               offsetX, offsetY, offsetDistance);
                     newStart = rightSlope;
                 }
@@ -61,6 +61,8 @@ int main(int argc, char *argv[])
     int seed = time(NULL);
     bool verifyexit = false;
     bool check_all_mods = false;
+    std::string pregen_world;
+    int pregen_radius = 10;
 
     // Set default file paths
 #ifdef PREFIX
@@ -86,7 +88,7 @@ int main(int argc, char *argv[])
         const arg_handler first_pass_arguments[] = {
             {
                 "--seed", "<string of letters and or numbers>",
-                "Sets the random number generator's seed value",
+                "Sets the random number generator's seed value, new worlds derive their own seed from it",
                 section_default,
                 [&seed](int num_args, const char **params) -> int {
                     if (num_args < 1) return -1;
@@ -113,6 +115,27 @@ int main(int argc, char *argv[])
                     return 0;
                 }
             },
+            {
+                "--pregen-world", "<world name>",
+                "Generates and saves the area around the starting location of the world, then exits",
+                section_default,
+                [&pregen_world](int num_args, const char **params) -> int {
+                    if (num_args < 1) return -1;
+                    pregen_world = params[0];
+                    return 1;
+                }
+            },
+            {
+                "--radius", "<overmap tiles>",
+                "Radius of the area generated by --pregen-world (default 10)",
+                section_default,
+                [&pregen_radius](int num_args, const char **params) -> int {
+                    if (num_args < 1) return -1;
+                    pregen_radius = atoi(params[0]);
+                    if (pregen_radius < 0) return -1;
+                    return 1;
+                }
+            },
             {
                 "--basepath", "<path>",
                 "Base path for all game data subdirectories",
@@ -376,6 +399,7 @@ int main(int argc, char *argv[])
     set_escdelay(10); // Make escape actually responsive
 
     std::srand(seed);
+    rng_set_seed(seed);
 
     g = new game;
     // First load and initialize everything that does not
@@ -402,8 +426,16 @@ int main(int argc, char *argv[])
             // is only for verifying that stage, so we exit.
             exit_handler(0);
         }
+        if (!pregen_world.empty()) {
+            // Progress and errors go to stdout and stderr, not to the curses screen.
+            g->headless = true;
+            endwin();
+            exit_handler(g->pregen_world(pregen_world, pregen_radius) ? 0 : -999);
+        }
     } catch(std::string &error_message) {
-        if(!error_message.empty()) {
+        if(g->headless) {
+            fprintf(stderr, "%s\n", error_message.c_str());
+        } else if(!error_message.empty()) {
             debugmsg("%s", error_message.c_str());
         }
         exit_handler(-999);
@@ -491,22 +523,25 @@ void printHelpMessage(const arg_handler *first_pass_arguments,
 
 void exit_handler(int s)
 {
-    if (s != 2 || query_yn(_("Really Quit? All unsaved changes will be lost."))) {
-        erase(); // Clear screen
+    const bool headless = g != NULL && g->headless;
+    if (s != 2 || headless || query_yn(_("Really Quit? All unsaved changes will be lost."))) {
+        if (!headless) {
+            erase(); // Clear screen
 
-        int ret;
+            int ret;
 #if (defined _WIN32 || defined WINDOWS)
-        ret = system("cls"); // Tell the terminal to clear itself
-        ret = system("color 07");
+            ret = system("cls"); // Tell the terminal to clear itself
+            ret = system("color 07");
 #else
-        ret = system("clear"); // Tell the terminal to clear itself
+            ret = system("clear"); // Tell the terminal to clear itself
 #endif
-        if (ret != 0) {
-            DebugLog( D_ERROR, DC_ALL ) << "system(\"clear\"): error returned: " << ret;
+            if (ret != 0) {
+                DebugLog( D_ERROR, DC_ALL ) << "system(\"clear\"): error returned: " << ret;
+            }
         }
-        deinitDebug();
 
-        int exit_status = 0;
+        // -999 is passed on errors, an interrupted headless run failed as well.
+        int exit_status = ( s == -999 || ( s == 2 && headless ) ) ? 1 : 0;
         if( g != NULL ) {
             if( g->game_error() ) {
                 exit_status = 1;
@@ -514,7 +549,12 @@ void exit_handler(int s)
             delete g;
         }
 
-        endwin();
+        if (!headless) {
+            // Headless runs have ended curses already.
+            endwin();
+        }
+        // Last, deleting the game still logs.
+        deinitDebug();
 
         exit( exit_status );
     }
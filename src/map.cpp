@@ -13,10 +13,12 @@
 #include "debug.h"
 #include "messages.h"
 #include "mapsharing.h"
+#include "mapgen.h"
 
 #include <cmath>
 #include <stdlib.h>
 #include <fstream>
+#include <algorithm>
 
 extern bool is_valid_in_w_terrain(int,int);
 
@@ -123,8 +125,16 @@ map::map(int mapsize)
 #endif
     dbg(D_INFO) << "map::map(): my_MAPSIZE: " << my_MAPSIZE;
     veh_in_active_range = true;
+    generating_private = false;
+    defer_global_changes = false;
+    items_batch_turns = 0;
+    shared_generation = MAPBUFFER.get_shared_generation();
+    unshared_seen = MAPBUFFER.get_unshared_positions().size();
     transparency_cache_dirty = true;
     outside_cache_dirty = true;
+    pathing_cache_dirty = true;
+    reachability_cache_dirty[0] = true;
+    reachability_cache_dirty[1] = true;
     memset(veh_exists_at, 0, sizeof(veh_exists_at));
     traplocs.resize( traplist.size() );
 }
@@ -144,10 +154,11 @@ VehicleList map::get_vehicles(const int sx, const int sy, const int ex, const in
  const int chunk_sy = std::max( 0, (sy / SEEY) - 1 );
  const int chunk_ey = std::min( my_MAPSIZE - 1, (ey / SEEY) + 1 );
  VehicleList vehs;
+ const map &cmap = *this;
 
  for(int cx = chunk_sx; cx <= chunk_ex; ++cx) {
   for(int cy = chunk_sy; cy <= chunk_ey; ++cy) {
-   submap *current_submap = get_submap_at_grid( cx, cy );
+   const submap *current_submap = cmap.get_submap_at_grid( cx, cy );
    for( auto &elem : current_submap->vehicles ) {
     wrapped_vehicle w;
     w.v = elem;
@@ -322,6 +333,9 @@ void map::update_vehicle_cache( vehicle *veh, const bool brand_new )
             veh_exists_at[p.x][p.y] = true;
         }
     }
+    // Vehicle tiles are always passable, moving ones may split components.
+    reachability_cache_dirty[0] = true;
+    reachability_cache_dirty[1] = true;
 }
 
 void map::clear_vehicle_cache()
@@ -334,9 +348,11 @@ void map::clear_vehicle_cache()
         }
         veh_cached_parts.erase( part );
     }
+    reachability_cache_dirty[0] = true;
+    reachability_cache_dirty[1] = true;
 }
 
-void map::update_vehicle_list( submap *const to )
+void map::update_vehicle_list( const submap *const to )
 {
     // Update vehicle data
     for( auto & elem : to->vehicles ) {
@@ -374,6 +390,7 @@ void map::board_vehicle(int x, int y, player *p)
     }
     veh->parts[seat_part].set_flag(vehicle_part::passenger_flag);
     veh->parts[seat_part].passenger_id = p->getID();
+    veh->physics_dirty = true;
 
     p->setx( x );
     p->sety( y );
@@ -424,6 +441,7 @@ void map::unboard_vehicle(const int x, const int y)
     passenger->driving_recoil = 0;
     passenger->controlling_vehicle = false;
     veh->parts[seat_part].remove_flag(vehicle_part::passenger_flag);
+    veh->physics_dirty = true;
     veh->skidding = true;
 }
 
@@ -439,6 +457,7 @@ void map::destroy_vehicle (vehicle *veh)
             vehicle_list.erase(veh);
             reset_vehicle_cache();
             current_submap->vehicles.erase (current_submap->vehicles.begin() + i);
+            current_submap->dirty = true;
             delete veh;
             return;
         }
@@ -525,6 +544,7 @@ bool map::displace_vehicle (int &x, int &y, const int dx, const int dy, bool tes
                          veh->global_y() + veh->parts[p].precalc[0].y,
                                   g->u.posx(), g->u.posy());
             veh->parts[p].remove_flag(vehicle_part::passenger_flag);
+            veh->physics_dirty = true;
             continue;
         }
         // add recoil
@@ -545,6 +565,7 @@ bool map::displace_vehicle (int &x, int &y, const int dx, const int dy, bool tes
     for (auto &p : veh->parts) {
         p.precalc[0] = p.precalc[1];
     }
+    veh->mounts_dirty = true;
 
     veh->posx = dst_offset_x;
     veh->posy = dst_offset_y;
@@ -552,6 +573,8 @@ bool map::displace_vehicle (int &x, int &y, const int dx, const int dy, bool tes
         veh->set_submap_moved( int( x2 / SEEX ), int( y2 / SEEY ) );
         dst_submap->vehicles.push_back( veh );
         src_submap->vehicles.erase( src_submap->vehicles.begin() + our_i );
+        dst_submap->dirty = true;
+        src_submap->dirty = true;
     }
 
     // Need old coords to check for remote control
@@ -1142,7 +1165,7 @@ furn_id map::furn(const int x, const int y) const
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at(x, y, lx, ly);
+    const submap * const current_submap = get_submap_at(x, y, lx, ly);
 
     return current_submap->get_furn(lx, ly);
 }
@@ -1158,6 +1181,7 @@ void map::furn_set(const int x, const int y, const furn_id new_furniture)
 
  set_transparency_cache_dirty();
  current_submap->set_furn(lx, ly, new_furniture);
+ update_pathing_cache( x, y );
 }
 
 void map::furn_set(const int x, const int y, const std::string new_furniture) {
@@ -1210,7 +1234,7 @@ furn_id map::furn( const tripoint &p ) const
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
 
     return current_submap->get_furn( lx, ly );
 }
@@ -1228,6 +1252,9 @@ void map::furn_set( const tripoint &p, const furn_id new_furniture)
     // TODO: consider checking if the transparency value actually changes
     set_transparency_cache_dirty();
     current_submap->set_furn( lx, ly, new_furniture );
+    if( p.z == abs_sub.z ) {
+        update_pathing_cache( p.x, p.y );
+    }
 }
 
 void map::furn_set( const tripoint &p, const std::string new_furniture) {
@@ -1268,7 +1295,7 @@ ter_id map::ter(const int x, const int y) const
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at(x, y, lx, ly);
+    const submap * const current_submap = get_submap_at(x, y, lx, ly);
     return current_submap->get_ter( lx, ly );
 }
 
@@ -1311,6 +1338,7 @@ void map::ter_set(const int x, const int y, const ter_id new_terrain) {
     int lx, ly;
     submap * const current_submap = get_submap_at(x, y, lx, ly);
     current_submap->set_ter( lx, ly, new_terrain );
+    update_pathing_cache( x, y );
 }
 
 std::string map::tername(const int x, const int y) const
@@ -1335,7 +1363,7 @@ ter_id map::ter( const tripoint &p ) const
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
 
     return current_submap->get_ter( lx, ly );
 }
@@ -1406,6 +1434,9 @@ void map::ter_set( const tripoint &p, const ter_id new_terrain) {
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
     current_submap->set_ter( lx, ly, new_terrain );
+    if( p.z == abs_sub.z ) {
+        update_pathing_cache( p.x, p.y );
+    }
 }
 
 std::string map::tername( const tripoint &p ) const
@@ -1467,6 +1498,190 @@ int map::move_cost_internal(const furn_t &furniture, const ter_t &terrain, const
     return std::max( terrain.movecost, 0 );
 }
 
+/** Bash resistance of the furniture, or of the terrain if the furniture has none. */
+static int bash_resistance_internal( const furn_t &furniture, const ter_t &terrain )
+{
+    if( furniture.loadid != f_null && furniture.bash.str_min != -1 ) {
+        return furniture.bash.str_min;
+    }
+    return terrain.bash.str_min != -1 ? terrain.bash.str_min : -1;
+}
+
+void map::update_pathing_cache( const int x, const int y )
+{
+    for( int i = 0; i < 2; i++ ) {
+        if( reachability_cache_dirty[i] ) {
+            continue;
+        }
+        int &label = reachability_cache[i][x][y];
+        if( !reachability_passable( x, y, i == 1 ) ) {
+            if( label >= 0 ) {
+                // Might split a component, that is not worth tracking.
+                reachability_cache_dirty[i] = true;
+            }
+            continue;
+        }
+        if( label >= 0 ) {
+            continue;
+        }
+        // Became passable: join and merge the components around it.
+        int root = -1;
+        for( int nx = x - 1; nx <= x + 1; nx++ ) {
+            for( int ny = y - 1; ny <= y + 1; ny++ ) {
+                if( !INBOUNDS( nx, ny ) || reachability_cache[i][nx][ny] < 0 ) {
+                    continue;
+                }
+                const int other = reachability_root( i, reachability_cache[i][nx][ny] );
+                if( root < 0 ) {
+                    root = other;
+                } else if( other != root ) {
+                    reachability_labels[i][other] = root;
+                }
+            }
+        }
+        if( root < 0 ) {
+            root = reachability_labels[i].size();
+            reachability_labels[i].push_back( root );
+        }
+        label = root;
+    }
+
+    if( pathing_cache_dirty ) {
+        return;
+    }
+    const furn_t &furniture = furn_at( x, y );
+    const ter_t &terrain = ter_at( x, y );
+    const int cost = move_cost_internal( furniture, terrain, nullptr, -1 );
+    move_cost_cache[x][y] = std::min<int>( cost, MOVE_COST_UNCACHED );
+    bash_resistance_cache[x][y] = bash_resistance_internal( furniture, terrain );
+}
+
+void map::build_pathing_cache()
+{
+    if( !pathing_cache_dirty ) {
+        return;
+    }
+
+    // Traverse the submaps in order
+    const map &cmap = *this;
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            const submap *const cur_submap = cmap.get_submap_at_grid( smx, smy );
+            for( int sx = 0; sx < SEEX; ++sx ) {
+                for( int sy = 0; sy < SEEY; ++sy ) {
+                    const int x = sx + smx * SEEX;
+                    const int y = sy + smy * SEEY;
+                    const furn_t &furniture = furnlist[cur_submap->frn[sx][sy]];
+                    const ter_t &terrain = terlist[cur_submap->ter[sx][sy]];
+                    const int cost = move_cost_internal( furniture, terrain, nullptr, -1 );
+                    move_cost_cache[x][y] = std::min<int>( cost, MOVE_COST_UNCACHED );
+                    bash_resistance_cache[x][y] = bash_resistance_internal( furniture, terrain );
+                }
+            }
+        }
+    }
+    pathing_cache_dirty = false;
+}
+
+bool map::reachability_passable( const int x, const int y, const bool bash ) const
+{
+    if( veh_exists_at[x][y] ) {
+        return true;
+    }
+    const furn_t &furniture = furn_at( x, y );
+    const ter_t &terrain = ter_at( x, y );
+    if( move_cost_internal( furniture, terrain, nullptr, -1 ) > 0 || !terrain.open.empty() ) {
+        return true;
+    }
+    // Whether it can be bashed at all, see bash_rating_internal.
+    return bash && ( ( furniture.loadid != f_null && furniture.bash.str_max != -1 ) ||
+                     terrain.bash.str_max != -1 );
+}
+
+int map::reachability_root( const int index, int label ) const
+{
+    std::vector<int> &labels = reachability_labels[index];
+    while( labels[label] != label ) {
+        // Path halving keeps the chains short.
+        labels[label] = labels[labels[label]];
+        label = labels[label];
+    }
+    return label;
+}
+
+void map::build_reachability_cache( const int index ) const
+{
+    auto &cache = reachability_cache[index];
+    const bool bash = index == 1;
+    const int width = SEEX * my_MAPSIZE;
+    const int height = SEEY * my_MAPSIZE;
+    for( int x = 0; x < width; x++ ) {
+        for( int y = 0; y < height; y++ ) {
+            cache[x][y] = reachability_passable( x, y, bash ) ? INT_MAX : -1;
+        }
+    }
+
+    std::vector<int> &labels = reachability_labels[index];
+    labels.clear();
+    std::vector<point> todo;
+    for( int x = 0; x < width; x++ ) {
+        for( int y = 0; y < height; y++ ) {
+            if( cache[x][y] != INT_MAX ) {
+                continue;
+            }
+            const int label = labels.size();
+            labels.push_back( label );
+            cache[x][y] = label;
+            todo.push_back( point( x, y ) );
+            while( !todo.empty() ) {
+                const point p = todo.back();
+                todo.pop_back();
+                for( int nx = std::max( p.x - 1, 0 ); nx <= std::min( p.x + 1, width - 1 ); nx++ ) {
+                    for( int ny = std::max( p.y - 1, 0 ); ny <= std::min( p.y + 1, height - 1 ); ny++ ) {
+                        if( cache[nx][ny] == INT_MAX ) {
+                            cache[nx][ny] = label;
+                            todo.push_back( point( nx, ny ) );
+                        }
+                    }
+                }
+            }
+        }
+    }
+    reachability_cache_dirty[index] = false;
+}
+
+bool map::could_route( const int Fx, const int Fy, const int Tx, const int Ty, const int bash ) const
+{
+    if( !INBOUNDS( Fx, Fy ) || !INBOUNDS( Tx, Ty ) || rl_dist( Fx, Fy, Tx, Ty ) <= 1 ) {
+        return true;
+    }
+    const int index = bash > 0 ? 1 : 0;
+    if( reachability_cache_dirty[index] ) {
+        build_reachability_cache( index );
+    }
+    const auto &cache = reachability_cache[index];
+    // Route does not care whether the start and target can be entered,
+    // only the tiles next to them must connect.
+    std::vector<int> start_components;
+    for( int x = Fx - 1; x <= Fx + 1; x++ ) {
+        for( int y = Fy - 1; y <= Fy + 1; y++ ) {
+            if( INBOUNDS( x, y ) && cache[x][y] >= 0 ) {
+                start_components.push_back( reachability_root( index, cache[x][y] ) );
+            }
+        }
+    }
+    for( int x = Tx - 1; x <= Tx + 1; x++ ) {
+        for( int y = Ty - 1; y <= Ty + 1; y++ ) {
+            if( INBOUNDS( x, y ) && cache[x][y] >= 0 &&
+                std::find( start_components.begin(), start_components.end(),
+                           reachability_root( index, cache[x][y] ) ) != start_components.end() ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 // Move cost: 2D overloads
 
 int map::move_cost(const int x, const int y, const vehicle *ignored_vehicle) const
@@ -1474,6 +1689,9 @@ int map::move_cost(const int x, const int y, const vehicle *ignored_vehicle) con
     if( !INBOUNDS( x, y ) ) {
         return 0;
     }
+    if( !veh_exists_at[x][y] && has_cached_move_cost( x, y ) ) {
+        return move_cost_cache[x][y];
+    }
 
     int part;
     const furn_t &furniture = furn_at( x, y );
@@ -1493,7 +1711,7 @@ int map::move_cost_ter_furn(const int x, const int y) const
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at(x, y, lx, ly);
+    const submap * const current_submap = get_submap_at(x, y, lx, ly);
 
     const int tercost = terlist[ current_submap->get_ter( lx, ly ) ].movecost;
     if ( tercost == 0 ) {
@@ -1527,6 +1745,9 @@ int map::move_cost( const tripoint &p, const vehicle *ignored_vehicle ) const
     if( !inbounds( p ) ) {
         return 0;
     }
+    if( p.z == abs_sub.z && !veh_exists_at[p.x][p.y] && has_cached_move_cost( p.x, p.y ) ) {
+        return move_cost_cache[p.x][p.y];
+    }
 
     int part;
     const furn_t &furniture = furn_at( p );
@@ -1546,7 +1767,7 @@ int map::move_cost_ter_furn( const tripoint &p ) const
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at( p, lx, ly );
+    const submap * const current_submap = get_submap_at( p, lx, ly );
 
     const int tercost = terlist[ current_submap->get_ter( lx, ly ) ].movecost;
     if ( tercost == 0 ) {
@@ -1616,7 +1837,7 @@ bool map::has_flag_ter_or_furn(const std::string & flag, const int x, const int
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at(x, y, lx, ly);
+    const submap * const current_submap = get_submap_at(x, y, lx, ly);
 
     return ( terlist[ current_submap->get_ter( lx, ly ) ].has_flag(flag) || furnlist[ current_submap->get_furn(lx, ly) ].has_flag(flag) );
 }
@@ -1658,7 +1879,7 @@ bool map::has_flag_ter_or_furn(const ter_bitflags flag, const int x, const int y
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at(x, y, lx, ly);
+    const submap * const current_submap = get_submap_at(x, y, lx, ly);
 
     return ( terlist[ current_submap->get_ter( lx, ly ) ].has_flag(flag) || furnlist[ current_submap->get_furn(lx, ly) ].has_flag(flag) );
 }
@@ -1670,7 +1891,7 @@ bool map::has_flag_ter_and_furn(const ter_bitflags flag, const int x, const int
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at( x, y, lx, ly );
+    const submap * const current_submap = get_submap_at( x, y, lx, ly );
 
     return terlist[ current_submap->get_ter( lx, ly ) ].has_flag(flag) && furnlist[ current_submap->get_furn(lx, ly) ].has_flag(flag);
 }
@@ -1715,7 +1936,7 @@ bool map::has_flag_ter_or_furn( const std::string & flag, const tripoint &p ) co
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
 
     return terlist[ current_submap->get_ter( lx, ly ) ].has_flag( flag ) ||
            furnlist[ current_submap->get_furn( lx, ly ) ].has_flag( flag );
@@ -1758,7 +1979,7 @@ bool map::has_flag_ter_or_furn( const ter_bitflags flag, const tripoint &p ) con
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
 
     return terlist[ current_submap->get_ter( lx, ly ) ].has_flag( flag ) ||
            furnlist[ current_submap->get_furn( lx, ly ) ].has_flag( flag );
@@ -1771,7 +1992,7 @@ bool map::has_flag_ter_and_furn( const ter_bitflags flag, const tripoint &p ) co
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
 
     return terlist[ current_submap->get_ter( lx, ly ) ].has_flag( flag ) &&
            furnlist[ current_submap->get_furn( lx, ly ) ].has_flag( flag );
@@ -1878,6 +2099,9 @@ int map::bash_strength(const int x, const int y) const
 
 int map::bash_resistance(const int x, const int y) const
 {
+    if( !pathing_cache_dirty && INBOUNDS( x, y ) ) {
+        return bash_resistance_cache[x][y];
+    }
     if ( has_furn(x, y) && furn_at(x, y).bash.str_min != -1 ) {
         return furn_at(x, y).bash.str_min;
     } else if ( ter_at(x, y).bash.str_min != -1 ) {
@@ -1959,6 +2183,9 @@ int map::bash_strength( const tripoint &p ) const
 
 int map::bash_resistance( const tripoint &p ) const
 {
+    if( !pathing_cache_dirty && p.z == abs_sub.z && inbounds( p ) ) {
+        return bash_resistance_cache[p.x][p.y];
+    }
     if ( has_furn( p ) && furn_at( p ).bash.str_min != -1 ) {
         return furn_at( p ).bash.str_min;
     } else if ( ter_at( p ).bash.str_min != -1 ) {
@@ -2157,14 +2384,16 @@ void map::decay_fields_and_scent( const int amount )
     const int amount_liquid = amount / 3; // Decay washable fields (blood, guts etc.) by this
     const int amount_gas = amount / 5; // Decay gas type fields by this
     // Coord code copied from lightmap calculations
+    const map &cmap = *this;
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
-            auto const cur_submap = get_submap_at_grid( smx, smy );
-            int to_proc = cur_submap->field_count;
-            if( to_proc < 1 ) {
+            if( cmap.get_submap_at_grid( smx, smy )->field_count < 1 ) {
                 // This submap has no fields
                 continue;
             }
+            auto const cur_submap = get_submap_at_grid( smx, smy );
+            cur_submap->dirty = true;
+            int to_proc = cur_submap->field_count;
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -2689,10 +2918,10 @@ void map::spawn_item_list(const std::vector<map_bash_item_drop> &items, int x, i
                 const bool varsize = new_item.has_flag( "VARSIZE" );
                 for(int a = 0; a < numitems; a++ ) {
                     if( varsize && one_in( 3 ) ) {
-                        new_item.item_tags.insert( "FIT" );
+                        new_item.set_flag( "FIT" );
                     } else if( varsize ) {
                         // might have been added previously
-                        new_item.item_tags.erase( "FIT" );
+                        new_item.unset_flag( "FIT" );
                     }
                     add_item_or_charges(x, y, new_item);
                 }
@@ -3098,13 +3327,215 @@ bool map::marlossify(const int x, const int y)
         return true;
     }
     for (int i = 0; i < 25; i++) {
-        if(!g->spread_fungus(x, y)) {
+        if(!spread_fungus(x, y)) {
             return true;
         }
     }
     return false;
 }
 
+bool map::spread_fungus(const int x, const int y)
+{
+    int growth = 1;
+    for (int i = x - 1; i <= x + 1; i++) {
+        for (int j = y - 1; j <= y + 1; j++) {
+            if (i == x && j == y) {
+                continue;
+            }
+            if (has_flag("FUNGUS", i, j)) {
+                growth += 1;
+            }
+        }
+    }
+
+    bool converted = false;
+    if (!has_flag_ter("FUNGUS", x, y)) {
+        // Terrain conversion
+        if (has_flag_ter("DIGGABLE", x, y)) {
+            if (x_in_y(growth * 10, 100)) {
+                ter_set(x, y, t_fungus);
+                converted = true;
+            }
+        } else if (has_flag("FLAT", x, y)) {
+            if (has_flag("INDOORS", x, y)) {
+                if (x_in_y(growth * 10, 500)) {
+                    ter_set(x, y, t_fungus_floor_in);
+                    converted = true;
+                }
+            } else if (has_flag("SUPPORTS_ROOF", x, y)) {
+                if (x_in_y(growth * 10, 1000)) {
+                    ter_set(x, y, t_fungus_floor_sup);
+                    converted = true;
+                }
+            } else {
+                if (x_in_y(growth * 10, 2500)) {
+                    ter_set(x, y, t_fungus_floor_out);
+                    converted = true;
+                }
+            }
+        } else if (has_flag("SHRUB", x, y)) {
+            if (x_in_y(growth * 10, 200)) {
+                ter_set(x, y, t_shrub_fungal);
+                converted = true;
+            } else if (x_in_y(growth, 1000)) {
+                ter_set(x, y, t_marloss);
+                converted = true;
+            }
+        } else if (has_flag("THIN_OBSTACLE", x, y)) {
+            if (x_in_y(growth * 10, 150)) {
+                ter_set(x, y, t_fungus_mound);
+                converted = true;
+            }
+        } else if (has_flag("YOUNG", x, y)) {
+            if (x_in_y(growth * 10, 500)) {
+                ter_set(x, y, t_tree_fungal_young);
+                converted = true;
+            }
+        } else if (has_flag("WALL", x, y)) {
+            if (x_in_y(growth * 10, 5000)) {
+                converted = true;
+                if (ter_at(x, y).sym == LINE_OXOX) {
+                    ter_set(x, y, t_fungus_wall_h);
+                } else if (ter_at(x, y).sym == LINE_XOXO) {
+                    ter_set(x, y, t_fungus_wall_v);
+                } else {
+                    ter_set(x, y, t_fungus_wall);
+                }
+            }
+        }
+        // Furniture conversion
+        if (converted) {
+            if (has_flag("FLOWER", x, y)) {
+                furn_set(x, y, f_flower_fungal);
+            } else if (has_flag("ORGANIC", x, y)) {
+                if (furn_at(x, y).movecost == -10) {
+                    furn_set(x, y, f_fungal_mass);
+                } else {
+                    furn_set(x, y, f_fungal_clump);
+                }
+            } else if (has_flag("PLANT", x, y)) {
+                for (size_t k = 0; k < i_at(x, y).size(); k++) {
+                    i_rem(x, y, k);
+                }
+                item seeds("fungal_seeds", int(calendar::turn));
+                add_item_or_charges(x, y, seeds);
+            }
+        }
+        return true;
+    } else {
+        // Everything is already fungus
+        if (growth == 9) {
+            return false;
+        }
+        for (int i = x - 1; i <= x + 1; i++) {
+            for (int j = y - 1; j <= y + 1; j++) {
+                // One spread on average
+                if (!has_flag("FUNGUS", i, j) && one_in(9 - growth)) {
+                    //growth chance is 100 in X simplified
+                    if (has_flag("DIGGABLE", i, j)) {
+                        ter_set(i, j, t_fungus);
+                        converted = true;
+                    } else if (has_flag("FLAT", i, j)) {
+                        if (has_flag("INDOORS", i, j)) {
+                            if (one_in(5)) {
+                                ter_set(i, j, t_fungus_floor_in);
+                                converted = true;
+                            }
+                        } else if (has_flag("SUPPORTS_ROOF", i, j)) {
+                            if (one_in(10)) {
+                                ter_set(i, j, t_fungus_floor_sup);
+                                converted = true;
+                            }
+                        } else {
+                            if (one_in(25)) {
+                                ter_set(i, j, t_fungus_floor_out);
+                                converted = true;
+                            }
+                        }
+                    } else if (has_flag("SHRUB", i, j)) {
+                        if (one_in(2)) {
+                            ter_set(i, j, t_shrub_fungal);
+                            converted = true;
+                        } else if (one_in(25)) {
+                            ter_set(i, j, t_marloss);
+                            converted = true;
+                        }
+                    } else if (has_flag("THIN_OBSTACLE", i, j)) {
+                        if (x_in_y(10, 15)) {
+                            ter_set(i, j, t_fungus_mound);
+                            converted = true;
+                        }
+                    } else if (has_flag("YOUNG", i, j)) {
+                        if (one_in(5)) {
+                            if (get_field_strength( tripoint(x, y, abs_sub.z), fd_fungal_haze) != 0) {
+                                if (one_in(3)) { // young trees are Vulnerable
+                                    ter_set(i, j, t_fungus);
+                                    add_spawn("mon_fungal_blossom", 1, x, y);
+                                    if (this == &g->m && g->u.sees(x, y)) {
+                                    add_msg(m_warning, _("The young tree blooms forth into a fungal blossom!"));
+                                    }
+                                } else if (one_in(2)) {
+                                    ter_set(i, j, t_marloss_tree);
+                                }
+                            } else {
+                                ter_set(i, j, t_tree_fungal_young);
+                            }
+                            converted = true;
+                        }
+                    } else if (has_flag("TREE", i, j)) {
+                        if (one_in(10)) {
+                            if (get_field_strength( tripoint(x, y, abs_sub.z), fd_fungal_haze) != 0) {
+                                if (one_in(4)) {
+                                    ter_set(i, j, t_fungus);
+                                    add_spawn("mon_fungal_blossom", 1, x, y);
+                                    if (this == &g->m && g->u.sees(x, y)) {
+                                    add_msg(m_warning, _("The tree blooms forth into a fungal blossom!"));
+                                    }
+                                } else if (one_in(3)) {
+                                    ter_set(i, j, t_marloss_tree);
+                                }
+                            } else {
+                                ter_set(i, j, t_tree_fungal);
+                            }
+                            converted = true;
+                        }
+                    } else if (has_flag("WALL", i, j)) {
+                        if (one_in(50)) {
+                            converted = true;
+                            if (ter_at(i, j).sym == LINE_OXOX) {
+                                ter_set(i, j, t_fungus_wall_h);
+                            } else if (ter_at(i, j).sym == LINE_XOXO) {
+                                ter_set(i, j, t_fungus_wall_v);
+                            } else {
+                                ter_set(i, j, t_fungus_wall);
+                            }
+                        }
+                    }
+
+                    if (converted) {
+                        if (has_flag("FLOWER", i, j)) {
+                            furn_set(i, j, f_flower_fungal);
+                        } else if (has_flag("ORGANIC", i, j)) {
+                            if (furn_at(i, j).movecost == -10) {
+                                furn_set(i, j, f_fungal_mass);
+                            } else {
+                                furn_set(i, j, f_fungal_clump);
+                            }
+                        } else if (has_flag("PLANT", i, j)) {
+                            for (size_t k = 0; k < i_at(i, j).size(); k++) {
+                                i_rem(i, j, k);
+                            }
+                            item seeds("fungal_seeds", int(calendar::turn));
+                            add_item_or_charges(x, y, seeds);
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+}
+
 bool map::open_door(const int x, const int y, const bool inside, const bool check_only)
 {
     const auto &ter = ter_at( x, y );
@@ -3231,11 +3662,11 @@ const std::string map::get_signage(const int x, const int y) const
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at(x, y, lx, ly);
+    const submap * const current_submap = get_submap_at(x, y, lx, ly);
 
     return current_submap->get_signage(lx, ly);
 }
-void map::set_signage(const int x, const int y, std::string message) const
+void map::set_signage(const int x, const int y, std::string message)
 {
     if (!INBOUNDS(x, y)) {
         return;
@@ -3246,7 +3677,7 @@ void map::set_signage(const int x, const int y, std::string message) const
 
     current_submap->set_signage(lx, ly, message);
 }
-void map::delete_signage(const int x, const int y) const
+void map::delete_signage(const int x, const int y)
 {
     if (!INBOUNDS(x, y)) {
         return;
@@ -3265,7 +3696,7 @@ int map::get_radiation( const tripoint &p ) const
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
 
     return current_submap->get_radiation( lx, ly );
 }
@@ -3312,7 +3743,9 @@ int& map::temperature( const tripoint &p )
         return null_temperature;
     }
 
-    return get_submap_at( p )->temperature;
+    submap *const current_submap = get_submap_at( p );
+    current_submap->dirty = true;
+    return current_submap->temperature;
 }
 
 void map::set_temperature( const tripoint &p, int new_temperature )
@@ -3335,8 +3768,21 @@ map_stack map::i_at( const int x, const int y )
         return map_stack{ &nulitems, point(x, y), this };
     }
 
+    const map &cmap = *this;
+    if( is_shared( cmap.get_submap_at( x, y ) ) ) {
+        // A shared submap has no items, modifying the stack goes through
+        // add_item/i_rem, which unshare it.
+        nulitems.clear();
+        return map_stack{ &nulitems, point(x, y), this };
+    }
+
     int lx, ly;
     submap *const current_submap = get_submap_at( x, y, lx, ly );
+    if( !current_submap->itm[lx][ly].empty() ) {
+        // The items may be changed in place. Adding or removing them goes
+        // through add_item/i_rem, which set the flag anyway.
+        current_submap->dirty = true;
+    }
 
     return map_stack{ &current_submap->itm[lx][ly], point(x, y), this };
 }
@@ -3347,6 +3793,36 @@ bool map::sees_some_items(int x, int y, const player &u)
     return !i_at( x, y ).empty() && could_see_items( x, y, u );
 }
 
+std::vector<point> map::points_with_items( const int x1, const int y1, const int x2, const int y2 ) const
+{
+    std::vector<point> ret;
+    const int minx = std::max( x1, 0 );
+    const int miny = std::max( y1, 0 );
+    const int maxx = std::min( x2, SEEX * my_MAPSIZE - 1 );
+    const int maxy = std::min( y2, SEEY * my_MAPSIZE - 1 );
+    for( int smx = minx / SEEX; smx <= maxx / SEEX; smx++ ) {
+        for( int smy = miny / SEEY; smy <= maxy / SEEY; smy++ ) {
+            const submap *const current_submap = get_submap_at_grid( smx, smy );
+            if( current_submap->item_tiles.none() ) {
+                continue;
+            }
+            const int lx1 = std::max( minx - smx * SEEX, 0 );
+            const int ly1 = std::max( miny - smy * SEEY, 0 );
+            const int lx2 = std::min( maxx - smx * SEEX, SEEX - 1 );
+            const int ly2 = std::min( maxy - smy * SEEY, SEEY - 1 );
+            for( int lx = lx1; lx <= lx2; lx++ ) {
+                for( int ly = ly1; ly <= ly2; ly++ ) {
+                    if( current_submap->has_items( lx, ly ) ) {
+                        ret.push_back( point( smx * SEEX + lx, smy * SEEY + ly ) );
+                    }
+                }
+            }
+        }
+    }
+    std::sort( ret.begin(), ret.end() );
+    return ret;
+}
+
 bool map::could_see_items(int x, int y, const player &u) const
 {
     const bool container = has_flag_ter_or_furn("CONTAINER", x, y);
@@ -3399,7 +3875,9 @@ std::list<item>::iterator map::i_rem( const point location, std::list<item>::ite
 
     current_submap->update_lum_rem(*it, lx, ly);
 
-    return current_submap->itm[lx][ly].erase( it );
+    const auto next = current_submap->itm[lx][ly].erase( it );
+    current_submap->update_item_tile( lx, ly );
+    return next;
 }
 
 int map::i_rem(const int x, const int y, const int index)
@@ -3446,6 +3924,8 @@ void map::i_clear(const int x, const int y)
 
     current_submap->lum[lx][ly] = 0;
     current_submap->itm[lx][ly].clear();
+    current_submap->dirty = true;
+    current_submap->update_item_tile( lx, ly );
 }
 
 void map::spawn_an_item(const int x, const int y, item new_item,
@@ -3522,7 +4002,7 @@ void map::spawn_item(const int x, const int y, const std::string &type_id,
     // spawn the item
     item new_item(type_id, birthday, rand);
     if( one_in( 3 ) && new_item.has_flag( "VARSIZE" ) ) {
-        new_item.item_tags.insert( "FIT" );
+        new_item.set_flag( "FIT" );
     }
     spawn_an_item(x, y, new_item, charges, damlevel);
 }
@@ -3658,10 +4138,12 @@ void map::add_item_at( const int x, const int y,
     int lx, ly;
     submap * const current_submap = get_submap_at(x, y, lx, ly);
     current_submap->is_uniform = false;
+    current_submap->dirty = true;
 
     current_submap->update_lum_add(new_item, lx, ly);
 
     const auto new_pos = current_submap->itm[lx][ly].insert( index, new_item );
+    current_submap->update_item_tile( lx, ly );
     if( new_item.needs_processing() ) {
         current_submap->active_items.add( new_pos, point(lx, ly) );
     }
@@ -3679,7 +4161,7 @@ static void apply_in_fridge(item &it)
         }
         // This sets the COLD flag, and doesn't go above 600
         if ((it.has_flag("EATEN_COLD")) && (!it.has_flag("COLD"))) {
-            it.item_tags.insert("COLD");
+            it.set_flag("COLD");
             it.active = true;
         }
         if ((it.has_flag("COLD")) && (it.item_counter <= 590) && it.fridge > 0) {
@@ -3694,13 +4176,14 @@ static void apply_in_fridge(item &it)
 }
 
 template <typename Iterator>
-static bool process_item( item_stack &items, Iterator &n, point location, bool activate )
+static bool process_item( item_stack &items, Iterator &n, point location, bool activate,
+                          int turns = 1 )
 {
     // make a temporary copy, remove the item (in advance)
     // and use that copy to process it
     item temp_item = *n;
     auto insertion_point = items.erase( n );
-    if( !temp_item.process( nullptr, location, activate ) ) {
+    if( !temp_item.process( nullptr, location, activate, turns ) ) {
         // Not destroyed, must be inserted again.
         // If the item lost its active flag in processing,
         // it won't be re-added to the active list, tidy!
@@ -3714,11 +4197,6 @@ static bool process_item( item_stack &items, Iterator &n, point location, bool a
     return true;
 }
 
-static bool process_map_items( item_stack &items, std::list<item>::iterator &n, point location,
-                               std::string )
-{
-    return process_item( items, n, location, false );
-}
 
 static void process_vehicle_items( vehicle *cur_veh, int part )
 {
@@ -3746,22 +4224,44 @@ static void process_vehicle_items( vehicle *cur_veh, int part )
     }
 }
 
-void map::process_active_items()
+void map::process_active_items( const int batch_turns )
 {
+    // Batched items wait until batch_turns turns have passed, then they are
+    // processed for all of them. The count carries over when batching stops.
+    const bool process_batched = ++items_batch_turns >= batch_turns;
+    const int turns = items_batch_turns;
+    if( process_batched ) {
+        items_batch_turns = 0;
+    }
+    const auto process_map_items = [process_batched, turns]( item_stack &items,
+                                   std::list<item>::iterator &n, point location, std::string ) {
+        // Items with a lower processing speed are spread over the turns by the
+        // active item cache already.
+        if( n->processing_speed() > 1 || !n->can_process_in_batches() ) {
+            return process_item( items, n, location, false );
+        }
+        return process_batched && process_item( items, n, location, false, turns );
+    };
     process_items( true, process_map_items, std::string {} );
 }
 
 template<typename T>
 void map::process_items( bool const active, T processor, std::string const &signal )
 {
+    const map &cmap = *this;
     for( int gx = 0; gx < my_MAPSIZE; ++gx ) {
         for( int gy = 0; gy < my_MAPSIZE; ++gy ) {
+            if( is_shared( cmap.get_submap_at_grid( gx, gy ) ) ) {
+                // No vehicles and no items
+                continue;
+            }
             submap *const current_submap = get_submap_at_grid(gx, gy);
             // Vehicles first in case they get blown up and drop active items on the map.
             if( !current_submap->vehicles.empty() ) {
                 process_items_in_vehicles(current_submap, processor, signal);
             }
             if( !active || !current_submap->active_items.empty() ) {
+                current_submap->dirty = true;
                 process_items_in_submap(current_submap, gx, gy, processor, signal);
             }
         }
@@ -4233,7 +4733,7 @@ const trap &map::tr_at( const tripoint &p ) const
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at( p, lx, ly );
+    const submap * const current_submap = get_submap_at( p, lx, ly );
 
     if (terlist[ current_submap->get_ter( lx, ly ) ].trap != tr_null) {
         return *traplist[terlist[ current_submap->get_ter( lx, ly ) ].trap];
@@ -4358,7 +4858,7 @@ const field &map::field_at( const tripoint &p ) const
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
 
     return current_submap->fld[lx][ly];
 }
@@ -4375,6 +4875,10 @@ field &map::field_at( const tripoint &p )
 
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
+    if( current_submap->fld[lx][ly].fieldCount() > 0 ) {
+        // The fields may be changed in place, adding them goes through add_field.
+        current_submap->dirty = true;
+    }
 
     return current_submap->fld[lx][ly];
 }
@@ -4444,7 +4948,11 @@ field_entry *map::get_field( const tripoint &p, const field_id t ) {
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
 
-    return current_submap->fld[lx][ly].findField( t );
+    field_entry *const entry = current_submap->fld[lx][ly].findField( t );
+    if( entry != nullptr ) {
+        current_submap->dirty = true;
+    }
+    return entry;
 }
 
 bool map::add_field(const tripoint &p, const field_id t, int density, const int age)
@@ -4464,11 +4972,16 @@ bool map::add_field(const tripoint &p, const field_id t, int density, const int
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
     current_submap->is_uniform = false;
+    current_submap->dirty = true;
 
     if( current_submap->fld[lx][ly].addField( t, density, age ) ) {
         // TODO: Update overall field_count appropriately.
         // This is the spirit of "fd_null" that it used to be.
         current_submap->field_count++; //Only adding it to the count if it doesn't exist.
+        current_submap->update_field_tile( lx, ly );
+    }
+    if( fieldlist[t].is_opaque() ) {
+        set_transparency_cache_dirty();
     }
 
     if( g != nullptr && this == &g->m && p == g->u.pos3() ) {
@@ -4489,9 +5002,14 @@ void map::remove_field( const tripoint &p, const field_id field_to_remove )
 
     if( current_submap->fld[lx][ly].findField( field_to_remove ) ) { //same as checking for fd_null in the old system
         current_submap->field_count--;
+        current_submap->dirty = true;
+        if( fieldlist[field_to_remove].is_opaque() ) {
+            set_transparency_cache_dirty();
+        }
     }
 
     current_submap->fld[lx][ly].removeField(field_to_remove);
+    current_submap->update_field_tile( lx, ly );
 }
 
 computer* map::computer_at( const tripoint &p )
@@ -4506,6 +5024,7 @@ computer* map::computer_at( const tripoint &p )
         return nullptr;
     }
 
+    current_submap->dirty = true;
     return &(current_submap->comp);
 }
 
@@ -4531,6 +5050,7 @@ basecamp* map::camp_at( const tripoint &p, const int radius)
             submap * const current_submap = get_submap_at( p );
             if( current_submap->camp.is_valid() ) {
                 // we only allow on camp per size radius, kinda
+                current_submap->dirty = true;
                 return &(current_submap->camp);
             }
         }
@@ -4546,7 +5066,9 @@ void map::add_camp( const tripoint &p, const std::string& name )
         return;
     }
 
-    get_submap_at( p )->camp = basecamp( name, p.x, p.y );
+    submap *const current_submap = get_submap_at( p );
+    current_submap->camp = basecamp( name, p.x, p.y );
+    current_submap->dirty = true;
 }
 
 void map::debug()
@@ -5019,6 +5541,10 @@ std::vector<point> map::route(const int Fx, const int Fy, const int Tx, const in
     if( clear_path( Fx, Fy, Tx, Ty, -1, 2, 2, linet ) ) {
         return line_to(Fx, Fy, Tx, Ty, linet);
     }
+    // Don't exhaust the whole search area if the target can't be reached anyway.
+    if( !could_route( Fx, Fy, Tx, Ty, bash ) ) {
+        return std::vector<point>();
+    }
     /*
     if (move_cost(Tx, Ty) == 0) {
         debugmsg("%d:%d wanted to move to %d:%d, a %s!", Fx, Fy, Tx, Ty,
@@ -5102,22 +5628,23 @@ std::vector<point> map::route(const int Fx, const int Fy, const int Tx, const in
                 }
 
                 int part = -1;
-                const furn_t &furniture = furn_at( x, y );
-                const ter_t &terrain = ter_at( x, y );
                 const vehicle *veh = veh_at_internal( x, y, part );
 
-                const int cost = move_cost_internal( furniture, terrain, veh, part );
+                const int cost = ( veh == nullptr && has_cached_move_cost( x, y ) ) ?
+                                 move_cost_cache[x][y] :
+                                 move_cost_internal( furn_at( x, y ), ter_at( x, y ), veh, part );
                 // Don't calculate bash rating unless we intend to actually use it
                 const int rating = ( bash == 0 || cost != 0 ) ? -1 :
-                                     bash_rating_internal( bash, furniture, terrain, veh, part );
+                                     bash_rating_internal( bash, furn_at( x, y ), ter_at( x, y ), veh, part );
 
-                if( cost == 0 && rating <= 0 && terrain.open.empty() ) {
+                if( cost == 0 && rating <= 0 && ter_at( x, y ).open.empty() ) {
                     list[x][y] = ASL_CLOSED; // Close it so that next time we won't try to calc costs
                     continue;
                 }
 
                 int newg = gscore[cur.x][cur.y] + cost + ((cur.x - x != 0 && cur.y - y != 0) ? 1 : 0);
                 if( cost == 0 ) {
+                    const ter_t &terrain = ter_at( x, y );
                     // Handle all kinds of doors
                     // Only try to open INSIDE doors from the inside
 
@@ -5213,6 +5740,10 @@ void map::load(const int wx, const int wy, const int wz, const bool update_vehic
         traps.clear();
     }
     set_abs_sub( wx, wy, wz );
+    generate_missing_submaps();
+    // All submaps are looked up again below.
+    shared_generation = MAPBUFFER.get_shared_generation();
+    unshared_seen = MAPBUFFER.get_unshared_positions().size();
     for (int gridx = 0; gridx < my_MAPSIZE; gridx++) {
         for (int gridy = 0; gridy < my_MAPSIZE; gridy++) {
             loadn( gridx, gridy, update_vehicle );
@@ -5220,6 +5751,23 @@ void map::load(const int wx, const int wy, const int wz, const bool update_vehic
     }
 }
 
+void map::generate_missing_submaps()
+{
+    std::vector<tripoint> positions;
+    for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
+        for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
+            const int absx = abs_sub.x + gridx;
+            const int absy = abs_sub.y + gridy;
+            if( MAPBUFFER.lookup_submap( absx, absy, abs_sub.z ) == nullptr ) {
+                // Same as in loadn: tiles are generated from their top-left submap.
+                positions.push_back( tripoint( absx - ( abs( absx ) % 2 ), absy - ( abs( absy ) % 2 ),
+                                               abs_sub.z ) );
+            }
+        }
+    }
+    generate_overmap_tiles( positions, calendar::turn );
+}
+
 void map::shift_traps( const tripoint &shift )
 {
     const tripoint offset( shift.x * SEEX, shift.y * SEEY, shift.z );
@@ -5245,11 +5793,14 @@ void map::shift( const int sx, const int sy )
     if( sx == 0 && sy == 0 ) {
         return; // Skip this?
     }
+    // Looking the submaps up by position only works before the grid is moved.
+    update_shared_submaps();
     const int absx = get_abs_sub().x;
     const int absy = get_abs_sub().y;
     const int wz = get_abs_sub().z;
 
     set_abs_sub( absx + sx, absy + sy, wz );
+    generate_missing_submaps();
 
 // if player is in vehicle, (s)he must be shifted with vehicle too
     if( g->u.in_vehicle ) {
@@ -5338,6 +5889,7 @@ void map::vertical_shift( const int newz )
     clear_vehicle_cache();
     vehicle_list.clear();
     set_transparency_cache_dirty();
+    set_pathing_cache_dirty();
     set_outside_cache_dirty();
 
     // Forgetting done, now get the new z-level
@@ -5367,7 +5919,8 @@ void map::saven( const int gridx, const int gridy, const int gridz )
     dbg( D_INFO ) << "map::saven(worldx[" << abs_sub.x << "], worldy[" << abs_sub.y << "], worldz[" << abs_sub.z
                   << "], gridx[" << gridx << "], gridy[" << gridy << "], gridz[" << gridz << "])";
     const int gridn = get_nonant( gridx, gridy, gridz );
-    submap *submap_to_save = getsubmap( gridn );
+    // Don't use getsubmap, saving must not unshare a shared submap.
+    submap *submap_to_save = grid[gridn];
     if( submap_to_save == nullptr || submap_to_save->get_ter( 0, 0 ) == t_null ) {
         // This is a serious error and should be signaled as soon as possible
         debugmsg( "map::saven grid (%d,%d,%d) %s!", gridx, gridy, gridz,
@@ -5386,8 +5939,13 @@ void map::saven( const int gridx, const int gridy, const int gridz )
 #endif
     dbg( D_INFO ) << "map::saven abs_x: " << abs_x << "  abs_y: " << abs_y << "  abs_z: " << abs_z
                   << "  gridn: " << gridn;
-    submap_to_save->turn_last_touched = int(calendar::turn);
-    MAPBUFFER.add_submap( abs_x, abs_y, abs_z, submap_to_save );
+    if( !MAPBUFFER.is_shared( submap_to_save ) ) {
+        submap_to_save->turn_last_touched = int(calendar::turn);
+    }
+    if( MAPBUFFER.add_submap( abs_x, abs_y, abs_z, submap_to_save ) ) {
+        // A uniform submap may have been replaced with its shared template.
+        setsubmap( gridn, MAPBUFFER.lookup_submap( abs_x, abs_y, abs_z ) );
+    }
 }
 
 // worldx & worldy specify where in the world this is;
@@ -5448,6 +6006,7 @@ void map::loadn( const int gridx, const int gridy, const int gridz, const bool u
 
     // New submap changes the content of the map and all caches must be recalculated
     set_transparency_cache_dirty();
+    set_pathing_cache_dirty();
     set_outside_cache_dirty();
     setsubmap( gridn, tmpsub );
 
@@ -5588,6 +6147,11 @@ void map::restock_fruits( const point pnt, int time_since_last_actualize )
 
 void map::actualize( const int gridx, const int gridy, const int gridz )
 {
+    const map &cmap = *this;
+    if( is_shared( cmap.get_submap_at_grid( gridx, gridy, gridz ) ) ) {
+        // Nothing in there that could rot, grow or fill up.
+        return;
+    }
     submap *const tmpsub = get_submap_at_grid( gridx, gridy, gridz );
     if( tmpsub == nullptr ) {
         debugmsg( "Actualize called on null submap (%d,%d,%d)", gridx, gridy, gridz );
@@ -5645,7 +6209,8 @@ void map::copy_grid( const point to, const point from )
     int z = abs_sub.z;
     {
 #endif
-        const auto smap = get_submap_at_grid( from.x, from.y, z );
+        // Moving a shared submap around doesn't modify it, so don't unshare it here.
+        submap *const smap = grid[get_nonant( from.x, from.y, z )];
         setsubmap( get_nonant( to.x, to.y, z ), smap );
         for( auto &it : smap->vehicles ) {
             it->smx = to.x;
@@ -5722,6 +6287,7 @@ void map::spawn_monsters( int gx, int gy, mongroup &group, bool ignore_sight )
 
 void map::spawn_monsters(bool ignore_sight)
 {
+    const map &cmap = *this;
     for (int gx = 0; gx < my_MAPSIZE; gx++) {
         for (int gy = 0; gy < my_MAPSIZE; gy++) {
             auto groups = overmap_buffer.groups_at( abs_sub.x + gx, abs_sub.y + gy, abs_sub.z );
@@ -5729,6 +6295,10 @@ void map::spawn_monsters(bool ignore_sight)
                 spawn_monsters( gx, gy, *mgp, ignore_sight );
             }
 
+            if( cmap.get_submap_at_grid( gx, gy )->spawns.empty() ) {
+                overmap_buffer.spawn_monster( abs_sub.x + gx, abs_sub.y + gy, abs_sub.z );
+                continue;
+            }
             submap * const current_submap = get_submap_at_grid(gx, gy);
             for (auto &i : current_submap->spawns) {
                 for (int j = 0; j < i.count; j++) {
@@ -5764,6 +6334,7 @@ void map::spawn_monsters(bool ignore_sight)
                 }
             }
             current_submap->spawns.clear();
+            current_submap->dirty = true;
             overmap_buffer.spawn_monster( abs_sub.x + gx, abs_sub.y + gy, abs_sub.z );
         }
     }
@@ -5772,13 +6343,19 @@ void map::spawn_monsters(bool ignore_sight)
 void map::clear_spawns()
 {
     for( auto & smap : grid ) {
-        smap->spawns.clear();
+        if( !is_shared( smap ) && !smap->spawns.empty() ) {
+            smap->spawns.clear();
+            smap->dirty = true;
+        }
     }
 }
 
 void map::clear_traps()
 {
     for( auto & smap : grid ) {
+        if( is_shared( smap ) ) {
+            continue;
+        }
         for (int x = 0; x < SEEX; x++) {
             for (int y = 0; y < SEEY; y++) {
                 smap->set_trap(x, y, tr_null);
@@ -5848,7 +6425,7 @@ const std::string &map::graffiti_at( const tripoint &p ) const
         return empty_string;
     }
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
     return current_submap->get_graffiti( lx, ly );
 }
 
@@ -5858,7 +6435,7 @@ bool map::has_graffiti_at( const tripoint &p ) const
         return false;
     }
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
     return current_submap->has_graffiti( lx, ly );
 }
 
@@ -5968,12 +6545,14 @@ void map::build_outside_cache()
     outside_cache_dirty = false;
 }
 
-void map::build_map_cache()
+void map::build_map_cache( const bool rebuild_lightmap )
 {
     build_outside_cache();
 
     build_transparency_cache();
 
+    build_pathing_cache();
+
     // Cache all the vehicle stuff in one loop
     VehicleList vehs = get_vehicles();
     for(auto &v : vehs) {
@@ -5995,7 +6574,9 @@ void map::build_map_cache()
     }
 
     build_seen_cache();
-    generate_lightmap();
+    if( rebuild_lightmap ) {
+        generate_lightmap();
+    }
 }
 
 std::vector<point> closest_points_first(int radius, point p)
@@ -6063,12 +6644,91 @@ tripoint map::get_abs_sub() const
    return abs_sub;
 }
 
-submap *map::getsubmap( const size_t grididx ) const
+submap *map::getsubmap( const size_t grididx )
 {
     if( grididx >= grid.size() ) {
         debugmsg( "Tried to access invalid grid index %d. Grid size: %d", grididx, grid.size() );
         return nullptr;
     }
+    update_shared_submaps();
+    submap *&sm = grid[grididx];
+    if( sm->is_uniform && is_shared( sm ) ) {
+        const tripoint p = grid_abs_sub( grididx );
+        submap *const copy = MAPBUFFER.unshare_submap( p );
+        if( copy == nullptr ) {
+            debugmsg( "Shared submap (%d,%d,%d) is not in the mapbuffer", p.x, p.y, p.z );
+        } else {
+            sm = copy;
+        }
+    }
+    return sm;
+}
+
+bool map::is_shared( const submap *const sm ) const
+{
+    return !generating_private && MAPBUFFER.is_shared( sm );
+}
+
+tripoint map::grid_abs_sub( const size_t grididx ) const
+{
+#ifdef ZLEVELS
+    const int gridz = int( grididx % OVERMAP_LAYERS ) - OVERMAP_HEIGHT;
+    const int gridxy = grididx / OVERMAP_LAYERS;
+#else
+    const int gridz = abs_sub.z;
+    const int gridxy = grididx;
+#endif
+    return tripoint( abs_sub.x + gridxy % my_MAPSIZE, abs_sub.y + gridxy / my_MAPSIZE, gridz );
+}
+
+void map::update_shared_submaps() const
+{
+    if( generating_private ) {
+        return;
+    }
+    const auto &unshared = MAPBUFFER.get_unshared_positions();
+    if( shared_generation != MAPBUFFER.get_shared_generation() ) {
+        shared_generation = MAPBUFFER.get_shared_generation();
+        unshared_seen = unshared.size();
+        for( size_t i = 0; i < grid.size(); i++ ) {
+            // Only by position, the old pointer may belong to a deleted template.
+            submap *const sm = MAPBUFFER.find_submap( grid_abs_sub( i ) );
+            if( sm != nullptr ) {
+                grid[i] = sm;
+            }
+        }
+        return;
+    }
+    for( ; unshared_seen < unshared.size(); unshared_seen++ ) {
+        const tripoint &p = unshared[unshared_seen];
+        const int gridx = p.x - abs_sub.x;
+        const int gridy = p.y - abs_sub.y;
+        if( gridx < 0 || gridx >= my_MAPSIZE || gridy < 0 || gridy >= my_MAPSIZE ) {
+            continue;
+        }
+#ifdef ZLEVELS
+        if( p.z < -OVERMAP_DEPTH || p.z > OVERMAP_HEIGHT ) {
+            continue;
+        }
+#else
+        if( p.z != abs_sub.z ) {
+            continue;
+        }
+#endif
+        submap *const sm = MAPBUFFER.find_submap( p );
+        if( sm != nullptr ) {
+            grid[get_nonant( gridx, gridy, p.z )] = sm;
+        }
+    }
+}
+
+const submap *map::getsubmap( const size_t grididx ) const
+{
+    if( grididx >= grid.size() ) {
+        debugmsg( "Tried to access invalid grid index %d. Grid size: %d", grididx, grid.size() );
+        return nullptr;
+    }
+    update_shared_submaps();
     return grid[grididx];
 }
 
@@ -6084,7 +6744,16 @@ void map::setsubmap( const size_t grididx, submap * const smap )
     grid[grididx] = smap;
 }
 
-submap *map::get_submap_at( const int x, const int y, const int z ) const
+submap *map::get_submap_at( const int x, const int y, const int z )
+{
+    if( !inbounds( x, y, z ) ) {
+        debugmsg( "Tried to access invalid map position (%d,%d, %d)", x, y, z );
+        return nullptr;
+    }
+    return get_submap_at_grid( x / SEEX, y / SEEY, z );
+}
+
+const submap *map::get_submap_at( const int x, const int y, const int z ) const
 {
     if( !inbounds( x, y, z ) ) {
         debugmsg( "Tried to access invalid map position (%d,%d, %d)", x, y, z );
@@ -6093,7 +6762,16 @@ submap *map::get_submap_at( const int x, const int y, const int z ) const
     return get_submap_at_grid( x / SEEX, y / SEEY, z );
 }
 
-submap *map::get_submap_at( const tripoint &p ) const
+submap *map::get_submap_at( const tripoint &p )
+{
+    if( !inbounds( p ) ) {
+        debugmsg( "Tried to access invalid map position (%d,%d, %d)", p.x, p.y, p.z );
+        return nullptr;
+    }
+    return get_submap_at_grid( p.x / SEEX, p.y / SEEY, p.z );
+}
+
+const submap *map::get_submap_at( const tripoint &p ) const
 {
     if( !inbounds( p ) ) {
         debugmsg( "Tried to access invalid map position (%d,%d, %d)", p.x, p.y, p.z );
@@ -6102,36 +6780,70 @@ submap *map::get_submap_at( const tripoint &p ) const
     return get_submap_at_grid( p.x / SEEX, p.y / SEEY, p.z );
 }
 
-submap *map::get_submap_at( const int x, const int y ) const
+submap *map::get_submap_at( const int x, const int y )
 {
     return get_submap_at( x, y, abs_sub.z );
 }
 
-submap *map::get_submap_at( const int x, const int y, int &offset_x, int &offset_y ) const
+const submap *map::get_submap_at( const int x, const int y ) const
+{
+    return get_submap_at( x, y, abs_sub.z );
+}
+
+submap *map::get_submap_at( const int x, const int y, int &offset_x, int &offset_y )
 {
     return get_submap_at( x, y, abs_sub.z, offset_x, offset_y );
 }
 
-submap *map::get_submap_at( const int x, const int y, const int z, int &offset_x, int &offset_y ) const
+const submap *map::get_submap_at( const int x, const int y, int &offset_x, int &offset_y ) const
+{
+    return get_submap_at( x, y, abs_sub.z, offset_x, offset_y );
+}
+
+submap *map::get_submap_at( const int x, const int y, const int z, int &offset_x, int &offset_y )
 {
     offset_x = x % SEEX;
     offset_y = y % SEEY;
     return get_submap_at( x, y, z );
 }
 
-submap *map::get_submap_at( const tripoint &p, int &offset_x, int &offset_y ) const
+const submap *map::get_submap_at( const int x, const int y, const int z, int &offset_x, int &offset_y ) const
+{
+    offset_x = x % SEEX;
+    offset_y = y % SEEY;
+    return get_submap_at( x, y, z );
+}
+
+submap *map::get_submap_at( const tripoint &p, int &offset_x, int &offset_y )
+{
+    offset_x = p.x % SEEX;
+    offset_y = p.y % SEEY;
+    return get_submap_at( p );
+}
+
+const submap *map::get_submap_at( const tripoint &p, int &offset_x, int &offset_y ) const
 {
     offset_x = p.x % SEEX;
     offset_y = p.y % SEEY;
     return get_submap_at( p );
 }
 
-submap *map::get_submap_at_grid( const int gridx, const int gridy ) const
+submap *map::get_submap_at_grid( const int gridx, const int gridy )
+{
+    return getsubmap( get_nonant( gridx, gridy ) );
+}
+
+const submap *map::get_submap_at_grid( const int gridx, const int gridy ) const
 {
     return getsubmap( get_nonant( gridx, gridy ) );
 }
 
-submap *map::get_submap_at_grid( const int gridx, const int gridy, const int gridz ) const
+submap *map::get_submap_at_grid( const int gridx, const int gridy, const int gridz )
+{
+    return getsubmap( get_nonant( gridx, gridy, gridz ) );
+}
+
+const submap *map::get_submap_at_grid( const int gridx, const int gridy, const int gridz ) const
 {
     return getsubmap( get_nonant( gridx, gridy, gridz ) );
 }
@@ -6214,6 +6926,7 @@ void map::draw_fill_background(ter_id type) {
     // Need to explicitly set caches dirty - set_ter would do it before
     set_transparency_cache_dirty();
     set_outside_cache_dirty();
+    set_pathing_cache_dirty();
 
     // Fill each submap rather than each tile
     constexpr size_t block_size = SEEX * SEEY;
@@ -6221,6 +6934,7 @@ void map::draw_fill_background(ter_id type) {
         for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
             auto sm = get_submap_at_grid( gridx, gridy );
             sm->is_uniform = true;
+            sm->dirty = true;
             std::uninitialized_fill_n( &sm->ter[0][0], block_size, type );
         }
     }
@@ -6309,7 +7023,7 @@ void map::add_corpse(int x, int y) {
         body.make_corpse();
     } else {
         body.make_corpse( "mon_zombie", calendar::turn );
-        body.item_tags.insert("REVIVE_SPECIAL");
+        body.set_flag("REVIVE_SPECIAL");
         body.active = true;
     }
 
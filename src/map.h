@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <vector>
 #include <string>
+#include <functional>
 #include <set>
 #include <map>
 #include <unordered_map>
@@ -32,6 +33,7 @@ class monster;
 class item;
 struct itype;
 struct mapgendata;
+struct mapgen_overmap_view;
 struct trap;
 // TODO: This should be const& but almost no functions are const
 struct wrapped_vehicle{
@@ -114,6 +116,19 @@ class map
      transparency_cache_dirty = true;
  }
 
+ /**
+  * Sets a dirty flag on the pathing caches (@ref move_cost_cache,
+  * @ref bash_resistance_cache and @ref reachability_cache).
+  *
+  * Only needed when the terrain or furniture is changed without
+  * @ref ter_set or @ref furn_set, those keep the caches up to date.
+  */
+ void set_pathing_cache_dirty() {
+     pathing_cache_dirty = true;
+     reachability_cache_dirty[0] = true;
+     reachability_cache_dirty[1] = true;
+ }
+
  /**
   * Sets a dirty flag on the outside cache.
   *
@@ -296,6 +311,13 @@ class map
   * @param bash Bashing strength of pathing creature (0 means no bashing through terrain)
   */
  std::vector<point> route(const int Fx, const int Fy, const int Tx, const int Ty, const int bash) const;
+ /**
+  * Whether @ref route could find a path. False means it certainly won't, true means
+  * it might (route also limits its search area and avoids expensive obstacles).
+  * Answered from the connected components of the tiles route may pass, so this is cheap
+  * unless the map changed in a way that could split a component since the last call.
+  */
+ bool could_route(const int Fx, const int Fy, const int Tx, const int Ty, const int bash) const;
 
  int coord_to_angle (const int x, const int y, const int tgtx, const int tgty) const;
 // vehicles
@@ -337,7 +359,7 @@ class map
  void update_vehicle_cache(vehicle *, const bool brand_new = false);
  void reset_vehicle_cache();
  void clear_vehicle_cache();
- void update_vehicle_list(submap * const to);
+ void update_vehicle_list( const submap * const to );
 
  void destroy_vehicle (vehicle *veh);
 // Change vehicle coords and move vehicle's driver along.
@@ -425,6 +447,18 @@ class map
   * does not check that there are actually any items.
   */
  bool could_see_items(int x, int y, const player &u) const;
+ /**
+  * All squares in the rectangle (x1,y1) - (x2,y2) (inclusive) that contain items,
+  * ordered by x, then y. Uses the per-submap item index, so submaps without any
+  * items are skipped entirely.
+  */
+ std::vector<point> points_with_items( int x1, int y1, int x2, int y2 ) const;
+ /**
+  * Shadowcast the field of view from (x,y) up to range squares into fov (see
+  * @ref build_seen_cache, this uses the same code and transparency data).
+  * Squares in view are set to true, all other entries are left untouched.
+  */
+ void build_fov_cache( bool (&fov)[MAPSIZE*SEEX][MAPSIZE*SEEY], int x, int y, int range );
 
 // Flags: 2D overloads
     std::string features(const int x, const int y); // Words relevant to terrain (sharp, etc)
@@ -550,6 +584,8 @@ void add_corpse(int x, int y);
  bool hit_with_acid(const int x, const int y);
  bool hit_with_fire(const int x, const int y);
  bool marlossify(const int x, const int y);
+ /** Spreads fungus from adjacent fungal tiles to this one, returns true if anything was converted. */
+ bool spread_fungus(const int x, const int y);
  bool has_adjacent_furniture(const int x, const int y);
  void mop_spills(const int x, const int y);
  /** 
@@ -560,8 +596,8 @@ void add_corpse(int x, int y);
 
  // Signs
  const std::string get_signage(const int x, const int y) const;
- void set_signage(const int x, const int y, std::string message) const;
- void delete_signage(const int x, const int y) const;
+ void set_signage(const int x, const int y, std::string message);
+ void delete_signage(const int x, const int y);
 
 // Radiation
     int get_radiation( const tripoint &p ) const; // Amount of radiation at (x, y);
@@ -606,7 +642,13 @@ void add_corpse(int x, int y);
  bool add_item_or_charges(const int x, const int y, item new_item, int overflow_radius = 2);
  void add_item_at(const int x, const int y, std::list<item>::iterator index, item new_item);
  void add_item(const int x, const int y, item new_item);
- void process_active_items();
+ /**
+  * Process the active items on the map and in vehicles.
+  * @param batch_turns Items whose processing only depends on the time passed
+  * (see @ref item::can_process_in_batches) are processed once every batch_turns
+  * calls, for all those turns at once. 1 processes them every turn.
+  */
+ void process_active_items( int batch_turns = 1 );
 
  std::list<item> use_amount_square( const int x, const int y, const itype_id type,
                                     int &quantity, const bool use_container );
@@ -755,13 +797,36 @@ void add_corpse(int x, int y);
 
 // mapgen.cpp functions
  void generate(const int x, const int y, const int z, const int turn);
+ /**
+  * Generates the submaps of one overmap terrain tile without storing them anywhere.
+  * It does not access the overmap buffer (only the view), so different maps can do this
+  * on different threads. Use @ref save_generated afterwards.
+  */
+ void generate( const mapgen_overmap_view &view, const int turn );
+ /** Adds the generated submaps to the @ref MAPBUFFER (and deletes any overflow submaps). */
+ void save_generated( const int z );
  void post_process(unsigned zones);
  void place_spawns(std::string group, const int chance,
                    const int x1, const int y1, const int x2, const int y2, const float density);
  void place_gas_pump(const int x, const int y, const int charges);
  void place_toilet(const int x, const int y, const int charges = 6 * 4); // 6 liters at 250 ml per charge
  void place_vending(int x, int y, std::string type);
+ /**
+  * Create an NPC of the given template at (x,y) and make it active.
+  * @return Its id, or -1 if static NPCs are disabled or the NPC is only
+  * created later on (see @ref defer_global_changes).
+  */
  int place_npc(int x, int y, std::string type);
+ /**
+  * Set by @ref generate_overmap_tiles on the maps it generates on worker threads.
+  * Changes to the game and overmap state (NPCs, lookups for error messages) are
+  * queued in @ref main_thread_calls then, the caller runs them after the workers
+  * are done.
+  */
+ bool defer_global_changes;
+ std::vector<std::function<void()>> main_thread_calls;
+ /** Call f now, or queue it if @ref defer_global_changes is set. */
+ void on_main_thread( const std::function<void()> &f );
  /**
   * Place items from item group in the rectangle (x1,y1) - (x2,y2). Several items may be spawned
   * on different places. Several items may spawn at once (at one place) when the item group says
@@ -794,7 +859,11 @@ void add_corpse(int x, int y);
  vehicle *add_vehicle(std::string type, const int x, const int y, const int dir,
                       const int init_veh_fuel = -1, const int init_veh_status = -1,
                       const bool merge_wrecks = true);
- void build_map_cache();
+ /**
+  * Rebuild the outside, transparency, pathing and seen caches and (unless
+  * rebuild_lightmap is false) the lightmap.
+  */
+ void build_map_cache( bool rebuild_lightmap = true );
  
 // Light/transparency: 2D
     float light_transparency(const int x, const int y) const;
@@ -904,6 +973,11 @@ protected:
         void shift_traps( const tripoint &shift );
 
         void copy_grid( point to, point from );
+        /**
+         * Generates the overmap terrain tiles that overlap this map and are not in the
+         * @ref MAPBUFFER yet, all at once and in parallel, instead of one by one in @ref loadn.
+         */
+        void generate_missing_submaps();
  void draw_map(const oter_id terrain_type, const oter_id t_north, const oter_id t_east,
                 const oter_id t_south, const oter_id t_west, const oter_id t_neast,
                 const oter_id t_seast, const oter_id t_nwest, const oter_id t_swest,
@@ -911,12 +985,25 @@ protected:
                 const int zlevel, const regional_settings * rsettings);
  void add_extra(map_extra type);
  void build_transparency_cache();
+ void build_pathing_cache();
+ /** Update the pathing caches of a single tile, unless they are dirty anyway. */
+ void update_pathing_cache( int x, int y );
+ /** Whether @ref route may pass the tile, with bashing or without. */
+ bool reachability_passable( int x, int y, bool bash ) const;
+ void build_reachability_cache( int index ) const;
+ /** Follow @ref reachability_labels to the component the label has been merged into. */
+ int reachability_root( int index, int label ) const;
+ /** Whether @ref move_cost_cache holds the move cost of the tile (vehicles aside). */
+ bool has_cached_move_cost( const int x, const int y ) const {
+     return !pathing_cache_dirty && move_cost_cache[x][y] != MOVE_COST_UNCACHED;
+ }
 public:
  void build_outside_cache();
 protected:
  void generate_lightmap();
  void build_seen_cache();
- void castLight( int row, float start, float end, int xx, int xy, int yx, int yy,
+ void castLight( bool (&output_cache)[MAPSIZE*SEEX][MAPSIZE*SEEY],
+                 int row, float start, float end, int xx, int xy, int yx, int yy,
                  const int offsetX, const int offsetY, const int offsetDistance );
 
  int my_MAPSIZE;
@@ -951,34 +1038,62 @@ private:
 
  bool transparency_cache_dirty;
  bool outside_cache_dirty;
+ bool pathing_cache_dirty;
+ mutable bool reachability_cache_dirty[2];
 
         /**
          * Get the submap pointer with given index in @ref grid, the index must be valid!
+         * The non-const versions of this and the functions below are for modifying the
+         * submap: a shared uniform submap (see @ref mapbuffer::is_shared) is replaced
+         * by a private copy in the grid and in the mapbuffer before it is returned.
+         * Use the const versions for reading only.
          */
-        submap *getsubmap( size_t grididx ) const;
+        submap *getsubmap( size_t grididx );
+        const submap *getsubmap( size_t grididx ) const;
+        /** @ref mapbuffer::is_shared, without touching the mapbuffer while generating. */
+        bool is_shared( const submap *sm ) const;
+        /**
+         * Another map may have replaced a shared template with a private copy (see
+         * @ref mapbuffer::get_unshared_positions), the grid entry of that position is
+         * looked up again then. If unused templates have been deleted (see
+         * @ref mapbuffer::get_shared_generation), all submaps are looked up again.
+         * That must not happen while the grid is being shifted.
+         */
+        void update_shared_submaps() const;
+        /** Absolute submap position of a grid entry, inverse of @ref get_nonant. */
+        tripoint grid_abs_sub( size_t grididx ) const;
         /**
          * Get the submap pointer containing the specified position within the reality bubble.
          * (x,y) must be a valid coordinate, check with @ref inbounds.
          */
-        submap *get_submap_at( int x, int y ) const;
-        submap *get_submap_at( int x, int y, int z ) const;
-        submap *get_submap_at( const tripoint &p ) const;
+        submap *get_submap_at( int x, int y );
+        const submap *get_submap_at( int x, int y ) const;
+        submap *get_submap_at( int x, int y, int z );
+        const submap *get_submap_at( int x, int y, int z ) const;
+        submap *get_submap_at( const tripoint &p );
+        const submap *get_submap_at( const tripoint &p ) const;
         /**
          * Get the submap pointer containing the specified position within the reality bubble.
          * The same as other get_submap_at, (x,y,z) must be valid (@ref inbounds).
          * Also writes the position within the submap to offset_x, offset_y
          * offset_z would always be 0, so it is not used here
          */
-        submap *get_submap_at( const int x, const int y, int& offset_x, int& offset_y ) const;
-        submap *get_submap_at( const int x, const int y, const int z, 
-                               int &offset_x, int &offset_y ) const;
-        submap *get_submap_at( const tripoint &p, int &offset_x, int &offset_y ) const;
+        submap *get_submap_at( const int x, const int y, int& offset_x, int& offset_y );
+        const submap *get_submap_at( const int x, const int y, int& offset_x, int& offset_y ) const;
+        submap *get_submap_at( const int x, const int y, const int z,
+                               int &offset_x, int &offset_y );
+        const submap *get_submap_at( const int x, const int y, const int z,
+                                     int &offset_x, int &offset_y ) const;
+        submap *get_submap_at( const tripoint &p, int &offset_x, int &offset_y );
+        const submap *get_submap_at( const tripoint &p, int &offset_x, int &offset_y ) const;
         /**
          * Get submap pointer in the grid at given grid coordinates. Grid coordinates must
          * be valid: 0 <= x < my_MAPSIZE, same for y.
          */
-        submap *get_submap_at_grid( int gridx, int gridy ) const;
-        submap *get_submap_at_grid( int gridx, int gridy, int gridz ) const;
+        submap *get_submap_at_grid( int gridx, int gridy );
+        const submap *get_submap_at_grid( int gridx, int gridy ) const;
+        submap *get_submap_at_grid( int gridx, int gridy, int gridz );
+        const submap *get_submap_at_grid( int gridx, int gridy, int gridz ) const;
         /**
          * Get the index of a submap pointer in the grid given by grid coordinates. The grid
          * coordinates must be valid: 0 <= x < my_MAPSIZE, same for y.
@@ -1030,6 +1145,8 @@ private:
  template<typename T>
      void process_items_in_vehicle( vehicle *cur_veh, submap *current_submap,
                                     T processor, std::string const &signal );
+ /** Calls of @ref process_active_items since batched items were last processed. */
+ int items_batch_turns;
 
  float lm[MAPSIZE*SEEX][MAPSIZE*SEEY];
  float sm[MAPSIZE*SEEX][MAPSIZE*SEEY];
@@ -1038,13 +1155,49 @@ private:
  float light_source_buffer[MAPSIZE*SEEX][MAPSIZE*SEEY];
  bool outside_cache[MAPSIZE*SEEX][MAPSIZE*SEEY];
  float transparency_cache[MAPSIZE*SEEX][MAPSIZE*SEEY];
+ /**
+  * Move cost of the terrain and furniture of each tile, or @ref MOVE_COST_UNCACHED if
+  * it doesn't fit. Vehicles are not included: their parts change (doors, destroyed parts)
+  * without the map knowing, so tiles in @ref veh_exists_at always bypass this cache.
+  */
+ unsigned char move_cost_cache[MAPSIZE*SEEX][MAPSIZE*SEEY];
+ static const unsigned char MOVE_COST_UNCACHED = 255;
+ /** Result of @ref bash_resistance for each tile. */
+ short bash_resistance_cache[MAPSIZE*SEEX][MAPSIZE*SEEY];
+ /**
+  * Connected component of each tile that @ref route may pass, -1 for the others. Index 0
+  * is without bashing, index 1 with it. Built when needed by @ref could_route. Components
+  * are merged when a tile becomes passable, anything that might split one makes it dirty.
+  */
+ mutable int reachability_cache[2][MAPSIZE*SEEX][MAPSIZE*SEEY];
+ /** Union-find parents of the component labels, a label is its own parent if not merged. */
+ mutable std::vector<int> reachability_labels[2];
  bool seen_cache[MAPSIZE*SEEX][MAPSIZE*SEEY];
         /**
          * The list of currently loaded submaps. The size of this should not be changed.
          * After calling @ref load or @ref generate, it should only contain non-null pointers.
          * Use @ref getsubmap or @ref setsubmap to access it.
+         * Mutable because reading may have to look up shared submaps again, see
+         * @ref update_shared_submaps.
+         */
+        mutable std::vector<submap*> grid;
+        /** The @ref mapbuffer::get_shared_generation the grid is up to date with. */
+        mutable unsigned shared_generation;
+        /** Number of @ref mapbuffer::get_unshared_positions the grid is up to date with. */
+        mutable size_t unshared_seen;
+        /**
+         * Set while @ref generate fills the grid with new submaps that are not in the
+         * @ref MAPBUFFER yet. None of them can be shared, so the mapbuffer is not
+         * consulted at all (generation may run on a worker thread, see @ref is_shared).
          */
-        std::vector<submap*> grid;
+        bool generating_private;
+        /** NPCs @ref place_npc queued while @ref defer_global_changes, rotated with the map. */
+        struct deferred_npc {
+            int x;
+            int y;
+            std::string type;
+        };
+        std::vector<deferred_npc> deferred_npcs;
         /**
          * This vector contains an entry for each trap type, it has therefor the same size
          * as the @ref traplist vector. Each entry contains a list of all point on the map that
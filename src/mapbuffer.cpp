@@ -11,6 +11,7 @@
 #include "game.h"
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 #define dbg(x) DebugLog((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
@@ -28,9 +29,36 @@ mapbuffer::~mapbuffer()
 void mapbuffer::reset()
 {
     for( auto &elem : submaps ) {
-        delete elem.second;
+        if( !is_shared( elem.second ) ) {
+            delete elem.second;
+        }
     }
     submaps.clear();
+    uniform_submaps.clear();
+    unshared_positions.clear();
+    shared_generation++;
+}
+
+/**
+ * Whether the submap holds nothing but a single terrain type, so it can be
+ * replaced by a shared template (see mapbuffer::is_shared).
+ */
+static bool can_share( const submap &sm )
+{
+    if( !sm.is_uniform || sm.field_count != 0 || !sm.spawns.empty() || !sm.vehicles.empty() ||
+        !sm.comp.name.empty() || sm.camp.is_valid() ) {
+        return false;
+    }
+    const ter_id ter = sm.ter[0][0];
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            if( sm.ter[i][j] != ter || sm.frn[i][j] != f_null || sm.trp[i][j] != tr_null ||
+                sm.rad[i][j] != 0 || !sm.itm[i][j].empty() || !sm.cosmetics[i][j].empty() ) {
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
 bool mapbuffer::add_submap(const tripoint &p, submap *sm)
@@ -39,6 +67,19 @@ bool mapbuffer::add_submap(const tripoint &p, submap *sm)
         return false;
     }
 
+    if( can_share( *sm ) ) {
+        auto &shared = uniform_submaps[get_shared_key( *sm )];
+        if( !shared.sm ) {
+            // The first one becomes the template for all later ones.
+            shared.sm.reset( sm );
+            shared.refs = 0;
+        } else if( shared.sm.get() != sm ) {
+            delete sm;
+            sm = shared.sm.get();
+        }
+        shared.refs++;
+    }
+
     submaps[p] = sm;
 
     return true;
@@ -68,10 +109,82 @@ void mapbuffer::remove_submap( tripoint addr )
         debugmsg( "Tried to remove non-existing submap %d,%d,%d", addr.x, addr.y, addr.z );
         return;
     }
-    delete m_target->second;
+    release_submap( m_target->second );
     submaps.erase( m_target );
 }
 
+void mapbuffer::release_submap( submap *sm )
+{
+    if( !is_shared( sm ) ) {
+        delete sm;
+        return;
+    }
+    // Maps may still point to it, it is deleted later on (see delete_unused_shared).
+    uniform_submaps[get_shared_key( *sm )].refs--;
+}
+
+void mapbuffer::delete_unused_shared()
+{
+    bool deleted = false;
+    for( auto it = uniform_submaps.begin(); it != uniform_submaps.end(); ) {
+        if( it->second.refs <= 0 ) {
+            it = uniform_submaps.erase( it );
+            deleted = true;
+        } else {
+            ++it;
+        }
+    }
+    // Maps look everything up again anyway, the list can start over.
+    if( deleted || !unshared_positions.empty() ) {
+        unshared_positions.clear();
+        shared_generation++;
+    }
+}
+
+mapbuffer::shared_key mapbuffer::get_shared_key( const submap &sm )
+{
+    return shared_key( sm.ter[0][0], sm.temperature );
+}
+
+bool mapbuffer::is_shared( const submap *sm ) const
+{
+    if( sm == nullptr ) {
+        return false;
+    }
+    const auto shared = uniform_submaps.find( get_shared_key( *sm ) );
+    return shared != uniform_submaps.end() && shared->second.sm.get() == sm;
+}
+
+submap *mapbuffer::unshare_submap( const tripoint &p )
+{
+    const auto target = submaps.find( p );
+    if( target == submaps.end() ) {
+        return nullptr;
+    }
+    submap *const shared = target->second;
+    if( !is_shared( shared ) ) {
+        return shared;
+    }
+
+    submap *const copy = new submap();
+    std::fill_n( &copy->ter[0][0], SEEX * SEEY, shared->ter[0][0] );
+    copy->is_uniform = true;
+    // Shared templates are not actualized (there is nothing to catch up in them),
+    // the copy is up to date as of now.
+    copy->turn_last_touched = calendar::turn;
+    copy->temperature = shared->temperature;
+    release_submap( shared );
+    target->second = copy;
+    unshared_positions.push_back( p );
+    return copy;
+}
+
+submap *mapbuffer::find_submap( const tripoint &p ) const
+{
+    const auto it = submaps.find( p );
+    return it == submaps.end() ? nullptr : it->second;
+}
+
 submap *mapbuffer::lookup_submap(int x, int y, int z)
 {
     dbg(D_INFO) << "mapbuffer::lookup_submap( x[" << x << "], y[" << y << "], z[" << z << "])";
@@ -91,6 +204,104 @@ submap *mapbuffer::lookup_submap(int x, int y, int z)
     return submaps[p];
 }
 
+/**
+ * Whether the submap quad at om_addr (overmap terrain coordinates) is used by
+ * the reality bubble, whose top left quad is at map_origin.
+ */
+static bool in_reality_bubble( const tripoint &om_addr, const tripoint &map_origin )
+{
+#ifndef ZLEVELS
+    if( om_addr.z != g->get_levz() ) {
+        return false;
+    }
+#endif
+    return om_addr.x >= map_origin.x && om_addr.y >= map_origin.y &&
+           om_addr.x <= map_origin.x + (MAPSIZE / 2) &&
+           om_addr.y <= map_origin.y + (MAPSIZE / 2);
+}
+
+/**
+ * Get the directory (one per segment) and the file name the submap quad
+ * at om_addr is stored in.
+ */
+static void quad_paths( const std::string &map_directory, const tripoint &om_addr,
+                        std::string &dirname, std::string &quad_path )
+{
+    // A segment is a chunk of 32x32 submap quads.
+    // We're breaking them into subdirectories so there aren't too many files per directory.
+    const tripoint segment_addr = overmapbuffer::omt_to_seg_copy( om_addr );
+    std::stringstream dir;
+    dir << map_directory << "/" << segment_addr.x << "." << segment_addr.y << "." << segment_addr.z;
+    dirname = dir.str();
+
+    std::stringstream path;
+    path << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
+    quad_path = path.str();
+}
+
+size_t mapbuffer::enforce_budget( size_t max_bytes )
+{
+    delete_unused_shared();
+    // Shared templates cost next to nothing, only the private submaps count.
+    const size_t max_submaps = max_bytes / sizeof( submap );
+    size_t loaded = 0;
+    for( auto &elem : submaps ) {
+        if( elem.second != nullptr && !is_shared( elem.second ) ) {
+            loaded++;
+        }
+    }
+    if( loaded <= max_submaps ) {
+        return loaded * sizeof( submap );
+    }
+
+    const tripoint map_origin = overmapbuffer::sm_to_omt_copy( g->m.get_abs_sub() );
+    struct quad_usage {
+        int last_touched = 0;
+        size_t private_submaps = 0;
+    };
+    std::map<tripoint, quad_usage, pointcomp> quads;
+    for( auto &elem : submaps ) {
+        const tripoint om_addr = overmapbuffer::sm_to_omt_copy( elem.first );
+        if( elem.second == nullptr || is_shared( elem.second ) ||
+            in_reality_bubble( om_addr, map_origin ) ) {
+            continue;
+        }
+        quad_usage &usage = quads[om_addr];
+        usage.last_touched = std::max( usage.last_touched, elem.second->turn_last_touched );
+        usage.private_submaps++;
+    }
+    std::vector<std::pair<int, tripoint>> candidates;
+    for( auto &quad : quads ) {
+        candidates.push_back( std::make_pair( quad.second.last_touched, quad.first ) );
+    }
+    // Least recently touched first, ties are broken by position to be deterministic.
+    std::sort( candidates.begin(), candidates.end(),
+    []( const std::pair<int, tripoint> &a, const std::pair<int, tripoint> &b ) {
+        return a.first < b.first || ( a.first == b.first && pointcomp()( a.second, b.second ) );
+    } );
+
+    const std::string map_directory = world_generator->active_world->world_path + "/maps";
+    assure_dir_exist( map_directory.c_str() );
+    std::list<tripoint> submaps_to_delete;
+    for( auto &candidate : candidates ) {
+        if( loaded <= max_submaps ) {
+            break;
+        }
+        std::string dirname;
+        std::string quad_path;
+        quad_paths( map_directory, candidate.second, dirname, quad_path );
+        // Nothing is queued if saving failed, the quad stays loaded then.
+        if( save_quad( dirname, quad_path, candidate.second, submaps_to_delete, true, false ) ) {
+            loaded -= quads[candidate.second].private_submaps;
+        }
+    }
+    for( auto &elem : submaps_to_delete ) {
+        remove_submap( elem );
+    }
+    delete_unused_shared();
+    return loaded * sizeof( submap );
+}
+
 void mapbuffer::save( bool delete_after_save )
 {
     std::stringstream map_directory;
@@ -106,7 +317,7 @@ void mapbuffer::save( bool delete_after_save )
     std::set<tripoint, pointcomp> saved_submaps;
     std::list<tripoint> submaps_to_delete;
     for( auto &elem : submaps ) {
-        if (num_total_submaps > 100 && num_saved_submaps % 100 == 0) {
+        if( !g->headless && num_total_submaps > 100 && num_saved_submaps % 100 == 0 ) {
             popup_nowait(_("Please wait as the map saves [%d/%d]"),
                          num_saved_submaps, num_total_submaps);
         }
@@ -121,40 +332,27 @@ void mapbuffer::save( bool delete_after_save )
         }
         saved_submaps.insert( om_addr );
 
-        // A segment is a chunk of 32x32 submap quads.
-        // We're breaking them into subdirectories so there aren't too many files per directory.
-        // Might want to make a set for this one too so it's only checked once per save().
-        std::stringstream dirname;
-        tripoint segment_addr = overmapbuffer::omt_to_seg_copy( om_addr );
-        dirname << map_directory.str() << "/" << segment_addr.x << "." <<
-                     segment_addr.y << "." << segment_addr.z;
-
-        std::stringstream quad_path;
-        quad_path << dirname.str() << "/" << om_addr.x << "." <<
-                  om_addr.y << "." << om_addr.z << ".map";
+        // Might want to make a set for the directories so each is only checked once per save().
+        std::string dirname;
+        std::string quad_path;
+        quad_paths( map_directory.str(), om_addr, dirname, quad_path );
 
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
-#ifndef ZLEVELS
-        const bool zlev_del = om_addr.z != g->get_levz();
-#else
-        const bool zlev_del = false;
-#endif
-        save_quad( dirname.str(), quad_path.str(), om_addr, submaps_to_delete,
-                   delete_after_save || zlev_del ||
-                   om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
-                   om_addr.x > map_origin.x + (MAPSIZE / 2) ||
-                   om_addr.y > map_origin.y + (MAPSIZE / 2) );
+        const bool outside_reality_bubble = !in_reality_bubble( om_addr, map_origin );
+        save_quad( dirname, quad_path, om_addr, submaps_to_delete,
+                   delete_after_save || outside_reality_bubble, !outside_reality_bubble );
         num_saved_submaps += 4;
     }
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
+    delete_unused_shared();
 }
 
-void mapbuffer::save_quad( const std::string &dirname, const std::string &filename, 
+bool mapbuffer::save_quad( const std::string &dirname, const std::string &filename, 
                            const tripoint &om_addr, std::list<tripoint> &submaps_to_delete, 
-                           bool delete_after_save )
+                           bool delete_after_save, bool in_reality_bubble )
 {
     std::vector<point> offsets;
     std::vector<tripoint> submap_addrs;
@@ -164,6 +362,10 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
     offsets.push_back( point(1, 1) );
 
     bool all_uniform = true;
+    // The reality bubble changes all the time, so it is always saved. Vehicles elsewhere
+    // are left alone until they are caught up (see vehicle::catch_up), which marks
+    // their submap dirty.
+    bool dirty = in_reality_bubble;
     for( auto &offsets_offset : offsets ) {
         tripoint submap_addr = overmapbuffer::omt_to_sm_copy( om_addr );
         submap_addr.x += offsets_offset.x;
@@ -173,10 +375,14 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
+        if( sm != nullptr && !is_shared( sm ) && sm->dirty ) {
+            dirty = true;
+        }
     }
     
-    if( all_uniform ) {
-        // Nothing to save - this quad will be regenerated faster than it would be re-read
+    if( all_uniform || !dirty ) {
+        // Nothing to save - this quad will be regenerated faster than it would be re-read,
+        // or the save file is still up to date.
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
                 if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
@@ -185,7 +391,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
             }
         }
 
-        return;
+        return true;
     }
 
     // Don't create the directory if it would be empty
@@ -193,7 +399,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
     std::ofstream fout;
     fopen_exclusive( fout, filename.c_str() );
     if( !fout.is_open() ) {
-        return;
+        return false;
     }
 
     JsonOut jsout( fout );
@@ -376,14 +582,28 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
             jsout.member( "camp" );
             jsout.write( sm->camp.save_data() );
         }
-        if( delete_after_save ) {
-            submaps_to_delete.push_back( submap_addr );
-        }
         jsout.end_object();
     }
 
     jsout.end_array();
     fclose_exclusive( fout, filename.c_str() );
+    if( fout.fail() ) {
+        // Keep them loaded and dirty, so the next save tries again.
+        return false;
+    }
+    for( auto &submap_addr : submap_addrs ) {
+        submap *sm = submaps[submap_addr];
+        if( sm == nullptr ) {
+            continue;
+        }
+        if( !is_shared( sm ) ) {
+            sm->dirty = false;
+        }
+        if( delete_after_save ) {
+            submaps_to_delete.push_back( submap_addr );
+        }
+    }
+    return true;
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -411,10 +631,12 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
         tripoint submap_coordinates;
         jsin.start_object();
         bool rubpow_update = false;
+        int version = 0;
         while( !jsin.end_object() ) {
             std::string submap_member_name = jsin.get_member_name();
             if( submap_member_name == "version" ) {
-                if (jsin.get_int() < 22) {
+                version = jsin.get_int();
+                if (version < 22) {
                     rubpow_update = true;
                 }
             } else if( submap_member_name == "coordinates" ) {
@@ -444,11 +666,13 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
                                 sm->frn[i][j] = furnmap[ "f_rubble" ].loadid;
                                 sm->itm[i][j].push_back( rock );
                                 sm->itm[i][j].push_back( rock );
+                                sm->update_item_tile( i, j );
                             } else if (ter_string == "t_wreckage"){
                                 sm->ter[i][j] = termap[ "t_dirt" ].loadid;
                                 sm->frn[i][j] = furnmap[ "f_wreckage" ].loadid;
                                 sm->itm[i][j].push_back( chunk );
                                 sm->itm[i][j].push_back( chunk );
+                                sm->update_item_tile( i, j );
                             } else if (ter_string == "t_ash"){
                                 sm->ter[i][j] = termap[ "t_dirt" ].loadid;
                                 sm->frn[i][j] = furnmap[ "f_ash" ].loadid;
@@ -511,6 +735,7 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
                             sm->active_items.add( std::prev(sm->itm[i][j].end()), point( i, j ) );
                         }
                     }
+                    sm->update_item_tile( i, j );
                 }
             } else if( submap_member_name == "traps" ) {
                 jsin.start_array();
@@ -536,6 +761,7 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
                             sm->field_count++;
                         }
                         sm->fld[i][j].addField(field_id(type), density, age);
+                        sm->update_field_tile( i, j );
                     }
                 }
             } else if( submap_member_name == "graffiti" ) {
@@ -589,6 +815,8 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
                 jsin.skip_value();
             }
         }
+        // Submaps from older versions are converted while loading and need to be saved again.
+        sm->dirty = version != savegame_version;
         if( !add_submap( submap_coordinates, sm ) ) {
             debugmsg( "submap %d,%d,%d was alread loaded", submap_coordinates.x, submap_coordinates.y,
                       submap_coordinates.z );
@@ -5,6 +5,8 @@
 #include <map>
 #include <list>
 #include <memory>
+#include <utility>
+#include <vector>
 
 struct pointcomp {
     bool operator() (const tripoint &lhs, const tripoint &rhs) const
@@ -45,10 +47,21 @@ class mapbuffer
         /** Load the entire world from savefiles into submaps in this instance. **/
         void load(std::string worldname);
         /** Store all submaps in this instance into savefiles.
+         * Only quads that are in the reality bubble or contain a
+         * @ref submap::dirty submap are written, the others are already up to date.
          * @ref delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
          **/
         void save( bool delete_after_save = false );
+        /**
+         * Save and remove the quads that were touched least recently (see
+         * @ref submap::turn_last_touched) until the submaps take at most max_bytes
+         * (roughly, only the fixed size of each submap is counted, shared templates
+         * are not counted). The reality bubble is never removed. Pointers to
+         * other submaps become invalid, so this must only be called between turns.
+         * @return The estimated size of the submaps that are still loaded.
+         */
+        size_t enforce_budget( size_t max_bytes );
 
         /** Delete all buffered submaps. **/
         void reset();
@@ -58,7 +71,9 @@ class mapbuffer
          * @param x, y, z The absolute world position in submap coordinates.
          * Same as the ones in @ref lookup_submap.
          * @param sm The submap. If the submap has been added, the unique_ptr
-         * is released (set to NULL).
+         * is released (set to NULL). A submap that can be shared (see @ref is_shared)
+         * may be deleted and replaced with the shared template, use @ref lookup_submap
+         * to get the submap that is actually stored.
          * @return true if the submap has been stored here. False if there
          * is already a submap with the specified coordinates. The submap
          * is not stored than and the caller must take of the submap object
@@ -78,9 +93,51 @@ class mapbuffer
          * submap object, don't delete it on your own.
          */
         submap *lookup_submap(int x, int y, int z);
+        /** Like @ref lookup_submap, but never loads the submap from disk. */
+        submap *find_submap( const tripoint &p ) const;
+
+        /**
+         * Uniform submaps (see @ref submap::is_uniform) that contain nothing but
+         * their terrain are not stored individually. All of them with the same terrain
+         * and temperature share one immutable template, which is
+         * reference-counted by the positions that use it. Templates no position uses
+         * anymore are only deleted by @ref save and @ref enforce_budget, which run
+         * between turns.
+         * @return Whether sm is such a shared template. It must not be modified.
+         */
+        bool is_shared( const submap *sm ) const;
+        /**
+         * Replace the shared template stored at the given position with a private
+         * copy that can be modified. Call this before writing to a submap that
+         * @ref is_shared.
+         * @return The private submap now stored at p (the stored submap itself
+         * if it was not shared), or NULL if there is no submap at p.
+         */
+        submap *unshare_submap( const tripoint &p );
+        /**
+         * Changes whenever unused templates are deleted. Maps that may still hold such a
+         * template must look all their submaps up again then.
+         */
+        unsigned get_shared_generation() const {
+            return shared_generation;
+        }
+        /**
+         * Positions that stopped using a shared template (see @ref unshare_submap) since
+         * the shared generation last changed, in that order. Maps only need to look these
+         * up again.
+         */
+        const std::vector<tripoint> &get_unshared_positions() const {
+            return unshared_positions;
+        }
 
     private:
         typedef std::map<tripoint, submap *, pointcomp> submap_map_t;
+        /** Terrain and temperature, see @ref is_shared. */
+        typedef std::pair<int, int> shared_key;
+        struct shared_submap {
+            std::unique_ptr<submap> sm;
+            int refs;
+        };
 
     public:
         inline submap_map_t::iterator begin() { return submaps.begin(); }
@@ -90,11 +147,25 @@ class mapbuffer
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
+        /** Delete the submap, or drop one reference to it if it's a shared template. */
+        void release_submap( submap *sm );
+        /** Delete the templates no position refers to anymore. */
+        void delete_unused_shared();
+        static shared_key get_shared_key( const submap &sm );
         submap *unserialize_submaps( const tripoint &p );
-        void save_quad( const std::string &dirname, const std::string &filename, 
+        /**
+         * Save the quad if it has changed and queue its submaps for deletion if
+         * delete_after_save is set. Nothing is queued if saving failed.
+         * @return Whether the save file is up to date.
+         */
+        bool save_quad( const std::string &dirname, const std::string &filename, 
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete, 
-                        bool delete_after_save );
+                        bool delete_after_save, bool in_reality_bubble );
         submap_map_t submaps;
+        /** Shared templates of uniform submaps. */
+        std::map<shared_key, shared_submap> uniform_submaps;
+        unsigned shared_generation = 0;
+        std::vector<tripoint> unshared_positions;
 };
 
 extern mapbuffer MAPBUFFER;
@@ -16,6 +16,7 @@
 #include "rng.h"
 
 #include <iosfwd>
+#include <bitset>
 #include <unordered_set>
 #include <vector>
 #include <list>
@@ -339,6 +340,7 @@ struct submap {
 
     inline void set_trap( const int x, const int y, trap_id trap ) {
         is_uniform = false;
+        dirty = true;
         trp[x][y] = trap;
     }
 
@@ -348,6 +350,7 @@ struct submap {
 
     inline void set_furn( const int x, const int y, furn_id furn ) {
         is_uniform = false;
+        dirty = true;
         frn[x][y] = furn;
     }
 
@@ -357,6 +360,7 @@ struct submap {
 
     inline void set_ter( const int x, const int y, ter_id terr ) {
         is_uniform = false;
+        dirty = true;
         ter[x][y] = terr;
     }
 
@@ -366,11 +370,13 @@ struct submap {
 
     void set_radiation( const int x, const int y, const int radiation ) {
         is_uniform = false;
+        dirty = true;
         rad[x][y] = radiation;
     }
 
     void update_lum_add( item const &i, int const x, int const y ) {
         is_uniform = false;
+        dirty = true;
         if (i.is_emissive() && lum[x][y] < 255) {
             lum[x][y]++;
         }
@@ -378,6 +384,7 @@ struct submap {
 
     void update_lum_rem( item const &i, int const x, int const y ) {
         is_uniform = false;
+        dirty = true;
         if (!i.is_emissive()) {
             return;
         } else if (lum[x][y] && lum[x][y] < 255) {
@@ -399,6 +406,21 @@ struct submap {
         }
     }
 
+    // Call this after the items on the square have been added or removed.
+    inline void update_item_tile( const int x, const int y ) {
+        item_tiles[x * SEEY + y] = !itm[x][y].empty();
+    }
+
+    inline bool has_items( const int x, const int y ) const {
+        return item_tiles[x * SEEY + y];
+    }
+
+    // Call this after fields on the square have been added. Removing fields
+    // doesn't need it, field processing forgets about empty squares.
+    inline void update_field_tile( const int x, const int y ) {
+        field_tiles[x * SEEY + y] = fld[x][y].fieldCount() > 0;
+    }
+
     bool has_graffiti( int x, int y ) const;
     const std::string &get_graffiti( int x, int y ) const;
     void set_graffiti( int x, int y, const std::string &new_graffiti );
@@ -430,11 +452,13 @@ struct submap {
     // Can be used anytime (prevents code from needing to place sign first.)
     inline void set_signage( const int x, const int y, std::string s) {
         is_uniform = false;
+        dirty = true;
         cosmetics[x][y]["SIGNAGE"] = s;
     }
     // Can be used anytime (prevents code from needing to place sign first.)
     inline void delete_signage( const int x, const int y) {
         is_uniform = false;
+        dirty = true;
         cosmetics[x][y].erase("SIGNAGE");
     }
 
@@ -443,7 +467,9 @@ struct submap {
     furn_id         frn[SEEX][SEEY];  // Furniture on each square
     std::uint8_t    lum[SEEX][SEEY];  // Number of items emitting light on each square
     std::list<item> itm[SEEX][SEEY];  // Items on each square
+    std::bitset<SEEX * SEEY> item_tiles; // Squares with items, see update_item_tile
     field           fld[SEEX][SEEY];  // Field on each square
+    std::bitset<SEEX * SEEY> field_tiles; // Squares that might have fields, see update_field_tile
     trap_id         trp[SEEX][SEEY];  // Trap on each square
     int             rad[SEEX][SEEY];  // Irradiation of each square
 
@@ -457,6 +483,12 @@ struct submap {
 
     int field_count = 0;
     int turn_last_touched = 0;
+    /**
+     * Whether the submap may differ from its save file, see @ref mapbuffer::save. Newly generated
+     * submaps are dirty. Set by the setters above and by the map functions that change the
+     * submap or hand out mutable access to its contents (items, fields, vehicles, spawns).
+     */
+    bool dirty = true;
     int temperature = 0;
     std::vector<spawn_point> spawns;
     /**
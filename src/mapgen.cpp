@@ -14,10 +14,15 @@
 #include "monstergenerator.h"
 #include "mongroup.h"
 #include "mapgen.h"
+#include "mapbuffer.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <list>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <thread>
 #include "json.h"
 #ifdef LUA
 #include "catalua.h"
@@ -31,12 +36,26 @@
 
 #define MON_RADIUS 3
 
+/**
+ * Guards the global state that mapgen changes (the @ref MAPBUFFER, g->m, the Lua state) when
+ * tiles are generated on several threads, see @ref generate_overmap_tiles. NPCs and the
+ * overmap buffer are only touched on the main thread, see @ref map::defer_global_changes.
+ */
+static std::recursive_mutex mapgen_global_mutex;
+
+static const option_handle<bool> opt_static_spawn( "STATIC_SPAWN", true );
+static const option_handle<float> opt_spawn_density( "SPAWN_DENSITY", true );
+static const option_handle<bool> opt_static_npc( "STATIC_NPC", true );
+static const option_handle<float> opt_item_spawnrate( "ITEM_SPAWNRATE", true );
+static const option_handle<bool> opt_classic_zombies( "CLASSIC_ZOMBIES", true );
+
 bool connects_to(oter_id there, int dir_from_here);
 void science_room(map *m, int x1, int y1, int x2, int y2, int z, int rotate);
 void set_science_room(map *m, int x1, int y1, bool faces_right, int turn);
 void silo_rooms(map *m);
 void build_mine_room(map *m, room_type type, int x1, int y1, int x2, int y2, mapgendata & dat);
 map_extra random_map_extra(map_extras);
+static int spawn_static_npc( const tripoint &abs_sub, int x, int y, const std::string &type );
 
 room_type pick_mansion_room(int x1, int y1, int x2, int y2);
 void build_mansion_room(map *m, room_type type, int x1, int y1, int x2, int y2, mapgendata & dat);
@@ -44,12 +63,54 @@ void mansion_room(map *m, int x1, int y1, int x2, int y2, mapgendata & dat); //
 
 // (x,y,z) are absolute coordinates of a submap
 // x%2 and y%2 must be 0!
+mapgen_overmap_view::mapgen_overmap_view( const int x, const int y, const int z )
+    : x( x ), y( y ), z( z )
+{
+    // x, and y are submap coordinates, convert to overmap terrain coordinates
+    int overx = x;
+    int overy = y;
+    overmapbuffer::sm_to_omt(overx, overy);
+    rsettings = &overmap_buffer.get_settings(overx, overy, z);
+    t_above = overmap_buffer.get_ter(overx, overy, z + 1);
+    terrain_type = overmap_buffer.get_ter(overx, overy, z);
+    t_nesw[0] = overmap_buffer.get_ter(overx, overy - 1, z);
+    t_nesw[1] = overmap_buffer.get_ter(overx + 1, overy, z);
+    t_nesw[2] = overmap_buffer.get_ter(overx, overy + 1, z);
+    t_nesw[3] = overmap_buffer.get_ter(overx - 1, overy, z);
+    t_nesw[4] = overmap_buffer.get_ter(overx + 1, overy - 1, z);
+    t_nesw[5] = overmap_buffer.get_ter(overx + 1, overy + 1, z);
+    t_nesw[6] = overmap_buffer.get_ter(overx - 1, overy - 1, z);
+    t_nesw[7] = overmap_buffer.get_ter(overx - 1, overy + 1, z);
+
+    // This attempts to scale density of zombies inversely with distance from the nearest city.
+    // In other words, make city centers dense and perimiters sparse.
+    density = 0.0;
+    for (int i = overx - MON_RADIUS; i <= overx + MON_RADIUS; i++) {
+        for (int j = overy - MON_RADIUS; j <= overy + MON_RADIUS; j++) {
+            density += overmap_buffer.get_ter(i, j, z).t().mondensity;
+        }
+    }
+    density = density / 100;
+
+    seed = rng_location_seed( RNG_MAPGEN, x, y, z );
+}
+
 void map::generate(const int x, const int y, const int z, const int turn)
 {
     dbg(D_INFO) << "map::generate( g[" << g << "], x[" << x << "], "
                 << "y[" << y << "], z[" << z <<"], turn[" << turn << "] )";
 
-    set_abs_sub( x, y, z );
+    generate( mapgen_overmap_view( x, y, z ), turn );
+    save_generated( z );
+}
+
+void map::generate( const mapgen_overmap_view &view, const int turn )
+{
+    rng_stream stream( view.seed );
+    rng_stream_scope rng_scope( stream );
+
+    set_abs_sub( view.x, view.y, view.z );
+    generating_private = true;
 
     // First we have to create new submaps and initialize them to 0 all over
     // We create all the submaps, even if we're not a tinymap, so that map
@@ -65,37 +126,16 @@ void map::generate(const int x, const int y, const int z, const int turn)
     }
 
     unsigned zones = 0;
-    // x, and y are submap coordinates, convert to overmap terrain coordinates
-    int overx = x;
-    int overy = y;
-    overmapbuffer::sm_to_omt(overx, overy);
-    const regional_settings *rsettings = &overmap_buffer.get_settings(overx, overy, z);
-    oter_id t_above = overmap_buffer.ter(overx, overy, z + 1);
-    oter_id terrain_type = overmap_buffer.ter(overx, overy, z);
-    oter_id t_north = overmap_buffer.ter(overx, overy - 1, z);
-    oter_id t_neast = overmap_buffer.ter(overx + 1, overy - 1, z);
-    oter_id t_east = overmap_buffer.ter(overx + 1, overy, z);
-    oter_id t_seast = overmap_buffer.ter(overx + 1, overy + 1, z);
-    oter_id t_south = overmap_buffer.ter(overx, overy + 1, z);
-    oter_id t_nwest = overmap_buffer.ter(overx - 1, overy - 1, z);
-    oter_id t_west = overmap_buffer.ter(overx - 1, overy, z);
-    oter_id t_swest = overmap_buffer.ter(overx - 1, overy + 1, z);
+    const oter_id terrain_type = view.terrain_type;
+    const oter_id *t_nesw = view.t_nesw;
 
-    // This attempts to scale density of zombies inversely with distance from the nearest city.
-    // In other words, make city centers dense and perimiters sparse.
-    float density = 0.0;
-    for (int i = overx - MON_RADIUS; i <= overx + MON_RADIUS; i++) {
-        for (int j = overy - MON_RADIUS; j <= overy + MON_RADIUS; j++) {
-            density += otermap[overmap_buffer.ter(i, j, z)].mondensity;
-        }
-    }
-    density = density / 100;
+    draw_map(terrain_type, t_nesw[0], t_nesw[1], t_nesw[2], t_nesw[3], t_nesw[4], t_nesw[5],
+             t_nesw[6], t_nesw[7], view.t_above, turn, view.density, view.z, view.rsettings);
 
-    draw_map(terrain_type, t_north, t_east, t_south, t_west, t_neast, t_seast, t_nwest, t_swest,
-             t_above, turn, density, z, rsettings);
-
-    map_extras ex = get_extras(otermap[terrain_type].extras);
+    map_extras ex = get_extras(terrain_type.t().extras);
     if ( one_in( ex.chance )) {
+        // Some extras damage vehicles, which puts the parts onto g->m.
+        std::lock_guard<std::recursive_mutex> lock( mapgen_global_mutex );
         add_extra( random_map_extra( ex ));
     }
 
@@ -125,6 +165,19 @@ void map::generate(const int x, const int y, const int z, const int turn)
 
     post_process(zones);
 
+    // Only now, the map may have been rotated.
+    for( auto &queued : deferred_npcs ) {
+        const tripoint at = abs_sub;
+        main_thread_calls.push_back( [at, queued]() {
+            spawn_static_npc( at, queued.x, queued.y, queued.type );
+        } );
+    }
+    deferred_npcs.clear();
+}
+
+void map::save_generated( const int z )
+{
+    generating_private = false;
     // Okay, we know who are neighbors are.  Let's draw!
     // And finally save used submaps and delete the rest.
     for (int i = 0; i < my_MAPSIZE; i++) {
@@ -140,6 +193,62 @@ void map::generate(const int x, const int y, const int z, const int turn)
     }
 }
 
+size_t generate_overmap_tiles( const std::vector<tripoint> &positions, const int turn )
+{
+    // Collecting the views creates missing overmaps, which must happen on this thread.
+    std::vector<mapgen_overmap_view> views;
+    std::set<tripoint> seen;
+    for( auto &p : positions ) {
+        if( MAPBUFFER.lookup_submap( p.x, p.y, p.z ) == nullptr && seen.insert( p ).second ) {
+            views.emplace_back( p.x, p.y, p.z );
+        }
+    }
+    if( views.empty() ) {
+        return 0;
+    }
+
+    // The workers only read the options, they must not update the handles themselves.
+    refresh_option_handles();
+
+    std::atomic<size_t> next_view( 0 );
+    std::vector<std::string> errors;
+    std::vector<std::function<void()>> main_thread_calls;
+    const auto work = [&]() {
+        debugmsg_collector collector;
+        for( size_t i = next_view++; i < views.size(); i = next_view++ ) {
+            // A new map each time, the vehicle caches still refer to the previous submaps.
+            tinymap tmp_map;
+            tmp_map.defer_global_changes = true;
+            tmp_map.generate( views[i], turn );
+            std::lock_guard<std::recursive_mutex> lock( mapgen_global_mutex );
+            tmp_map.save_generated( views[i].z );
+            main_thread_calls.insert( main_thread_calls.end(), tmp_map.main_thread_calls.begin(),
+                                      tmp_map.main_thread_calls.end() );
+        }
+        std::lock_guard<std::recursive_mutex> lock( mapgen_global_mutex );
+        errors.insert( errors.end(), collector.messages.begin(), collector.messages.end() );
+    };
+
+    const size_t num_threads = std::min<size_t>( std::max( 1u, std::thread::hardware_concurrency() ),
+                               views.size() );
+    std::vector<std::thread> workers;
+    for( size_t i = 1; i < num_threads; i++ ) {
+        workers.emplace_back( work );
+    }
+    // This thread helps instead of waiting idle.
+    work();
+    for( auto &worker : workers ) {
+        worker.join();
+    }
+    for( auto &error : errors ) {
+        debugmsg( "%s", error.c_str() );
+    }
+    for( auto &call : main_thread_calls ) {
+        call();
+    }
+    return views.size();
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////
 ///// mapgen_function class.
@@ -1363,6 +1472,7 @@ void mapgen_lua(map * m,oter_id id,mapgendata md ,int t,float d, const std::stri
 
 #ifdef LUA
 void mapgen_function_lua::generate( map *m, oter_id terrain_type, mapgendata dat, int t, float d ) {
+    std::lock_guard<std::recursive_mutex> lock( mapgen_global_mutex );
     mapgen_lua(m, terrain_type, dat, t, d, scr );
 }
 #endif
@@ -9767,7 +9877,7 @@ FFFFFFFFFFFFFFFFFFFFFFFF\n\
         for(int a = 0; a < 21; a++ ) {
             vset.push_back(a);
         }
-        std::random_shuffle(vset.begin(), vset.end());
+        std::shuffle( vset.begin(), vset.end(), current_rng_stream() );
         for(int a = 0; a < vnum; a++) {
             if (vset[a] < 12) {
                 if (one_in(2)) {
@@ -9970,7 +10080,7 @@ FFFFFFFFFFFFFFFFFFFFFFFF\n\
         for(int a = 0; a < 17; a++) {
             vset.push_back(a);
         }
-        std::random_shuffle(vset.begin(), vset.end());
+        std::shuffle( vset.begin(), vset.end(), current_rng_stream() );
         for(int a = 0; a < vnum; a++) {
             if (vset[a] < 3) {
                 if (one_in(2)) {
@@ -11170,7 +11280,7 @@ FFFFFFFFFFFFFFFFFFFFFFFF\n\
         // not one of the hardcoded ones!
         // load from JSON???
         debugmsg("Error: tried to generate map for omtype %s, \"%s\" (id_mapgen %s)",
-                 terrain_type.c_str(), otermap[terrain_type].name.c_str(), function_key.c_str() );
+                 terrain_type.c_str(), terrain_type.t().name.c_str(), function_key.c_str() );
         fill_background(this, t_floor);
 
     }}
@@ -11345,18 +11455,21 @@ void map::post_process(unsigned zones)
 void map::place_spawns(std::string group, const int chance,
                        const int x1, const int y1, const int x2, const int y2, const float density)
 {
-    if (!ACTIVE_WORLD_OPTIONS["STATIC_SPAWN"]) {
+    if( !opt_static_spawn ) {
         return;
     }
 
     if( !MonsterGroupManager::isValidMonsterGroup( group ) ) {
-        const point omt = overmapbuffer::sm_to_omt_copy( get_abs_sub().x, get_abs_sub().y );
-        const oter_id &oid = overmap_buffer.ter( omt.x, omt.y, get_abs_sub().z );
-        debugmsg("place_spawns: invalid mongroup '%s', om_terrain = '%s' (%s)", group.c_str(), oid.t().id.c_str(), oid.t().id_mapgen.c_str() );
+        const tripoint abs_sub = get_abs_sub();
+        on_main_thread( [abs_sub, group]() {
+            const point omt = overmapbuffer::sm_to_omt_copy( abs_sub.x, abs_sub.y );
+            const oter_id &oid = overmap_buffer.get_ter( omt.x, omt.y, abs_sub.z );
+            debugmsg("place_spawns: invalid mongroup '%s', om_terrain = '%s' (%s)", group.c_str(), oid.t().id.c_str(), oid.t().id_mapgen.c_str() );
+        } );
         return;
     }
 
-    float multiplier = ACTIVE_WORLD_OPTIONS["SPAWN_DENSITY"];
+    float multiplier = opt_spawn_density;
 
     if( multiplier == 0.0 ) {
         return;
@@ -11419,11 +11532,8 @@ void map::place_vending(int x, int y, std::string type)
     place_items(type, broken ? 40 : 99, x, y, x, y, false, 0, false);
 }
 
-int map::place_npc(int x, int y, std::string type)
+static int spawn_static_npc( const tripoint &abs_sub, int x, int y, const std::string &type )
 {
-    if(!ACTIVE_WORLD_OPTIONS["STATIC_NPC"]) {
-        return -1; //Do not generate an npc.
-    }
     npc *temp = new npc();
     temp->normalize();
     temp->load_npc_template(type);
@@ -11434,22 +11544,47 @@ int map::place_npc(int x, int y, std::string type)
     return temp->getID();
 }
 
+int map::place_npc(int x, int y, std::string type)
+{
+    if( !opt_static_npc ) {
+        return -1; //Do not generate an npc.
+    }
+    if( defer_global_changes ) {
+        // Templates assign ids and missions, the NPC goes into the overmap.
+        deferred_npcs.push_back( deferred_npc{ x, y, type } );
+        return -1;
+    }
+    return spawn_static_npc( abs_sub, x, y, type );
+}
+
+void map::on_main_thread( const std::function<void()> &f )
+{
+    if( defer_global_changes ) {
+        main_thread_calls.push_back( f );
+    } else {
+        f();
+    }
+}
+
 // A chance of 100 indicates that items should always spawn,
 // the item group should be responsible for determining the amount of items.
 int map::place_items(items_location loc, int chance, int x1, int y1,
                      int x2, int y2, bool ongrass, int turn, bool)
 {
-    const float spawn_rate = ACTIVE_WORLD_OPTIONS["ITEM_SPAWNRATE"];
+    const float spawn_rate = opt_item_spawnrate;
 
     if (chance > 100 || chance <= 0) {
         debugmsg("map::place_items() called with an invalid chance (%d)", chance);
         return 0;
     }
     if (!item_group::group_is_defined(loc)) {
-        const point omt = overmapbuffer::sm_to_omt_copy( get_abs_sub().x, get_abs_sub().y );
-        const oter_id &oid = overmap_buffer.ter( omt.x, omt.y, get_abs_sub().z );
-        debugmsg("place_items: invalid item group '%s', om_terrain = '%s' (%s)",
-                 loc.c_str(), oid.t().id.c_str(), oid.t().id_mapgen.c_str() );
+        const tripoint abs_sub = get_abs_sub();
+        on_main_thread( [abs_sub, loc]() {
+            const point omt = overmapbuffer::sm_to_omt_copy( abs_sub.x, abs_sub.y );
+            const oter_id &oid = overmap_buffer.get_ter( omt.x, omt.y, abs_sub.z );
+            debugmsg("place_items: invalid item group '%s', om_terrain = '%s' (%s)",
+                     loc.c_str(), oid.t().id.c_str(), oid.t().id_mapgen.c_str() );
+        } );
         return 0;
     }
 
@@ -11504,7 +11639,7 @@ void map::add_spawn(std::string type, int count, int x, int y, bool friendly,
                  type.c_str(), count, x, y);
         return;
     }
-    if( ACTIVE_WORLD_OPTIONS["CLASSIC_ZOMBIES"] && !GetMType(type)->in_category("CLASSIC") &&
+    if( opt_classic_zombies && !GetMType(type)->in_category("CLASSIC") &&
         !GetMType(type)->in_category("WILDLIFE") ) {
         // Don't spawn non-classic monsters in classic zombie mode.
         return;
@@ -11514,6 +11649,7 @@ void map::add_spawn(std::string type, int count, int x, int y, bool friendly,
     }
     spawn_point tmp(type, count, offset_x, offset_y, faction_id, mission_id, friendly, name);
     place_on_submap->spawns.push_back(tmp);
+    place_on_submap->dirty = true;
 }
 
 vehicle *map::add_vehicle(std::string type, const int x, const int y, const int dir,
@@ -11549,6 +11685,7 @@ vehicle *map::add_vehicle(std::string type, const int x, const int y, const int
     if(placed_vehicle != NULL) {
         submap *place_on_submap = get_submap_at_grid(placed_vehicle->smx, placed_vehicle->smy);
         place_on_submap->vehicles.push_back(placed_vehicle);
+        place_on_submap->dirty = true;
 
         vehicle_list.insert(placed_vehicle);
         update_vehicle_cache(placed_vehicle, true);
@@ -11693,9 +11830,35 @@ void map::rotate(int turns)
     real_coords rc;
     rc.fromabs(get_abs_sub().x*SEEX, get_abs_sub().y*SEEY);
 
+    const auto rotate_npc = [turns]( const int old_x, const int old_y, int &new_x, int &new_y ) {
+        new_x = old_x;
+        new_y = old_y;
+        switch(turns) {
+            case 3:
+                new_x = old_y;
+                new_y = SEEX * 2 - 1 - old_x;
+                break;
+            case 2:
+                new_x = SEEX * 2 - 1 - old_x;
+                new_y = SEEY * 2 - 1 - old_y;
+                break;
+            case 1:
+                new_x = SEEY * 2 - 1 - old_y;
+                new_y = old_x;
+                break;
+        }
+    };
+    // NPCs placed on a worker thread only exist in deferred_npcs yet.
+    for( auto &queued : deferred_npcs ) {
+        rotate_npc( queued.x, queued.y, queued.x, queued.y );
+    }
+
     const int radius = int(MAPSIZE / 2) + 3;
     // uses submap coordinates
-    std::vector<npc*> npcs = overmap_buffer.get_npcs_near_player(radius);
+    std::vector<npc*> npcs;
+    if( !defer_global_changes ) {
+        npcs = overmap_buffer.get_npcs_near_player(radius);
+    }
     for (auto &i : npcs) {
         npc *act_npc = i;
         if (act_npc->global_omt_location().x*2 == get_abs_sub().x &&
@@ -11709,20 +11872,7 @@ void map::rotate(int turns)
                     old_y += SEEY;
                 int new_x = old_x;
                 int new_y = old_y;
-                switch(turns) {
-                    case 3:
-                        new_x = old_y;
-                        new_y = SEEX * 2 - 1 - old_x;
-                        break;
-                    case 2:
-                        new_x = SEEX * 2 - 1 - old_x;
-                        new_y = SEEY * 2 - 1 - old_y;
-                        break;
-                    case 1:
-                        new_x = SEEY * 2 - 1 - old_y;
-                        new_y = old_x;
-                        break;
-                    }
+                rotate_npc( old_x, old_y, new_x, new_y );
                 i->setx( i->posx() + new_x - old_x );
                 i->sety( i->posy() + new_y - old_y );
             }
@@ -11896,6 +12046,7 @@ void map::rotate(int turns)
             std::swap( furnrot[i][j], sm->frn[lx][ly] );
             std::swap( traprot[i][j], sm->trp[lx][ly] );
             std::swap( fldrot[i][j], sm->fld[lx][ly] );
+            sm->update_field_tile( lx, ly );
             std::swap( radrot[i][j], sm->rad[lx][ly] );
             std::swap( cosmetics_rot[i][j], sm->cosmetics[lx][ly] );
             for( auto &itm : itrot[i][j] ) {
@@ -12737,7 +12888,7 @@ map_extra random_map_extra(map_extras embellishments)
     int pick = 0;
     // Set pick to the total of all the chances for map extras
     for (int i = 0; i < num_map_extras; i++) {
-        if (!ACTIVE_WORLD_OPTIONS["CLASSIC_ZOMBIES"] || mfb(i) & classic_extras) {
+        if( !opt_classic_zombies || mfb(i) & classic_extras ) {
             pick += embellishments.chances[i];
         }
     }
@@ -12746,7 +12897,7 @@ map_extra random_map_extra(map_extras embellishments)
     int choice = -1;
     while (pick >= 0) {
         choice++;
-        if(!ACTIVE_WORLD_OPTIONS["CLASSIC_ZOMBIES"] || mfb(choice) & classic_extras) {
+        if( !opt_classic_zombies || mfb(choice) & classic_extras ) {
             pick -= embellishments.chances[choice];
         }
     }
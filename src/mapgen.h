@@ -4,9 +4,42 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
+#include <cstdint>
 #include "mapgenformat.h"
 #include "mapgen_functions.h"
 
+/**
+ * Everything the generation of one overmap terrain tile needs to know about the overmap.
+ * The overmap buffer is not thread safe, so this is collected on the main thread, after
+ * that the tile can be generated (@ref map::generate) on any thread.
+ */
+struct mapgen_overmap_view {
+    /** Submap coordinates of the top-left submap of the tile. */
+    int x;
+    int y;
+    int z;
+    oter_id terrain_type;
+    oter_id t_above;
+    /** North, east, south, west, north-east, south-east, north-west, south-west. */
+    oter_id t_nesw[8];
+    const regional_settings *rsettings;
+    /** Zombie density, depends on the distance to the nearest city. */
+    float density;
+    /** Seed of the random number stream the tile is generated with. */
+    uint64_t seed;
+
+    mapgen_overmap_view( int x, int y, int z );
+};
+
+/**
+ * Generates the overmap terrain tiles (given as submap coordinates of their top-left submap)
+ * that are not in the @ref MAPBUFFER yet, using all available cores. Returns when all of them
+ * have been generated and added to the MAPBUFFER.
+ * @return The number of tiles that have been generated.
+ */
+size_t generate_overmap_tiles( const std::vector<tripoint> &positions, int turn );
+
 //////////////////////////////////////////////////////////////////////////
 ///// function pointer class; provides absract referencing of
 ///// map generator functions written in multiple ways for per-terrain
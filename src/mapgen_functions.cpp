@@ -10,6 +10,9 @@
 #include "scenario.h"
 #include <array>
 
+static const option_handle<bool> opt_black_road( "BLACK_ROAD", true );
+static const option_handle<float> opt_spawn_density( "SPAWN_DENSITY", true );
+
 mapgendata::mapgendata(oter_id north, oter_id east, oter_id south, oter_id west, oter_id northeast,
                        oter_id northwest, oter_id southeast, oter_id southwest, oter_id up, int z, const regional_settings * rsettings, map * mp) :
     default_groundcover(0,1,0)
@@ -956,7 +959,7 @@ void mapgen_road_straight(map *m, oter_id terrain_type, mapgendata dat, int turn
 {
     bool sidewalks = false;
     for (int i = 0; i < 8; i++) {
-        if (otermap[dat.t_nesw[i]].has_flag(has_sidewalk)) {
+        if (dat.t_nesw[i].t().has_flag(has_sidewalk)) {
             sidewalks = true;
         }
     }
@@ -1004,7 +1007,7 @@ void mapgen_road_end(map *m, oter_id terrain_type, mapgendata dat, int turn, flo
 {
     bool sidewalks = false;
     for (int i = 0; i < 8; i++) {
-        if (otermap[dat.t_nesw[i]].has_flag(has_sidewalk)) {
+        if (dat.t_nesw[i].t().has_flag(has_sidewalk)) {
             sidewalks = true;
         }
     }
@@ -1104,7 +1107,7 @@ void mapgen_road_curved(map *m, oter_id terrain_type, mapgendata dat, int turn,
 {
     bool sidewalks = false;
     for (int i = 0; i < 8; i++) {
-        if (otermap[dat.t_nesw[i]].has_flag(has_sidewalk)) {
+        if (dat.t_nesw[i].t().has_flag(has_sidewalk)) {
             sidewalks = true;
         }
     }
@@ -1208,7 +1211,7 @@ void mapgen_road_tee(map *m, oter_id terrain_type, mapgendata dat, int turn, flo
 {
     bool sidewalks = false;
     for (int i = 0; i < 8; i++) {
-        if (otermap[dat.t_nesw[i]].has_flag(has_sidewalk)) {
+        if (dat.t_nesw[i].t().has_flag(has_sidewalk)) {
             sidewalks = true;
         }
     }
@@ -1262,7 +1265,7 @@ void mapgen_road_four_way(map *m, oter_id terrain_type, mapgendata dat, int turn
     }
     bool sidewalks = false;
     for (int i = 0; i < 8; i++) {
-        if (otermap[dat.t_nesw[i]].has_flag(has_sidewalk)) {
+        if (dat.t_nesw[i].t().has_flag(has_sidewalk)) {
             sidewalks = true;
         }
     }
@@ -3756,13 +3759,13 @@ void mapgen_shelter(map *m, oter_id, mapgendata dat, int, float) {
                 m->spawn_item(lxa, 5, "mask_gas"); // See! The gas mask is real!
             }
         }
-        if(ACTIVE_WORLD_OPTIONS["BLACK_ROAD"] || g->scen->has_flag("SUR_START")) {
+        if( opt_black_road || g->scen->has_flag("SUR_START")) {
             //place zombies outside
-            m->place_spawns("GROUP_ZOMBIE", ACTIVE_WORLD_OPTIONS["SPAWN_DENSITY"], 0, 0, SEEX * 2 - 1, 3, 0.4f);
-            m->place_spawns("GROUP_ZOMBIE", ACTIVE_WORLD_OPTIONS["SPAWN_DENSITY"], 0, 4, 3, SEEX * 2 - 4, 0.4f);
-            m->place_spawns("GROUP_ZOMBIE", ACTIVE_WORLD_OPTIONS["SPAWN_DENSITY"], SEEX * 2 - 3, 4,
+            m->place_spawns("GROUP_ZOMBIE", int( opt_spawn_density ), 0, 0, SEEX * 2 - 1, 3, 0.4f);
+            m->place_spawns("GROUP_ZOMBIE", int( opt_spawn_density ), 0, 4, 3, SEEX * 2 - 4, 0.4f);
+            m->place_spawns("GROUP_ZOMBIE", int( opt_spawn_density ), SEEX * 2 - 3, 4,
                          SEEX * 2 - 1, SEEX * 2 - 4, 0.4f);
-            m->place_spawns("GROUP_ZOMBIE", ACTIVE_WORLD_OPTIONS["SPAWN_DENSITY"], 0, SEEX * 2 - 3,
+            m->place_spawns("GROUP_ZOMBIE", int( opt_spawn_density ), 0, SEEX * 2 - 3,
                          SEEX * 2 - 1, SEEX * 2 - 1, 0.4f);
         }
 }
@@ -4029,7 +4029,7 @@ void mattack::riotbot(monster *z, int index)
                         _("You deftly slip out of the handcuffs just as the robot closes them.  The robot didn't seem to notice!"));
                 g->u.i_add(handcuffs);
             } else {
-                handcuffs.item_tags.insert("NO_UNWIELD");
+                handcuffs.set_flag("NO_UNWIELD");
                 g->u.wield(&(g->u.i_add(handcuffs)));
                 g->u.moves -= 300;
                 add_msg(_("The robot puts handcuffs on you."));
@@ -5,6 +5,8 @@
 #include "monstergenerator.h"
 #include "json.h"
 
+static const option_handle<int> opt_monster_group_difficulty( "MONSTER_GROUP_DIFFICULTY", true );
+
 // Default start time, this is the only place it's still used.
 #define STARTING_MINUTES 480
 
@@ -23,7 +25,7 @@ MonsterGroupResult MonsterGroupManager::GetResultFromGroup(
     std::string group_name, int *quantity, int turn ){
     int spawn_chance = rng(1, 1000);
     auto *groupptr = &GetMonsterGroup( group_name );
-    int replace_time = DAYS(groupptr->monster_group_time * ACTIVE_WORLD_OPTIONS["MONSTER_GROUP_DIFFICULTY"]) * (calendar::turn.season_length() / 14);
+    int replace_time = DAYS(groupptr->monster_group_time * opt_monster_group_difficulty) * (calendar::turn.season_length() / 14);
     while (groupptr->replace_monster_group && calendar::turn.get_turn() > replace_time){
         groupptr = &GetMonsterGroup(groupptr->new_monster_group);
     }
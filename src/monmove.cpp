@@ -19,6 +19,12 @@
 
 #define MONSTER_FOLLOW_DIST 8
 
+// Effects that are checked for every move, see get_efftype_index.
+static const efftype_index effect_bouldering = get_efftype_index( "bouldering" );
+static const efftype_index effect_docile = get_efftype_index( "docile" );
+static const efftype_index effect_pacified = get_efftype_index( "pacified" );
+static const efftype_index effect_stunned = get_efftype_index( "stunned" );
+
 bool monster::wander()
 {
  return (plans.empty());
@@ -126,7 +132,7 @@ void monster::plan(const mfactions &factions)
     int bresenham_slope = 0;
     int selected_slope = 0;
     bool fleeing = false;
-    bool docile = has_flag( MF_VERMIN ) || ( friendly != 0 && has_effect( "docile" ) );
+    bool docile = has_flag( MF_VERMIN ) || ( friendly != 0 && has_effect( effect_docile ) );
     bool angers_hostile_weak = type->anger.find( MTRIG_HOSTILE_WEAK ) != type->anger.end();
     int angers_hostile_near = ( type->anger.find( MTRIG_HOSTILE_CLOSE ) != type->anger.end() ) ? 5 : 0;
     int fears_hostile_near = ( type->fear.find( MTRIG_HOSTILE_CLOSE ) != type->fear.end() ) ? 5 : 0;
@@ -316,7 +322,7 @@ void monster::move()
             sp_timeout[i]--;
         }
 
-        if( sp_timeout[i] == 0 && !has_effect("pacified") && !is_hallucination() ) {
+        if( sp_timeout[i] == 0 && !has_effect( effect_pacified ) && !is_hallucination() ) {
             type->sp_attack[i](this, i);
         }
     }
@@ -331,7 +337,7 @@ void monster::move()
         moves = 0;
         return;
     }
-    if (has_effect("stunned")) {
+    if (has_effect( effect_stunned )) {
         stumble(false);
         moves = 0;
         return;
@@ -687,7 +693,7 @@ std::vector<point> get_bashing_zone( point bashee, point basher, int maxdepth )
 
 int monster::bash_at(int x, int y) {
 
-    if (has_effect("pacified")) return 0;
+    if (has_effect( effect_pacified )) return 0;
 
     //Hallucinations can't bash stuff.
     if(is_hallucination()) {
@@ -771,7 +777,7 @@ int monster::group_bash_skill( point target )
 
 int monster::attack_at(int x, int y) {
 
-    if (has_effect("pacified")) return 0;
+    if (has_effect( effect_pacified )) return 0;
 
     int mondex = g->mon_at(x, y);
     int npcdex = g->npc_at(x, y);
@@ -867,7 +873,7 @@ int monster::move_to(int x, int y, bool force)
     }
     if (g->m.has_flag("UNSTABLE", x, y)) {
         add_effect("bouldering", 1, num_bp, true);
-    } else if (has_effect("bouldering")) {
+    } else if (has_effect( effect_bouldering )) {
         remove_effect("bouldering");
     }
     g->m.creature_on_trap( *this );
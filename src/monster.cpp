@@ -21,6 +21,23 @@
 #define SGN(a) (((a)<0) ? -1 : 1)
 #define SQR(a) ((a)*(a))
 
+// Effects that are checked for every move, see get_efftype_index.
+static const efftype_index effect_beartrap = get_efftype_index( "beartrap" );
+static const efftype_index effect_bouldering = get_efftype_index( "bouldering" );
+static const efftype_index effect_crushed = get_efftype_index( "crushed" );
+static const efftype_index effect_downed = get_efftype_index( "downed" );
+static const efftype_index effect_heavysnare = get_efftype_index( "heavysnare" );
+static const efftype_index effect_in_pit = get_efftype_index( "in_pit" );
+static const efftype_index effect_lightsnare = get_efftype_index( "lightsnare" );
+static const efftype_index effect_onfire = get_efftype_index( "onfire" );
+static const efftype_index effect_pacified = get_efftype_index( "pacified" );
+static const efftype_index effect_run = get_efftype_index( "run" );
+static const efftype_index effect_stunned = get_efftype_index( "stunned" );
+static const efftype_index effect_tied = get_efftype_index( "tied" );
+static const efftype_index effect_webbed = get_efftype_index( "webbed" );
+static const efftype_index effect_blind = get_efftype_index( "blind" );
+static const efftype_index effect_deaf = get_efftype_index( "deaf" );
+
 monster::monster()
 {
  position.x = 20;
@@ -273,13 +290,13 @@ int monster::print_info(WINDOW* w, int vStart, int vLines, int column) const
     get_Attitude(color, attitude);
     wprintz(w, color, "%s", attitude.c_str());
 
-    if (has_effect("downed")) {
+    if (has_effect( effect_downed )) {
         wprintz(w, h_white, _("On ground"));
-    } else if (has_effect("stunned")) {
+    } else if (has_effect( effect_stunned )) {
         wprintz(w, h_white, _("Stunned"));
-    } else if (has_effect("lightsnare") || has_effect("heavysnare") || has_effect("beartrap")) {
+    } else if (has_effect( effect_lightsnare ) || has_effect( effect_heavysnare ) || has_effect( effect_beartrap )) {
         wprintz(w, h_white, _("Trapped"));
-    } else if (has_effect("tied")) {
+    } else if (has_effect( effect_tied )) {
         wprintz(w, h_white, _("Tied"));
     }
     std::string damage_info;
@@ -337,14 +354,14 @@ bool monster::is_symbol_highlighted() const
 nc_color monster::color_with_effects() const
 {
     nc_color ret = type->color;
-    if (has_effect("beartrap") || has_effect("stunned") || has_effect("downed") || has_effect("tied") ||
-          has_effect("lightsnare") || has_effect("heavysnare")) {
+    if (has_effect( effect_beartrap ) || has_effect( effect_stunned ) || has_effect( effect_downed ) || has_effect( effect_tied ) ||
+          has_effect( effect_lightsnare ) || has_effect( effect_heavysnare )) {
         ret = hilite(ret);
     }
-    if (has_effect("pacified")) {
+    if (has_effect( effect_pacified )) {
         ret = invert_color(ret);
     }
-    if (has_effect("onfire")) {
+    if (has_effect( effect_onfire )) {
         ret = red_background(ret);
     }
     return ret;
@@ -368,12 +385,12 @@ bool monster::has_flag(const m_flag f) const
 
 bool monster::can_see() const
 {
- return has_flag(MF_SEES) && !has_effect("blind");
+ return has_flag(MF_SEES) && !has_effect( effect_blind );
 }
 
 bool monster::can_hear() const
 {
- return has_flag(MF_HEARS) && !has_effect("deaf");
+ return has_flag(MF_HEARS) && !has_effect( effect_deaf );
 }
 
 bool monster::can_submerge() const
@@ -397,7 +414,7 @@ bool monster::can_act() const
 {
     return moves > 0 && !has_flag(MF_IMMOBILE) &&
         ( effects.empty() ||
-          ( !has_effect("stunned") && !has_effect("downed") && !has_effect("webbed") ) );
+          ( !has_effect( effect_stunned ) && !has_effect( effect_downed ) && !has_effect( effect_webbed ) ) );
 }
 
 int monster::sight_range( const int light_level ) const
@@ -495,7 +512,7 @@ Creature *monster::attack_target()
 
 bool monster::is_fleeing(player &u) const
 {
- if (has_effect("run"))
+ if (has_effect( effect_run ))
   return true;
  monster_attitude att = attitude(&u);
  return (att == MATT_FLEE ||
@@ -559,10 +576,10 @@ monster_attitude monster::attitude(player *u) const
             return MATT_FRIEND;
         }
     }
-    if (has_effect("run")) {
+    if (has_effect( effect_run )) {
         return MATT_FLEE;
     }
-    if (has_effect("pacified")) {
+    if (has_effect( effect_pacified )) {
         return MATT_ZLAVE;
     }
 
@@ -1007,17 +1024,17 @@ void monster::die_in_explosion(Creature* source)
 bool monster::move_effects()
 {
     bool u_see_me = g->u.sees(*this);
-    if (has_effect("tied")) {
+    if (has_effect( effect_tied )) {
         return false;
     }
-    if (has_effect("downed")) {
+    if (has_effect( effect_downed )) {
         remove_effect("downed");
         if (u_see_me) {
             add_msg(_("The %s climbs to it's feet!"), name().c_str());
         }
         return false;
     }
-    if (has_effect("webbed")) {
+    if (has_effect( effect_webbed )) {
         if (x_in_y(type->melee_dice * type->melee_sides, 6 * get_effect_int("webbed"))) {
             if (u_see_me) {
                 add_msg(_("The %s breaks free of the webs!"), name().c_str());
@@ -1026,7 +1043,7 @@ bool monster::move_effects()
         }
         return false;
     }
-    if (has_effect("lightsnare")) {
+    if (has_effect( effect_lightsnare )) {
         if(x_in_y(type->melee_dice * type->melee_sides, 12)) {
             remove_effect("lightsnare");
             g->m.spawn_item(posx(), posy(), "string_36");
@@ -1037,7 +1054,7 @@ bool monster::move_effects()
         }
         return false;
     }
-    if (has_effect("heavysnare")) {
+    if (has_effect( effect_heavysnare )) {
         if (type->melee_dice * type->melee_sides >= 7) {
             if(x_in_y(type->melee_dice * type->melee_sides, 32)) {
                 remove_effect("heavysnare");
@@ -1050,7 +1067,7 @@ bool monster::move_effects()
         }
         return false;
     }
-    if (has_effect("beartrap")) {
+    if (has_effect( effect_beartrap )) {
         if (type->melee_dice * type->melee_sides >= 18) {
             if(x_in_y(type->melee_dice * type->melee_sides, 200)) {
                 remove_effect("beartrap");
@@ -1062,7 +1079,7 @@ bool monster::move_effects()
         }
         return false;
     }
-    if (has_effect("crushed")) {
+    if (has_effect( effect_crushed )) {
         // Strength helps in getting free, but dex also helps you worm your way out of the rubble
         if(x_in_y(type->melee_dice * type->melee_sides, 100)) {
             remove_effect("crushed");
@@ -1075,7 +1092,7 @@ bool monster::move_effects()
 
     // If we ever get more effects that force movement on success this will need to be reworked to
     // only trigger success effects if /all/ rolls succeed
-    if (has_effect("in_pit")) {
+    if (has_effect( effect_in_pit )) {
         if (rng(0, 40) > type->melee_dice * type->melee_sides) {
             return false;
         } else {
@@ -1119,7 +1136,7 @@ int monster::get_armor_bash(body_part bp) const
 
 int monster::hit_roll() const {
     //Unstable ground chance of failure
-    if (has_effect("bouldering")) {
+    if (has_effect( effect_bouldering )) {
         if(one_in(type->melee_skill)) {
             return 0;
         }
@@ -1130,11 +1147,11 @@ int monster::hit_roll() const {
 
 int monster::get_dodge() const
 {
-    if (has_effect("downed")) {
+    if (has_effect( effect_downed )) {
         return 0;
     }
     int ret = type->sk_dodge;
-    if (has_effect("lightsnare") || has_effect("heavysnare") || has_effect("beartrap") || has_effect("tied")) {
+    if (has_effect( effect_lightsnare ) || has_effect( effect_heavysnare ) || has_effect( effect_beartrap ) || has_effect( effect_tied )) {
         ret /= 2;
     }
     if (moves <= 0 - 100 - get_speed()) {
@@ -1150,7 +1167,7 @@ int monster::get_melee() const
 
 int monster::dodge_roll()
 {
-    if (has_effect("bouldering")) {
+    if (has_effect( effect_bouldering )) {
         if(one_in(type->sk_dodge)) {
             return 0;
         }
@@ -1342,19 +1359,19 @@ void monster::die(Creature* nkiller) {
         }
     }
     // We were tied up at the moment of death, add a short rope to inventory
-    if ( has_effect("tied") ) {
+    if ( has_effect( effect_tied ) ) {
         item rope_6("rope_6", 0);
         add_item(rope_6);
     }
-    if( has_effect( "lightsnare" ) ) {
+    if( has_effect( effect_lightsnare ) ) {
         add_item( item( "string_36", 0 ) );
         add_item( item( "snare_trigger", 0 ) );
     }
-    if( has_effect( "heavysnare" ) ) {
+    if( has_effect( effect_heavysnare ) ) {
         add_item( item( "rope_6", 0 ) );
         add_item( item( "snare_trigger", 0 ) );
     }
-    if( has_effect( "beartrap" ) ) {
+    if( has_effect( effect_beartrap ) ) {
         add_item( item( "beartrap", 0 ) );
     }
 
@@ -1439,33 +1456,30 @@ void monster::process_effects()
 {
     // Monster only effects
     int mod = 1;
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            // Monsters don't get trait-based reduction, but they do get effect based reduction
-            bool reduced = has_effect(it.get_resist_effect());
-
-            mod_speed_bonus(it.get_mod("SPEED", reduced));
-
-            int val = it.get_mod("HURT", reduced);
-            if (val > 0) {
-                if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
-                    apply_damage(nullptr, bp_torso, val);
-                }
-            }
+    for( auto &it : effects ) {
+        // Monsters don't get trait-based reduction, but they do get effect based reduction
+        bool reduced = has_effect(it.get_resist_effect());
 
-            std::string id = _effect_it.second.get_id();
-            // MATERIALS-TODO: use fire resistance
-            if (id == "onfire") {
-                if (made_of("flesh") || made_of("iflesh"))
-                    apply_damage( nullptr, bp_torso, rng( 3, 8 ) );
-                if (made_of("veggy"))
-                    apply_damage( nullptr, bp_torso, rng( 10, 20 ) );
-                if (made_of("paper") || made_of("powder") || made_of("wood") || made_of("cotton") ||
-                    made_of("wool"))
-                    apply_damage( nullptr, bp_torso, rng( 15, 40 ) );
+        mod_speed_bonus(it.get_mod("SPEED", reduced));
+
+        int val = it.get_mod("HURT", reduced);
+        if (val > 0) {
+            if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
+                apply_damage(nullptr, bp_torso, val);
             }
         }
+
+        std::string id = it.get_id();
+        // MATERIALS-TODO: use fire resistance
+        if (id == "onfire") {
+            if (made_of("flesh") || made_of("iflesh"))
+                apply_damage( nullptr, bp_torso, rng( 3, 8 ) );
+            if (made_of("veggy"))
+                apply_damage( nullptr, bp_torso, rng( 10, 20 ) );
+            if (made_of("paper") || made_of("powder") || made_of("wood") || made_of("cotton") ||
+                made_of("wool"))
+                apply_damage( nullptr, bp_torso, rng( 15, 40 ) );
+        }
     }
 
     //If this monster has the ability to heal in combat, do it now.
@@ -389,7 +389,7 @@ int player::create(character_type type, std::string tempname)
         tmp = tmp.in_its_container();
         if(tmp.is_armor()) {
             if(tmp.has_flag("VARSIZE")) {
-                tmp.item_tags.insert("FIT");
+                tmp.set_flag("FIT");
             }
             // If wearing an item fails we fail silently.
             wear_item(&tmp, false);
@@ -401,7 +401,7 @@ int player::create(character_type type, std::string tempname)
                     tmp2.set_snippet( itd.snippet_id );
                 }
                 if(tmp2.has_flag("VARSIZE")) {
-                    tmp2.item_tags.insert("FIT");
+                    tmp2.set_flag("FIT");
                 }
                 // If wearing an item fails we fail silently.
                 wear_item(&tmp2, false);
@@ -31,6 +31,7 @@ npc::npc()
  mapz = 0;
  position.x = -1;
  position.y = -1;
+ npc_position_generation++;
  wandx = 0;
  wandy = 0;
  wandf = 0;
@@ -802,7 +803,7 @@ std::vector<item> starting_clothes( npc_class type, bool male )
     for( auto it = ret.begin(); it != ret.end(); ) {
         if( !it->is_null() && it->is_armor() ) {
             if( one_in( 3 ) && it->has_flag( "VARSIZE" ) ) {
-                it->item_tags.insert( "FIT" );
+                it->set_flag( "FIT" );
             }
             ++it;
         } else {
@@ -859,7 +860,7 @@ std::list<item> starting_inv(npc *me, npc_class type)
         continue;
     }
     if( one_in( 3 ) && tmpitem.has_flag( "VARSIZE" ) ) {
-        tmpitem.item_tags.insert( "FIT" );
+        tmpitem.set_flag( "FIT" );
     }
     if (total_space >= tmpitem.volume()) {
         ret.push_back(tmpitem);
@@ -884,6 +885,7 @@ void npc::spawn_at(int x, int y, int z)
     mapz = z;
     position.x = rng(0, SEEX - 1);
     position.y = rng(0, SEEY - 1);
+    npc_position_generation++;
     const point pos_om = overmapbuffer::sm_to_om_copy( mapx, mapy );
     overmap &om = overmap_buffer.get( pos_om.x, pos_om.y );
     om.npcs.push_back(this);
@@ -925,6 +927,7 @@ void npc::place_on_map()
     mapy -= dmy;
     position.x += dmx * SEEX; // value of "mapx * SEEX + posx()" is unchanged
     position.y += dmy * SEEY;
+    npc_position_generation++;
 
     // Places the npc at the nearest empty spot near (posx(), posy()).
     // Searches in a spiral pattern for a suitable location.
@@ -944,6 +947,7 @@ void npc::place_on_map()
     //place the npc at the free spot.
     position.x += x;
     position.y += y;
+    npc_position_generation++;
 }
 
 const Skill* npc::best_skill() const
@@ -2026,6 +2030,7 @@ void npc::shift(int sx, int sy)
 {
     position.x -= sx * SEEX;
     position.y -= sy * SEEY;
+    npc_position_generation++;
     const point pos_om_old = overmapbuffer::sm_to_om_copy( mapx, mapy );
     mapx += sx;
     mapy += sy;
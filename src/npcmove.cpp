@@ -1101,6 +1101,7 @@ void npc::move_to(int x, int y)
         if (g->m.move_cost(x, y) > 0) {
             position.x = x;
             position.y = y;
+            npc_position_generation++;
             bool diag = trigdist && posx() != x && posy() != y;
             moves -= run_cost(g->m.combined_movecost(posx(), posy(), x, y), diag);
             int part;
@@ -1326,26 +1327,34 @@ void npc::find_item()
         maxy = SEEY * MAPSIZE - 1;
     }
 
-    for (int x = minx; x <= maxx; x++) {
-        for (int y = miny; y <= maxy; y++) {
-            if (sees(x, y) && g->m.sees_some_items(x, y, *this)) {
-                for( auto &elem : g->m.i_at(x, y) ) {
-                    if( elem.made_of( LIQUID ) ) {
-                        // Don't even consider liquids.
-                        continue;
-                    }
-                    int itval = value( elem );
-                    int wgt = elem.weight(), vol = elem.volume();
-                    if( itval > best_value &&
-                        //(itval > worst_item_value ||
-                        ( can_pickWeight( wgt, true ) && can_pickVolume( vol, true ) ) ) {
-                        itx = x;
-                        ity = y;
-                        wanted = &( elem );
-                        best_value = itval;
-                        fetching_item = true;
-                    }
-                }
+    // Only squares with items matter, the shadowcast field of view is cheaper than
+    // a line of sight check for each of them.
+    const std::vector<point> candidates = g->m.points_with_items( minx, miny, maxx, maxy );
+    if( candidates.empty() ) {
+        return;
+    }
+    bool fov[MAPSIZE * SEEX][MAPSIZE * SEEY] {};
+    g->m.build_fov_cache( fov, posx(), posy(), range );
+
+    for( const point &p : candidates ) {
+        if( !fov[p.x][p.y] || !g->m.could_see_items( p.x, p.y, *this ) ) {
+            continue;
+        }
+        for( auto &elem : g->m.i_at( p.x, p.y ) ) {
+            if( elem.made_of( LIQUID ) ) {
+                // Don't even consider liquids.
+                continue;
+            }
+            int itval = value( elem );
+            int wgt = elem.weight(), vol = elem.volume();
+            if( itval > best_value &&
+                //(itval > worst_item_value ||
+                ( can_pickWeight( wgt, true ) && can_pickVolume( vol, true ) ) ) {
+                itx = p.x;
+                ity = p.y;
+                wanted = &( elem );
+                best_value = itval;
+                fetching_item = true;
             }
         }
     }
@@ -13,10 +13,12 @@
 #endif // SDLTILES
 
 #include <stdlib.h>
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <locale>
 #include <sstream>
+#include <climits>
 
 bool trigdist;
 bool use_tiles;
@@ -34,6 +36,94 @@ std::map<int, std::vector<std::string> > mPageItems;
 std::map<std::string, int> mOptionsSort;
 std::map<std::string, std::string> optionNames;
 int iWorldOptPage;
+unsigned options_generation = 0;
+
+static std::vector<std::function<void()>> &options_listeners()
+{
+    static std::vector<std::function<void()>> listeners;
+    return listeners;
+}
+
+void add_options_listener( std::function<void()> listener )
+{
+    options_listeners().push_back( listener );
+}
+
+void options_changed()
+{
+    options_generation++;
+    for( auto &listener : options_listeners() ) {
+        listener();
+    }
+}
+
+static std::vector<const option_handle_base *> &option_handles()
+{
+    static std::vector<const option_handle_base *> handles;
+    return handles;
+}
+
+option_handle_base::option_handle_base()
+{
+    option_handles().push_back( this );
+}
+
+option_handle_base::option_handle_base( const option_handle_base & )
+{
+    option_handles().push_back( this );
+}
+
+option_handle_base::~option_handle_base()
+{
+    auto &handles = option_handles();
+    handles.erase( std::remove( handles.begin(), handles.end(), this ), handles.end() );
+}
+
+void refresh_option_handles()
+{
+    for( auto handle : option_handles() ) {
+        handle->refresh();
+    }
+}
+
+static void get_option_value( cOpt &opt, bool &value )
+{
+    value = static_cast<bool>( opt );
+}
+
+static void get_option_value( cOpt &opt, int &value )
+{
+    value = static_cast<int>( opt );
+}
+
+static void get_option_value( cOpt &opt, float &value )
+{
+    value = static_cast<float>( opt );
+}
+
+static void get_option_value( cOpt &opt, std::string &value )
+{
+    value = opt.getValue();
+}
+
+template<typename T>
+void option_handle<T>::update() const
+{
+    // find instead of operator[], so a missing option is not inserted as a side effect.
+    auto &options = world_option ? ACTIVE_WORLD_OPTIONS : OPTIONS;
+    const auto iter = options.find( name );
+    if( iter == options.end() ) {
+        value = T();
+    } else {
+        get_option_value( iter->second, value );
+    }
+    generation = options_generation;
+}
+
+template class option_handle<bool>;
+template class option_handle<int>;
+template class option_handle<float>;
+template class option_handle<std::string>;
 
 options_data::options_data()
 {
@@ -179,6 +269,9 @@ bool cOpt::is_hidden()
         return false;
 #endif
 
+    case COPT_ALWAYS_HIDE:
+        return true;
+
     case COPT_POSIX_CURSES_HIDE:
         // Check if we on windows and using wincuses.
 #if ((defined TILES && defined SDLTILES) || defined _WIN32 || defined WINDOWS)
@@ -307,6 +400,7 @@ int cOpt::getItemPos(const std::string sSearch)
 //set to next item
 void cOpt::setNext()
 {
+    options_generation++;
     if (sType == "string") {
         int iNext = getItemPos(sSet) + 1;
         if (iNext >= (int)vItems.size()) {
@@ -335,6 +429,7 @@ void cOpt::setNext()
 //set to prev item
 void cOpt::setPrev()
 {
+    options_generation++;
     if (sType == "string") {
         int iPrev = getItemPos(sSet) - 1;
         if (iPrev < 0) {
@@ -363,6 +458,7 @@ void cOpt::setPrev()
 //set value
 void cOpt::setValue(float fSetIn)
 {
+    options_generation++;
     if (sType != "float") {
         debugmsg("tried to set a float value to a %s option", sType.c_str());
         return;
@@ -376,6 +472,7 @@ void cOpt::setValue(float fSetIn)
 //set value
 void cOpt::setValue(std::string sSetIn)
 {
+    options_generation++;
     if (sType == "string") {
         if (getItemPos(sSetIn) != -1) {
             sSet = sSetIn;
@@ -456,6 +553,7 @@ void initOptions()
 {
     OPTIONS.clear();
     ACTIVE_WORLD_OPTIONS.clear();
+    options_generation++;
     vPages.clear();
     mPageItems.clear();
     mOptionsSort.clear();
@@ -550,6 +648,11 @@ void initOptions()
                                        0, 127, 5
                                       );
 
+    OPTIONS["MAP_MEMORY_BUDGET"] = cOpt("general", _("Map memory budget"),
+                                        _("Approximate number of megabytes of map data (overmaps and submaps) to keep in memory. Map data outside of the reality bubble beyond that is saved and unloaded, least recently used first. 0 keeps everything until the game is saved."),
+                                        0, 4096, 0
+                                       );
+
     mOptionsSort["general"]++;
 
     OPTIONS["CIRCLEDIST"] = cOpt("general", _("Circular distances"),
@@ -970,6 +1073,12 @@ void initOptions()
                                    true
                                   );
 
+    // Chosen when the world is first used, see worldfactory::set_active_world.
+    OPTIONS["WORLD_SEED"] = cOpt("world_default", _("World seed"),
+                                 _("Seed of the random numbers used in this world, 0 picks a new one."),
+                                 0, INT_MAX, 0, COPT_ALWAYS_HIDE
+                                );
+
     for (unsigned i = 0; i < vPages.size(); ++i) {
         mPageItems[i].resize(mOptionsSort[vPages[i].first]);
     }
@@ -1312,6 +1421,9 @@ void show_options(bool ingame)
         g->mmenu_refresh_motd();
         g->mmenu_refresh_credits();
     }
+    if( bStuffChanged ) {
+        options_changed();
+    }
 #ifdef SDLTILES
     if( used_tiles_changed ) {
         //try and keep SDL calls limited to source files that deal specifically with them
@@ -1379,6 +1491,7 @@ void load_options()
 
     trigdist = OPTIONS["CIRCLEDIST"]; // cache to global due to heavy usage.
     use_tiles = OPTIONS["USE_TILES"]; // cache to global due to heavy usage.
+    options_changed();
 }
 
 std::string options_header()
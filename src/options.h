@@ -5,13 +5,15 @@
 #include <map>
 #include <unordered_map>
 #include <vector>
+#include <functional>
 #include <algorithm> //atoi
 
 enum copt_hide_t {
     COPT_NO_HIDE,
     COPT_SDL_HIDE,
     COPT_CURSES_HIDE,
-    COPT_POSIX_CURSES_HIDE
+    COPT_POSIX_CURSES_HIDE,
+    COPT_ALWAYS_HIDE // Stored, but never shown in the options menus
 };
 
 class options_data
@@ -131,6 +133,85 @@ extern std::map<int, std::vector<std::string> > mPageItems;
 extern int iWorldOptPage;
 
 extern options_data optionsdata;
+
+/**
+ * Incremented whenever an option changes (including replacing the world options),
+ * the cached values in @ref option_handle are compared against it.
+ */
+extern unsigned options_generation;
+/**
+ * Registers a function that is called after the options have been changed in the options
+ * menu or have been loaded, for caches that depend on them.
+ */
+void add_options_listener( std::function<void()> listener );
+/** Bumps @ref options_generation and calls all the listeners, see @ref add_options_listener. */
+void options_changed();
+
+/** The part of @ref option_handle that does not depend on the type. */
+class option_handle_base
+{
+    public:
+        option_handle_base();
+        option_handle_base( const option_handle_base & );
+        virtual ~option_handle_base();
+
+        /** Look the option up again if it has changed since the last access. */
+        virtual void refresh() const = 0;
+};
+
+/**
+ * Refreshes all option handles. Updating a handle writes to it, so threads that read
+ * options through handles may only run after this has been called, and options must
+ * not change until they are done.
+ */
+void refresh_option_handles();
+
+/**
+ * Typed access to an option, meant to be kept as a static:
+ * static const option_handle<bool> auto_pickup( "AUTO_PICKUP" );
+ * The option is only looked up again after an option has changed, reading it is otherwise
+ * as cheap as reading a variable. T must be bool, int, float or std::string (the value of
+ * a "string" option). If world_option is true, the option is taken from
+ * @ref ACTIVE_WORLD_OPTIONS. A missing option yields T().
+ */
+template<typename T>
+class option_handle : public option_handle_base
+{
+    public:
+        option_handle( const std::string &name, bool world_option = false ) :
+            name( name ), world_option( world_option ), value(),
+            generation( options_generation - 1 ) {
+        }
+
+        const T &get() const {
+            if( generation != options_generation ) {
+                update();
+            }
+            return value;
+        }
+        operator const T &() const {
+            return get();
+        }
+        bool operator==( const T &other ) const {
+            return get() == other;
+        }
+        bool operator!=( const T &other ) const {
+            return get() != other;
+        }
+
+        void refresh() const override {
+            get();
+        }
+
+    private:
+        void update() const;
+
+        std::string name;
+        bool world_option;
+        mutable T value;
+        mutable unsigned generation;
+};
+
 void initOptions();
 void load_options();
 void save_options(bool ingame = false);
@@ -1427,7 +1427,8 @@ void draw_scrollbar(WINDOW *window, const int iCurrentLine, const int iContentHe
 void calcStartPos(int &iStartPos, const int iCurrentLine, const int iContentHeight,
                   const int iNumEntries)
 {
-    if( OPTIONS["MENU_SCROLL"] ) {
+    static const option_handle<bool> opt_menu_scroll( "MENU_SCROLL" );
+    if( opt_menu_scroll ) {
         if (iNumEntries > iContentHeight) {
             iStartPos = iCurrentLine - (iContentHeight - 1) / 2;
 
@@ -1470,7 +1471,8 @@ void hit_animation(int iX, int iY, nc_color cColor, const std::string &cTile)
     mvwprintz(w_hit, 0, 0, cColor, "%s", cTile.c_str());
     wrefresh(w_hit);
 
-    timeout(static_cast<int>(OPTIONS["ANIMATION_DELAY"]));
+    static const option_handle<int> opt_animation_delay( "ANIMATION_DELAY" );
+    timeout(opt_animation_delay);
     getch(); //using this, because holding down a key with nanosleep can get yourself killed
     timeout(-1);
 }
@@ -1752,7 +1754,8 @@ void scrollingcombattext::add(const int p_iPosX, const int p_iPosY, direction p_
                               const std::string p_sText2, const game_message_type p_gmt2,
                               const std::string p_sType)
 {
-    if (OPTIONS["ANIMATION_SCT"]) {
+    static const option_handle<bool> opt_animation_sct( "ANIMATION_SCT" );
+    if (opt_animation_sct) {
         int iCurStep = 0;
 
         if (p_sType == "hp") {
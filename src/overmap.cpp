@@ -20,6 +20,7 @@
 #include "input.h"
 #include "json.h"
 #include <queue>
+#include <climits>
 #include "mapdata.h"
 #include "mapgen.h"
 #include "uistate.h"
@@ -650,10 +651,11 @@ oter_id &overmap::ter(const int x, const int y, const int z)
         return nullret;
     }
 
+    dirty = true;
     return layer[z + OVERMAP_DEPTH].terrain[x][y];
 }
 
-const oter_id overmap::get_ter(const int x, const int y, const int z) const
+const oter_id &overmap::get_ter(const int x, const int y, const int z) const
 {
 
     if (x < 0 || x >= OMAPX || y < 0 || y >= OMAPY || z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT) {
@@ -669,6 +671,7 @@ bool &overmap::seen(int x, int y, int z)
         nullbool = false;
         return nullbool;
     }
+    dirty = true;
     return layer[z + OVERMAP_DEPTH].visible[x][y];
 }
 
@@ -678,6 +681,7 @@ bool &overmap::explored(int x, int y, int z)
         nullbool = false;
         return nullbool;
     }
+    dirty = true;
     return layer[z + OVERMAP_DEPTH].explored[x][y];
 }
 
@@ -689,6 +693,14 @@ bool overmap::is_explored(int const x, int const y, int const z) const
     return layer[z + OVERMAP_DEPTH].explored[x][y];
 }
 
+bool overmap::is_seen(int const x, int const y, int const z) const
+{
+    if (x < 0 || x >= OMAPX || y < 0 || y >= OMAPY || z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT) {
+        return false;
+    }
+    return layer[z + OVERMAP_DEPTH].visible[x][y];
+}
+
 bool overmap::has_note(int const x, int const y, int const z) const
 {
     if (z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT) {
@@ -731,6 +743,7 @@ void overmap::add_note(int const x, int const y, int const z, std::string messag
         return n.x == x && n.y == y;
     });
 
+    dirty = true;
     if (it == std::end(notes)) {
         notes.emplace_back(om_note {std::move(message), x, y});
     } else if (!message.empty()) {
@@ -1219,7 +1232,7 @@ std::vector<point> overmap::find_terrain(const std::string &term, int zlevel)
     for (int x = 0; x < OMAPX; x++) {
         for (int y = 0; y < OMAPY; y++) {
             if (seen(x, y, zlevel) &&
-                lcmatch( otermap[ter(x, y, zlevel)].name, term ) ) {
+                lcmatch( otermap[get_ter(x, y, zlevel)].name, term ) ) {
                 found.push_back( point( get_left_border() + x, get_top_border() + y) );
             }
         }
@@ -1278,6 +1291,54 @@ std::tuple<char, nc_color, size_t> get_note_display_info(std::string const &note
     return result;
 }
 
+/** Flags used by @ref overmap::mark_occupancy. */
+enum overmap_marker : unsigned char {
+    MARKER_NOTE = 1,
+    MARKER_NPC = 2,
+    MARKER_HORDE = 4,
+    MARKER_VEHICLE = 8
+};
+
+void overmap::mark_occupancy( std::vector<unsigned char> &markers, int const x, int const y,
+                              int const width, int const height, int const z ) const
+{
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return;
+    }
+    const int base_x = loc.x * OMAPX;
+    const int base_y = loc.y * OMAPY;
+    // Takes coordinates local to this overmap, like the has_* functions of the overmapbuffer.
+    const auto mark = [&]( int const omx, int const omy, overmap_marker const flag ) {
+        const int i = base_x + omx - x;
+        const int j = base_y + omy - y;
+        if( omx >= 0 && omx < OMAPX && omy >= 0 && omy < OMAPY &&
+            i >= 0 && i < width && j >= 0 && j < height ) {
+            markers[i * height + j] |= flag;
+        }
+    };
+
+    for( auto &note : layer[z + OVERMAP_DEPTH].notes ) {
+        mark( note.x, note.y, MARKER_NOTE );
+    }
+    for( auto &n : npcs ) {
+        const tripoint pos = n->global_omt_location();
+        if( pos.z == z ) {
+            mark( pos.x - base_x, pos.y - base_y, MARKER_NPC );
+        }
+    }
+    for( auto &group : zg ) {
+        // Groups are stored by submap, two per overmap terrain tile in each direction.
+        if( group.first.z == z && group.second.horde && group.second.population > 0 ) {
+            mark( group.first.x / 2, group.first.y / 2, MARKER_HORDE );
+        }
+    }
+    if( z == 0 ) {
+        for( auto &v : vehicles ) {
+            mark( v.second.x, v.second.y, MARKER_VEHICLE );
+        }
+    }
+}
+
 void overmap::draw(WINDOW *w, WINDOW *wbar, const tripoint &center,
                    const tripoint &orig, bool blink, bool show_explored,
                    input_context *inp_ctxt,
@@ -1334,6 +1395,21 @@ void overmap::draw(WINDOW *w, WINDOW *wbar, const tripoint &center,
     int const offset_x = cursx - (om_map_width  / 2);
     int const offset_y = cursy - (om_map_height / 2);
 
+    std::vector<unsigned char> markers( om_map_width * om_map_height, 0 );
+    const point om_min = overmapbuffer::omt_to_om_copy( offset_x, offset_y );
+    const point om_max = overmapbuffer::omt_to_om_copy( offset_x + om_map_width - 1,
+                                                        offset_y + om_map_height - 1 );
+    for( int x = om_min.x; x <= om_max.x; x++ ) {
+        for( int y = om_min.y; y <= om_max.y; y++ ) {
+            const overmap *om = overmap_buffer.get_existing( x, y );
+            if( om != nullptr ) {
+                om->mark_occupancy( markers, offset_x, offset_y, om_map_width, om_map_height, z );
+            }
+        }
+    }
+    // Vehicles are only shown with a PDA, see overmapbuffer::has_vehicle.
+    const bool has_pda = g->u.has_pda();
+
     for (int i = 0; i < om_map_width; ++i) {
         for (int j = 0; j < om_map_height; ++j) {
             const int omx = i + offset_x;
@@ -1342,13 +1418,14 @@ void overmap::draw(WINDOW *w, WINDOW *wbar, const tripoint &center,
             const bool see = overmap_buffer.seen(omx, omy, z);
             if (see) {
                 // Only load terrain if we can actually see it
-                cur_ter = overmap_buffer.ter(omx, omy, z);
+                cur_ter = overmap_buffer.get_ter(omx, omy, z);
             }
 
             // Check if location is within player line-of-sight
             const bool los = see && g->u.overmap_los(omx, omy, sight_points);
 
             tripoint const cur_pos {omx, omy, z};
+            const unsigned char marker = markers[i * om_map_height + j];
 
             if (blink && cur_pos == orig) {
                 // Display player pos, should always be visible
@@ -1359,7 +1436,7 @@ void overmap::draw(WINDOW *w, WINDOW *wbar, const tripoint &center,
                 // Mission target, display always, player should know where it is anyway.
                 ter_color = c_red;
                 ter_sym   = '*';
-            } else if (blink && overmap_buffer.has_note(cur_pos)) {
+            } else if (blink && (marker & MARKER_NOTE)) {
                 // Display notes in all situations, even when not seen
                 std::tie(ter_sym, ter_color, std::ignore) =
                     get_note_display_info(overmap_buffer.note(cur_pos));
@@ -1368,15 +1445,15 @@ void overmap::draw(WINDOW *w, WINDOW *wbar, const tripoint &center,
                 ter_color = c_dkgray;
                 ter_sym   = '#';
                 // All cases below assume that see is true.
-            } else if (blink && overmap_buffer.has_npc(omx, omy, z)) {
+            } else if (blink && (marker & MARKER_NPC)) {
                 // Display NPCs only when player can see the location
                 ter_color = c_pink;
                 ter_sym   = '@';
-            } else if (blink && los && overmap_buffer.has_horde(omx, omy, z)) {
+            } else if (blink && los && (marker & MARKER_HORDE)) {
                 // Display Hordes only when within player line-of-sight
                 ter_color = c_green;
                 ter_sym   = 'Z';
-            } else if (blink && overmap_buffer.has_vehicle(omx, omy, z)) {
+            } else if (blink && has_pda && (marker & MARKER_VEHICLE)) {
                 // Display Vehicles only when player can see the location
                 ter_color = c_cyan;
                 ter_sym   = 'c';
@@ -1845,10 +1922,12 @@ void overmap::process_mongroups()
     for( auto it = zg.begin(); it != zg.end(); ) {
         mongroup &mg = it->second;
         if( mg.dying ) {
+            dirty = true;
             mg.population = (mg.population * 4) / 5;
             mg.radius = (mg.radius * 9) / 10;
         }
         if( mg.population <= 0 ) {
+            dirty = true;
             zg.erase( it++ );
         } else {
             ++it;
@@ -1865,10 +1944,10 @@ void mongroup::wander()
     interest = 30;
 }
 
-void overmap::move_hordes()
+void overmap::move_hordes( std::vector<mongroup> &leaving )
 {
     // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype(zg) tmpzg;
+    std::vector<mongroup> moved;
     //MOVE ZOMBIE GROUPS
     for( auto it = zg.begin(); it != zg.end(); ) {
         mongroup &mg = it->second;
@@ -1876,34 +1955,47 @@ void overmap::move_hordes()
             ++it;
             continue;
         }
-        if( rng(0, 100) < mg.interest ) {
-            // TODO: Adjust for monster speed.
-            // TODO: Handle moving to adjacent overmaps.
-            if( mg.posx > mg.tx) {
-                mg.posx--;
-            }
-            if( mg.posx < mg.tx) {
-                mg.posx++;
-            }
-            if( mg.posy > mg.ty) {
-                mg.posy--;
-            }
-            if( mg.posy < mg.ty) {
-                mg.posy++;
-            }
+        // Hordes change their interest or target even if they stay in place.
+        dirty = true;
+        // This used to re-roll rng( 0, 100 ) < interest until it succeeded, so every horde
+        // moves each time.
+        // TODO: Adjust for monster speed and interest.
+        const int oldx = mg.posx;
+        const int oldy = mg.posy;
+        if( mg.posx > mg.tx) {
+            mg.posx--;
+        }
+        if( mg.posx < mg.tx) {
+            mg.posx++;
+        }
+        if( mg.posy > mg.ty) {
+            mg.posy--;
+        }
+        if( mg.posy < mg.ty) {
+            mg.posy++;
+        }
 
-            if( mg.posx == mg.tx && mg.posy == mg.ty ) {
-                mg.wander();
-            } else {
-                mg.dec_interest( 1 );
-            }
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint, mongroup>( tripoint(mg.posx, mg.posy, mg.posz ), mg ) );
-            zg.erase( it++ );
+        if( mg.posx == mg.tx && mg.posy == mg.ty ) {
+            mg.wander();
+        } else {
+            mg.dec_interest( 1 );
         }
+        if( mg.posx == oldx && mg.posy == oldy ) {
+            ++it;
+            continue;
+        }
+        // Erase the group at it's old location, add the group with the new location
+        if( mg.posx >= 0 && mg.posy >= 0 && mg.posx < OMAPX * 2 && mg.posy < OMAPY * 2 ) {
+            moved.push_back( std::move( mg ) );
+        } else {
+            leaving.push_back( std::move( mg ) );
+        }
+        zg.erase( it++ );
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    for( auto &mg : moved ) {
+        zg.insert( std::make_pair( tripoint( mg.posx, mg.posy, mg.posz ), std::move( mg ) ) );
+    }
 }
 
 /**
@@ -1911,8 +2003,11 @@ void overmap::move_hordes()
 */
 void overmap::signal_hordes( const int x, const int y, const int sig_power)
 {
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
+    // zg is sorted by x first and the distance is at least the x distance, so only the
+    // groups with x - sig_power < posx < x + sig_power can hear the signal.
+    const auto end = zg.lower_bound( tripoint( x + sig_power, INT_MIN, INT_MIN ) );
+    for( auto it = zg.lower_bound( tripoint( x - sig_power + 1, INT_MIN, INT_MIN ) ); it != end; ++it ) {
+        mongroup &mg = it->second;
         if( !mg.horde ) {
             continue;
         }
@@ -1924,6 +2019,7 @@ void overmap::signal_hordes( const int x, const int y, const int sig_power)
             const int d_inter = (sig_power - dist) * 5;
             const int roll = rng( 0, mg.interest );
             if( roll < d_inter ) {
+                dirty = true;
                 const int targ_dist = rl_dist( x, y, mg.tx, mg.ty );
                 // TODO: Base this on targ_dist:dist ratio.
                 if (targ_dist < 5) {
@@ -3214,7 +3310,7 @@ void overmap::place_specials()
                                                                     0 ) ); // normal circumstances
             }
             else{
-                if (rand() % 100 <= special.min_occurrences){ //occurance is actually a % chance, so less than 1
+                if (rng(0, 99) <= special.min_occurrences){ //occurance is actually a % chance, so less than 1
                     num_placed.insert( std::pair<overmap_special, int>(
                         overmap_specials_it, -1 ) ); // Priority add one in this map
                 }
@@ -3556,7 +3652,9 @@ void overmap::open()
     if (fin.is_open()) {
         unserialize(fin, plrfilename, terfilename);
         fin.close();
+        dirty = false;
     } else { // No map exists!  Prepare neighbors, and generate one.
+        dirty = true;
         std::vector<const overmap*> pointers;
         // Fetch south and north
         for (int i = -1; i <= 1; i += 2) {
@@ -3567,6 +3665,8 @@ void overmap::open()
             pointers.push_back(overmap_buffer.get_existing(loc.x+i, loc.y));
         }
         // pointers looks like (north, south, west, east)
+        rng_stream stream( rng_location_seed( RNG_OVERMAP, loc.x, loc.y, 0 ) );
+        rng_stream_scope rng_scope( stream );
         generate(pointers[0], pointers[3], pointers[1], pointers[2]);
     }
 }
@@ -3813,6 +3913,7 @@ void regional_settings::setup()
 
 void overmap::add_mon_group(const mongroup &group)
 {
+    dirty = true;
     // Monster groups: the old system had large groups (radius > 1),
     // the new system transforms them into groups of radius 1, this also
     // makes the diffuse setting obsolete (as it only controls how the radius
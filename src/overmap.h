@@ -259,6 +259,13 @@ class overmap
     point const& pos() const { return loc; }
 
     void save() const;
+    /**
+     * Whether the overmap may differ from its save files, see @ref overmapbuffer::save.
+     * Set by everything that changes the overmap, including the non-const accessors like
+     * @ref ter and @ref seen. Overmaps with NPCs always need saving, the NPCs change all the time.
+     */
+    bool is_dirty() const { return dirty || !npcs.empty(); }
+    void set_dirty() { dirty = true; }
 
     /**
      * @return The (local) overmap terrain coordinates of a randomly
@@ -275,11 +282,12 @@ class overmap
     std::vector<point> find_terrain(const std::string &term, int zlevel);
 
     oter_id& ter(const int x, const int y, const int z);
-    const oter_id get_ter(const int x, const int y, const int z) const;
+    const oter_id &get_ter(const int x, const int y, const int z) const;
     bool&   seen(int x, int y, int z);
     bool&   explored(int x, int y, int z);
     bool is_road_or_highway(int x, int y, int z);
     bool is_explored(int const x, int const y, int const z) const;
+    bool is_seen(int const x, int const y, int const z) const;
 
     bool has_note(int x, int y, int z) const;
     std::string const& note(int x, int y, int z) const;
@@ -346,7 +354,7 @@ class overmap
 
      return settings;
   }
-    void clear_mon_groups() { zg.clear(); }
+    void clear_mon_groups() { zg.clear(); dirty = true; }
 private:
     std::multimap<tripoint, mongroup> zg;
 public:
@@ -360,6 +368,7 @@ public:
  private:
   friend class overmapbuffer;
   point loc;
+  bool dirty;
 
     std::array<map_layer, OVERMAP_LAYERS> layer;
 
@@ -390,8 +399,21 @@ public:
     int dist_from_city(point p);
     void signal_hordes( int x, int y, int sig_power );
     void process_mongroups();
-    void move_hordes();
+    /**
+     * Moves the hordes one step towards their target. Hordes that have left this overmap
+     * are removed and appended to leaving (still relative to this overmap), so
+     * @ref overmapbuffer::move_hordes can hand them over to the neighbouring overmap.
+     */
+    void move_hordes( std::vector<mongroup> &leaving );
 
+  /**
+   * Marks the notes, NPCs, hordes and vehicles of this overmap on z-level z in markers,
+   * a width by height grid of @ref overmap_marker flags (column major) whose first
+   * entry is at the global overmap terrain coordinates (x, y). Used by @ref draw,
+   * so it doesn't search the lists of the overmap for every tile of the window.
+   */
+  void mark_occupancy( std::vector<unsigned char> &markers, int x, int y, int width, int height,
+                       int z ) const;
   /**
    * Draws the overmap terrain.
    * @param w The window to draw in.
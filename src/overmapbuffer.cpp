@@ -3,6 +3,7 @@
 #include "overmapbuffer.h"
 #include "game.h"
 #include "monster.h"
+#include "debug.h"
 
 #include <fstream>
 #include <sstream>
@@ -18,6 +19,7 @@ inline int divide(int v, int m, int &r);
 
 overmapbuffer::overmapbuffer()
 : last_requested_overmap( nullptr )
+, access_clock( 0 )
 {
 }
 
@@ -51,6 +53,7 @@ overmap &overmapbuffer::get( const int x, const int y )
 
     auto const it = overmaps.find( p );
     if( it != overmaps.end() ) {
+        last_used[p] = ++access_clock;
         return *(last_requested_overmap = it->second.get());
     }
 
@@ -58,6 +61,7 @@ overmap &overmapbuffer::get( const int x, const int y )
     std::unique_ptr<overmap> new_om( new overmap( x, y ) );
     overmap &result = *new_om;
     overmaps[ new_om->pos() ] = std::move( new_om );
+    last_used[p] = ++access_clock;
     // Note: fix_mongroups might load other overmaps, so overmaps.back() is not
     // necessarily the overmap at (x,y)
     fix_mongroups( result );
@@ -74,6 +78,7 @@ void overmapbuffer::fix_mongroups(overmap &new_overmap)
         // transformed into spawn points on a submap, the group can then be removed
         if( mg.population <= 0 ) {
             new_overmap.zg.erase( it++ );
+            new_overmap.dirty = true;
             continue;
         }
         // Inside the bounds of the overmap?
@@ -93,22 +98,81 @@ void overmapbuffer::fix_mongroups(overmap &new_overmap)
         overmap &om = get( omp.x, omp.y );
         mg.posx = smabs.x;
         mg.posy = smabs.y;
+        // The target is relative to the overmap, too.
+        mg.tx += ( new_overmap.pos().x - omp.x ) * OMAPX * 2;
+        mg.ty += ( new_overmap.pos().y - omp.y ) * OMAPY * 2;
         om.add_mon_group( mg );
         new_overmap.zg.erase( it++ );
+        new_overmap.dirty = true;
     }
 }
 
 void overmapbuffer::save()
 {
     for( auto &omp : overmaps ) {
+        if( !omp.second->is_dirty() ) {
+            continue;
+        }
         // Note: this may throw io errors from std::ofstream
         omp.second->save();
+        omp.second->dirty = false;
+    }
+}
+
+size_t overmapbuffer::enforce_budget( size_t max_bytes )
+{
+    const size_t max_overmaps = max_bytes / sizeof( overmap );
+    if( overmaps.size() <= max_overmaps ) {
+        return overmaps.size() * sizeof( overmap );
+    }
+    // The reality bubble may overlap up to four overmaps.
+    const tripoint abs_sub = g->m.get_abs_sub();
+    const point bubble_min = sm_to_om_copy( abs_sub.x, abs_sub.y );
+    const point bubble_max = sm_to_om_copy( abs_sub.x + MAPSIZE - 1, abs_sub.y + MAPSIZE - 1 );
+
+    std::vector<std::pair<unsigned, point>> candidates;
+    for( auto &omp : overmaps ) {
+        const point &p = omp.first;
+        if( p.x >= bubble_min.x && p.x <= bubble_max.x && p.y >= bubble_min.y && p.y <= bubble_max.y ) {
+            continue;
+        }
+        // The NPCs are referenced from game::active_npc and missions.
+        if( !omp.second->npcs.empty() ) {
+            continue;
+        }
+        candidates.push_back( std::make_pair( last_used[p], p ) );
     }
+    std::sort( candidates.begin(), candidates.end() );
+
+    for( auto &candidate : candidates ) {
+        if( overmaps.size() <= max_overmaps ) {
+            break;
+        }
+        auto const it = overmaps.find( candidate.second );
+        overmap &om = *it->second;
+        if( om.is_dirty() ) {
+            try {
+                om.save();
+            } catch( const std::exception &err ) {
+                // Keep it loaded, the next regular save will report the problem.
+                DebugLog( D_ERROR, D_GAME ) << "failed to save overmap " << candidate.second.x << "," <<
+                                            candidate.second.y << ": " << err.what();
+                continue;
+            }
+        }
+        if( last_requested_overmap == &om ) {
+            last_requested_overmap = nullptr;
+        }
+        overmaps.erase( it );
+        last_used.erase( candidate.second );
+    }
+    return overmaps.size() * sizeof( overmap );
 }
 
 void overmapbuffer::clear()
 {
     overmaps.clear();
+    last_used.clear();
     known_non_existing.clear();
     last_requested_overmap = NULL;
 }
@@ -142,6 +206,7 @@ overmap *overmapbuffer::get_existing(int x, int y)
     }
     auto const it = overmaps.find( p );
     if( it != overmaps.end() ) {
+        last_used[p] = ++access_clock;
         return last_requested_overmap = it->second.get();
     }
     if (known_non_existing.count(p) > 0) {
@@ -318,8 +383,37 @@ void overmapbuffer::move_hordes()
     // arbitrary radius to include nearby overmaps (aside from the current one)
     const auto radius = MAPSIZE * 2;
     const auto center = g->u.global_sm_location();
+    // Hordes that left their overmap, with the overmap they came from. They are only
+    // handed over after all overmaps have been processed, so none is moved twice.
+    std::vector<std::pair<overmap *, mongroup>> leaving;
+    std::vector<mongroup> tmp;
     for( auto &om : get_overmaps_near( center, radius ) ) {
-        om->move_hordes();
+        om->move_hordes( tmp );
+        for( auto &mg : tmp ) {
+            leaving.push_back( std::make_pair( om, std::move( mg ) ) );
+        }
+        tmp.clear();
+    }
+    for( auto &elem : leaving ) {
+        overmap &old_om = *elem.first;
+        mongroup &mg = elem.second;
+        const point old_origin = om_to_sm_copy( old_om.pos() );
+        point smabs( mg.posx + old_origin.x, mg.posy + old_origin.y );
+        const point omp = sm_to_om_remain( smabs );
+        // Don't generate new overmaps for wandering hordes, they stay outside the bounds of
+        // their old overmap until the neighbour gets generated, see fix_mongroups.
+        overmap *new_om = get_existing( omp.x, omp.y );
+        if( new_om != nullptr ) {
+            const point new_origin = om_to_sm_copy( new_om->pos() );
+            mg.posx = smabs.x;
+            mg.posy = smabs.y;
+            mg.tx += old_origin.x - new_origin.x;
+            mg.ty += old_origin.y - new_origin.y;
+        } else {
+            new_om = &old_om;
+        }
+        new_om->zg.insert( std::make_pair( tripoint( mg.posx, mg.posy, mg.posz ), std::move( mg ) ) );
+        new_om->dirty = true;
     }
 }
 
@@ -366,6 +460,7 @@ void overmapbuffer::move_vehicle( vehicle *veh, const point &old_msp )
     overmap &old_om = get_om_global( old_omt.x, old_omt.y );
     overmap &new_om = get_om_global( new_omt.x, new_omt.y );
     // *_omt is now local to the overmap, and it's in overmap terrain system
+    old_om.dirty = true;
     if( &old_om == &new_om ) {
         new_om.vehicles[veh->om_id].x = new_omt.x;
         new_om.vehicles[veh->om_id].y = new_omt.y;
@@ -380,6 +475,7 @@ void overmapbuffer::remove_vehicle( const vehicle *veh )
     const point omt = ms_to_omt_copy( veh->real_global_pos() );
     overmap &om = get_om_global( omt );
     om.vehicles.erase( veh->om_id );
+    om.dirty = true;
 }
 
 void overmapbuffer::add_vehicle( vehicle *veh )
@@ -392,6 +488,7 @@ void overmapbuffer::add_vehicle( vehicle *veh )
         id++;
     }
     om_vehicle &tracked_veh = om.vehicles[id];
+    om.dirty = true;
     tracked_veh.x = omt.x;
     tracked_veh.y = omt.y;
     tracked_veh.name = veh->name;
@@ -401,7 +498,7 @@ void overmapbuffer::add_vehicle( vehicle *veh )
 bool overmapbuffer::seen(int x, int y, int z)
 {
     const overmap *om = get_existing_om_global(x, y);
-    return (om != NULL) && const_cast<overmap*>(om)->seen(x, y, z);
+    return (om != NULL) && om->is_seen(x, y, z);
 }
 
 void overmapbuffer::set_seen(int x, int y, int z, bool seen)
@@ -421,6 +518,11 @@ oter_id& overmapbuffer::ter(int x, int y, int z) {
     return om.ter(x, y, z);
 }
 
+const oter_id& overmapbuffer::get_ter(int x, int y, int z) {
+    const overmap &om = get_om_global(x, y);
+    return om.get_ter(x, y, z);
+}
+
 bool overmapbuffer::reveal(const point &center, int radius, int z)
 {
     bool result = false;
@@ -685,6 +787,10 @@ void overmapbuffer::spawn_monster(const int x, const int y, const int z)
     overmap &om = get( omp.x, omp.y );
     const tripoint current_submap_loc( sm.x, sm.y, z );
     auto monster_bucket = om.monster_map.equal_range( current_submap_loc );
+    if( monster_bucket.first == monster_bucket.second ) {
+        return;
+    }
+    om.dirty = true;
     std::for_each( monster_bucket.first, monster_bucket.second,
                    [&](std::pair<const tripoint, monster> &monster_entry ) {
         monster &this_monster = monster_entry.second;
@@ -717,6 +823,7 @@ void overmapbuffer::despawn_monster(const monster &critter)
     // Store the monster using coordinates local to the overmap.
     // TODO: with Z-levels this should probably be taken from the critter
     om.monster_map.insert( std::make_pair( tripoint(sm.x, sm.y, g->get_levz()), critter ) );
+    om.dirty = true;
 }
 
 extern bool lcmatch(const std::string& text, const std::string& pattern);
@@ -99,13 +99,29 @@ public:
     overmap &get( const int x, const int y );
     void save();
     void clear();
+    /**
+     * Save and unload the least recently used overmaps until the loaded ones
+     * take at most max_bytes (roughly, only the fixed size of each overmap is
+     * counted). Overmaps that overlap the reality bubble or contain NPCs are kept.
+     * Pointers and references to overmaps become invalid, so this must only be
+     * called between turns.
+     * @return The estimated size of the overmaps that are still loaded.
+     */
+    size_t enforce_budget( size_t max_bytes );
 
     /**
      * Uses global overmap terrain coordinates, creates the
-     * overmap if needed.
+     * overmap if needed. The overmap is assumed to be changed through
+     * the reference, see @ref overmap::is_dirty. Use @ref get_ter to read it.
      */
     oter_id& ter(int x, int y, int z);
     oter_id& ter(const tripoint& p) { return ter(p.x, p.y, p.z); }
+    /**
+     * Uses global overmap terrain coordinates, creates the
+     * overmap if needed.
+     */
+    const oter_id& get_ter(int x, int y, int z);
+    const oter_id& get_ter(const tripoint& p) { return get_ter(p.x, p.y, p.z); }
     /**
      * Uses global overmap terrain coordinates.
      */
@@ -395,6 +411,12 @@ private:
     mutable std::set<point> known_non_existing;
     // Cached result of previous call to overmapbuffer::get_existing
     overmap mutable * last_requested_overmap;
+    /**
+     * Value of @ref access_clock when an overmap was last looked up (other than
+     * through @ref last_requested_overmap), used by @ref enforce_budget.
+     */
+    std::unordered_map<point, unsigned> last_used;
+    unsigned access_clock;
 
     /**
      * Get a list of notes in the (loaded) overmaps.
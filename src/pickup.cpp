@@ -210,22 +210,14 @@ static bool select_autopickup_items( std::vector<item> &here, std::vector<bool>
                 if (OPTIONS["AUTO_PICKUP_ZERO"]) {
                     if (here[i].volume() == 0 &&
                         here[i].weight() <= OPTIONS["AUTO_PICKUP_ZERO"] * 50 &&
-                        checkExcludeRules(sItemName)) {
+                        checkExcludeRules(sItemName, here[i].type)) {
                         bPickup = true;
                     }
                 }
 
                 //Check the Pickup Rules
-                if ( mapAutoPickupItems[sItemName] == "true" ) {
+                if ( checkPickupRules( sItemName, here[i].type ) ) {
                     bPickup = true;
-                } else if ( mapAutoPickupItems[sItemName] != "false" ) {
-                    //No prematched pickup rule found
-                    //items with damage, (fits) or a container
-                    createPickupRules(sItemName);
-
-                    if ( mapAutoPickupItems[sItemName] == "true" ) {
-                        bPickup = true;
-                    }
                 }
             }
 
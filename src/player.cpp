@@ -50,6 +50,12 @@ stats player_stats;
 
 static const itype_id OPTICAL_CLOAK_ITEM_ID( "optical_cloak" );
 
+// Effects that are checked every turn, see get_efftype_index.
+static const efftype_index effect_blind = get_efftype_index( "blind" );
+static const efftype_index effect_downed = get_efftype_index( "downed" );
+static const efftype_index effect_onfire = get_efftype_index( "onfire" );
+static const efftype_index effect_sleep = get_efftype_index( "sleep" );
+
 void game::init_morale()
 {
     std::string tmp_morale_data[NUM_MORALE_TYPES] = {
@@ -140,6 +146,8 @@ std::string morale_point::name() const
     return ret;
 }
 
+unsigned player::npc_position_generation = 1;
+
 player::player() : Character()
 {
  position.x = 0;
@@ -769,13 +777,13 @@ void player::update_bodytemp()
     if( veh ) {
         vehwindspeed = abs(veh->velocity / 100); // vehicle velocity in mph
     }
-    const oter_id &cur_om_ter = overmap_buffer.ter( global_omt_location() );
+    const oter_id &cur_om_ter = overmap_buffer.get_ter( global_omt_location() );
     std::string omtername = otermap[cur_om_ter].name;
     bool sheltered = g->is_sheltered(posx(), posy());
     int total_windpower = get_local_windpower(weather.windpower + vehwindspeed, omtername, sheltered);
     // Temperature norms
     // Ambient normal temperature is lower while asleep
-    int ambient_norm = (has_effect("sleep") ? 3100 : 1900);
+    int ambient_norm = (has_effect( effect_sleep ) ? 3100 : 1900);
     // This gets incremented in the for loop and used in the morale calculation
     int morale_pen = 0;
     const trap &trap_at_pos = g->m.tr_at(posx(), posy());
@@ -912,7 +920,7 @@ void player::update_bodytemp()
         // HUNGER
         temp_conv[i] -= hunger / 6 + 100;
         // FATIGUE
-        if( !has_effect("sleep") ) {
+        if( !has_effect( effect_sleep ) ) {
             temp_conv[i] -= std::max(0.0, 1.5 * fatigue);
         }
         // CONVECTION HEAT SOURCES (generates body heat, helps fight frostbite)
@@ -949,7 +957,7 @@ void player::update_bodytemp()
         // TILES
         int tile_strength = 0;
         // Being on fire increases very intensely the convergent temperature.
-        if (has_effect("onfire")) {
+        if (has_effect( effect_onfire )) {
             temp_conv[i] += 15000;
         }
         // Same with standing on fire.
@@ -1512,12 +1520,10 @@ void player::recalc_speed_bonus()
 
     mod_speed_bonus(stim > 40 ? 40 : stim);
 
-    for (auto maps : effects) {
-        for (auto i : maps.second) {
-            bool reduced = has_trait(i.second.get_resist_trait()) ||
-                            has_effect(i.second.get_resist_effect());
-            mod_speed_bonus(i.second.get_mod("SPEED", reduced));
-        }
+    for( auto &eff : effects ) {
+        bool reduced = has_trait(eff.get_resist_trait()) ||
+                        has_effect(eff.get_resist_effect());
+        mod_speed_bonus(eff.get_mod("SPEED", reduced));
     }
 
     // add martial arts speed bonus
@@ -1762,7 +1768,7 @@ bool player::digging() const {
 bool player::is_on_ground() const
 {
     bool on_ground = false;
-    if(has_effect("downed") || hp_cur[hp_leg_l] == 0 || hp_cur[hp_leg_r] == 0 ){
+    if(has_effect( effect_downed ) || hp_cur[hp_leg_l] == 0 || hp_cur[hp_leg_r] == 0 ){
         on_ground = true;
     }
     return  on_ground;
@@ -1789,7 +1795,7 @@ void player::set_underwater(bool u)
 
 nc_color player::basic_symbol_color() const
 {
-    if (has_effect("onfire")) {
+    if (has_effect( effect_onfire )) {
         return c_red;
     }
     if (has_effect("stunned")) {
@@ -1863,7 +1869,7 @@ void player::memorial( std::ofstream &memorial_file, std::string epitaph )
     }
 
     //Figure out the location
-    const oter_id &cur_ter = overmap_buffer.ter( global_omt_location() );
+    const oter_id &cur_ter = overmap_buffer.get_ter( global_omt_location() );
     std::string tername = otermap[cur_ter].name;
 
     //Were they in a town, or out in the wilderness?
@@ -2133,7 +2139,7 @@ void player::add_memorial_log(const char* male_msg, const char* female_msg, ...)
                                calendar::turn.days() + 1, calendar::turn.print_time().c_str()
                                );
 
-    const oter_id &cur_ter = overmap_buffer.ter( global_omt_location() );
+    const oter_id &cur_ter = overmap_buffer.get_ter( global_omt_location() );
     std::string location = otermap[cur_ter].name;
 
     std::stringstream log_message;
@@ -2260,13 +2266,11 @@ void player::disp_info()
             effect_text.push_back(dis_description(next_illness));
         }
     }
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            tmp = _effect_it.second.disp_name();
-            if (tmp != "") {
-                effect_name.push_back( tmp );
-                effect_text.push_back( _effect_it.second.disp_desc() );
-            }
+    for( auto &eff : effects ) {
+        tmp = eff.disp_name();
+        if (tmp != "") {
+            effect_name.push_back( tmp );
+            effect_text.push_back( eff.disp_desc() );
         }
     }
     if (abs(morale_level()) >= 100) {
@@ -2782,15 +2786,12 @@ Strength - 4;    Dexterity - 4;    Intelligence - 4;    Perception - 4"));
 
     std::map<std::string, int> speed_effects;
     std::string dis_text = "";
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            bool reduced = has_trait(it.get_resist_trait()) || has_effect(it.get_resist_effect());
-            int move_adjust = it.get_mod("SPEED", reduced);
-            if (move_adjust != 0) {
-                dis_text = it.get_speed_name();
-                speed_effects[dis_text] += move_adjust;
-            }
+    for( auto &it : effects ) {
+        bool reduced = has_trait(it.get_resist_trait()) || has_effect(it.get_resist_effect());
+        int move_adjust = it.get_mod("SPEED", reduced);
+        if (move_adjust != 0) {
+            dis_text = it.get_speed_name();
+            speed_effects[dis_text] += move_adjust;
         }
     }
 
@@ -4099,7 +4100,7 @@ int player::unimpaired_range()
  if (has_effect("in_pit")) {
     ret = 1;
   }
- if (has_effect("blind") || worn_with_flag("BLIND")) {
+ if (has_effect( effect_blind ) || worn_with_flag("BLIND")) {
     ret = 0;
   }
  return ret;
@@ -4116,7 +4117,7 @@ bool player::overmap_los(int omtx, int omty, int sight_points)
 
     const std::vector<point> line = line_to(ompos.x, ompos.y, omtx, omty, 0);
     for (size_t i = 0; i < line.size() && sight_points >= 0; i++) {
-        const oter_id &ter = overmap_buffer.ter(line[i].x, line[i].y, ompos.z);
+        const oter_id &ter = overmap_buffer.get_ter(line[i].x, line[i].y, ompos.z);
         const int cost = otermap[ter].see_cost;
         sight_points -= cost;
         if (sight_points < 0)
@@ -4409,13 +4410,14 @@ int player::read_speed(bool return_stat_effect)
 
 int player::rust_rate(bool return_stat_effect)
 {
-    if (OPTIONS["SKILL_RUST"] == "off") {
+    static const option_handle<std::string> opt_skill_rust( "SKILL_RUST" );
+    if (opt_skill_rust == "off") {
         return 0;
     }
 
     // Stat window shows stat effects on based on current stat
     int intel = (return_stat_effect ? get_int() : get_int());
-    int ret = ((OPTIONS["SKILL_RUST"] == "vanilla" || OPTIONS["SKILL_RUST"] == "capped") ? 500 : 500 - 35 * (intel - 8));
+    int ret = ((opt_skill_rust == "vanilla" || opt_skill_rust == "capped") ? 500 : 500 - 35 * (intel - 8));
 
     if (has_trait("FORGETFUL")) {
         ret *= 1.33;
@@ -5356,7 +5358,7 @@ void player::cough(bool harmful, int loudness) {
     if (harmful && !one_in(4)) {
         apply_damage( nullptr, bp_torso, 1 );
     }
-    if (has_effect("sleep") && ((harmful && one_in(3)) || one_in(10)) ) {
+    if (has_effect( effect_sleep ) && ((harmful && one_in(3)) || one_in(10)) ) {
         wake_up();
     }
 }
@@ -5514,196 +5516,199 @@ void player::process_effects() {
     }
 
     //Human only effects
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            bool reduced = has_trait(it.get_resist_trait()) || has_effect(it.get_resist_effect());
-            double mod = 1;
-            body_part bp = it.get_bp();
-            int val = 0;
+    // Processing an effect can add or remove other effects, so loop over a copy of the keys.
+    for( auto &key : effects.keys() ) {
+        effect *const eff = effects.find( key.first, key.second );
+        if( eff == nullptr ) {
+            continue;
+        }
+        auto &it = *eff;
+        bool reduced = has_trait(it.get_resist_trait()) || has_effect(it.get_resist_effect());
+        double mod = 1;
+        body_part bp = it.get_bp();
+        int val = 0;
 
-            // Still hardcoded stuff, do this first since some modify their other traits
-            hardcoded_effects(it);
+        // Still hardcoded stuff, do this first since some modify their other traits
+        hardcoded_effects(it);
 
-            // Handle miss messages
-            auto msgs = it.get_miss_msgs();
-            if (!msgs.empty()) {
-                for (auto i : msgs) {
-                    add_miss_reason(_(i.first.c_str()), i.second);
-                }
+        // Handle miss messages
+        auto msgs = it.get_miss_msgs();
+        if (!msgs.empty()) {
+            for (auto i : msgs) {
+                add_miss_reason(_(i.first.c_str()), i.second);
             }
+        }
 
-            // Handle health mod
-            val = it.get_mod("H_MOD", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "H_MOD", val, reduced, mod)) {
-                    mod_healthy_mod(bound_mod_to_vals(get_healthy_mod(), val,
-                                it.get_max_val("H_MOD", reduced), it.get_min_val("H_MOD", reduced)));
-                }
+        // Handle health mod
+        val = it.get_mod("H_MOD", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "H_MOD", val, reduced, mod)) {
+                mod_healthy_mod(bound_mod_to_vals(get_healthy_mod(), val,
+                            it.get_max_val("H_MOD", reduced), it.get_min_val("H_MOD", reduced)));
             }
+        }
 
-            // Handle health
-            val = it.get_mod("HEALTH", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "HEALTH", val, reduced, mod)) {
-                    mod_healthy(bound_mod_to_vals(get_healthy(), val,
-                                it.get_max_val("HEALTH", reduced), it.get_min_val("HEALTH", reduced)));
-                }
+        // Handle health
+        val = it.get_mod("HEALTH", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "HEALTH", val, reduced, mod)) {
+                mod_healthy(bound_mod_to_vals(get_healthy(), val,
+                            it.get_max_val("HEALTH", reduced), it.get_min_val("HEALTH", reduced)));
             }
+        }
 
-            // Handle stim
-            val = it.get_mod("STIM", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "STIM", val, reduced, mod)) {
-                    stim += bound_mod_to_vals(stim, val, it.get_max_val("STIM", reduced),
-                                                it.get_min_val("STIM", reduced));
-                }
+        // Handle stim
+        val = it.get_mod("STIM", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "STIM", val, reduced, mod)) {
+                stim += bound_mod_to_vals(stim, val, it.get_max_val("STIM", reduced),
+                                            it.get_min_val("STIM", reduced));
             }
+        }
 
-            // Handle hunger
-            val = it.get_mod("HUNGER", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "HUNGER", val, reduced, mod)) {
-                    hunger += bound_mod_to_vals(hunger, val, it.get_max_val("HUNGER", reduced),
-                                                it.get_min_val("HUNGER", reduced));
-                }
+        // Handle hunger
+        val = it.get_mod("HUNGER", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "HUNGER", val, reduced, mod)) {
+                hunger += bound_mod_to_vals(hunger, val, it.get_max_val("HUNGER", reduced),
+                                            it.get_min_val("HUNGER", reduced));
             }
+        }
 
-            // Handle thirst
-            val = it.get_mod("THIRST", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "THIRST", val, reduced, mod)) {
-                    thirst += bound_mod_to_vals(thirst, val, it.get_max_val("THIRST", reduced),
-                                                it.get_min_val("THIRST", reduced));
-                }
+        // Handle thirst
+        val = it.get_mod("THIRST", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "THIRST", val, reduced, mod)) {
+                thirst += bound_mod_to_vals(thirst, val, it.get_max_val("THIRST", reduced),
+                                            it.get_min_val("THIRST", reduced));
             }
+        }
 
-            // Handle fatigue
-            val = it.get_mod("FATIGUE", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "FATIGUE", val, reduced, mod)) {
-                    fatigue += bound_mod_to_vals(fatigue, val, it.get_max_val("FATIGUE", reduced),
-                                                it.get_min_val("FATIGUE", reduced));
-                }
+        // Handle fatigue
+        val = it.get_mod("FATIGUE", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "FATIGUE", val, reduced, mod)) {
+                fatigue += bound_mod_to_vals(fatigue, val, it.get_max_val("FATIGUE", reduced),
+                                            it.get_min_val("FATIGUE", reduced));
             }
+        }
 
-            // Handle Radiation
-            val = it.get_mod("RAD", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "RAD", val, reduced, mod)) {
-                    radiation += bound_mod_to_vals(radiation, val, it.get_max_val("RAD", reduced), 0);
-                    // Radiation can't go negative
-                    if (radiation < 0) {
-                        radiation = 0;
-                    }
+        // Handle Radiation
+        val = it.get_mod("RAD", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "RAD", val, reduced, mod)) {
+                radiation += bound_mod_to_vals(radiation, val, it.get_max_val("RAD", reduced), 0);
+                // Radiation can't go negative
+                if (radiation < 0) {
+                    radiation = 0;
                 }
             }
+        }
 
-            // Handle stat changes
-            mod_str_bonus(it.get_mod("STR", reduced));
-            mod_dex_bonus(it.get_mod("DEX", reduced));
-            mod_per_bonus(it.get_mod("PER", reduced));
-            mod_int_bonus(it.get_mod("INT", reduced));
-            // Speed is already added in recalc_speed_bonus
+        // Handle stat changes
+        mod_str_bonus(it.get_mod("STR", reduced));
+        mod_dex_bonus(it.get_mod("DEX", reduced));
+        mod_per_bonus(it.get_mod("PER", reduced));
+        mod_int_bonus(it.get_mod("INT", reduced));
+        // Speed is already added in recalc_speed_bonus
 
-            // Handle Pain
-            val = it.get_mod("PAIN", reduced);
-            if (val != 0) {
-                mod = 1;
-                if (it.get_sizing("PAIN")) {
-                    if (has_trait("FAT")) {
-                        mod *= 1.5;
-                    }
-                    if (has_trait("LARGE") || has_trait("LARGE_OK")) {
-                        mod *= 2;
-                    }
-                    if (has_trait("HUGE") || has_trait("HUGE_OK")) {
-                        mod *= 3;
-                    }
+        // Handle Pain
+        val = it.get_mod("PAIN", reduced);
+        if (val != 0) {
+            mod = 1;
+            if (it.get_sizing("PAIN")) {
+                if (has_trait("FAT")) {
+                    mod *= 1.5;
                 }
-                if(it.activated(calendar::turn, "PAIN", val, reduced, mod)) {
-                    int pain_inc = bound_mod_to_vals(pain, val, it.get_max_val("PAIN", reduced), 0);
-                    mod_pain(pain_inc);
-                    if (pain_inc > 0) {
-                        add_pain_msg(val, bp);
-                    }
+                if (has_trait("LARGE") || has_trait("LARGE_OK")) {
+                    mod *= 2;
                 }
-            }
-
-            // Handle Damage
-            val = it.get_mod("HURT", reduced);
-            if (val != 0) {
-                mod = 1;
-                if (it.get_sizing("HURT")) {
-                    if (has_trait("FAT")) {
-                        mod *= 1.5;
-                    }
-                    if (has_trait("LARGE") || has_trait("LARGE_OK")) {
-                        mod *= 2;
-                    }
-                    if (has_trait("HUGE") || has_trait("HUGE_OK")) {
-                        mod *= 3;
-                    }
+                if (has_trait("HUGE") || has_trait("HUGE_OK")) {
+                    mod *= 3;
                 }
-                if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
-                    if (bp == num_bp) {
-                        if (val > 5) {
-                            add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp_torso).c_str());
-                        } else {
-                            add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp_torso).c_str());
-                        }
-                        apply_damage(nullptr, bp_torso, val);
-                    } else {
-                        if (val > 5) {
-                            add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp).c_str());
-                        } else {
-                            add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp).c_str());
-                        }
-                        apply_damage(nullptr, bp, val);
-                    }
+            }
+            if(it.activated(calendar::turn, "PAIN", val, reduced, mod)) {
+                int pain_inc = bound_mod_to_vals(pain, val, it.get_max_val("PAIN", reduced), 0);
+                mod_pain(pain_inc);
+                if (pain_inc > 0) {
+                    add_pain_msg(val, bp);
                 }
             }
+        }
 
-            // Handle Sleep
-            val = it.get_mod("SLEEP", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "SLEEP", val, reduced, mod)) {
-                    add_msg_if_player(_("You pass out!"));
-                    fall_asleep(val);
+        // Handle Damage
+        val = it.get_mod("HURT", reduced);
+        if (val != 0) {
+            mod = 1;
+            if (it.get_sizing("HURT")) {
+                if (has_trait("FAT")) {
+                    mod *= 1.5;
+                }
+                if (has_trait("LARGE") || has_trait("LARGE_OK")) {
+                    mod *= 2;
+                }
+                if (has_trait("HUGE") || has_trait("HUGE_OK")) {
+                    mod *= 3;
                 }
             }
-
-            // Handle painkillers
-            val = it.get_mod("PKILL", reduced);
-            if (val != 0) {
-                mod = it.get_addict_mod("PKILL", addiction_level(ADD_PKILLER));
-                if(it.activated(calendar::turn, "PKILL", val, reduced, mod)) {
-                    pkill += bound_mod_to_vals(pkill, val, it.get_max_val("PKILL", reduced), 0);
+            if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
+                if (bp == num_bp) {
+                    if (val > 5) {
+                        add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp_torso).c_str());
+                    } else {
+                        add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp_torso).c_str());
+                    }
+                    apply_damage(nullptr, bp_torso, val);
+                } else {
+                    if (val > 5) {
+                        add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp).c_str());
+                    } else {
+                        add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp).c_str());
+                    }
+                    apply_damage(nullptr, bp, val);
                 }
             }
+        }
 
-            // Handle coughing
+        // Handle Sleep
+        val = it.get_mod("SLEEP", reduced);
+        if (val != 0) {
             mod = 1;
-            val = 0;
-            if (it.activated(calendar::turn, "COUGH", val, reduced, mod)) {
-                cough(it.get_harmful_cough());
+            if(it.activated(calendar::turn, "SLEEP", val, reduced, mod)) {
+                add_msg_if_player(_("You pass out!"));
+                fall_asleep(val);
             }
+        }
 
-            // Handle vomiting
-            mod = vomit_mod();
-            val = 0;
-            if (it.activated(calendar::turn, "VOMIT", val, reduced, mod)) {
-                vomit();
+        // Handle painkillers
+        val = it.get_mod("PKILL", reduced);
+        if (val != 0) {
+            mod = it.get_addict_mod("PKILL", addiction_level(ADD_PKILLER));
+            if(it.activated(calendar::turn, "PKILL", val, reduced, mod)) {
+                pkill += bound_mod_to_vals(pkill, val, it.get_max_val("PKILL", reduced), 0);
             }
         }
+
+        // Handle coughing
+        mod = 1;
+        val = 0;
+        if (it.activated(calendar::turn, "COUGH", val, reduced, mod)) {
+            cough(it.get_harmful_cough());
+        }
+
+        // Handle vomiting
+        mod = vomit_mod();
+        val = 0;
+        if (it.activated(calendar::turn, "VOMIT", val, reduced, mod)) {
+            vomit();
+        }
     }
 
     Creature::process_effects();
@@ -5715,7 +5720,7 @@ void player::hardcoded_effects(effect &it)
     int dur = it.get_duration();
     int intense = it.get_intensity();
     body_part bp = it.get_bp();
-    bool sleeping = has_effect("sleep");
+    bool sleeping = has_effect( effect_sleep );
     bool msg_trig = one_in(400);
     if (id == "onfire") {
         // TODO: this should be determined by material properties
@@ -6562,7 +6567,7 @@ void player::hardcoded_effects(effect &it)
         if(one_in(4096)) {
             mod_healthy_mod(-10);
             apply_damage( nullptr, bp_head, rng( 1, 2 ) );
-            if (!has_effect("blind")) {
+            if (!has_effect( effect_blind )) {
                 add_msg_if_player(m_bad, _("Your vision goes black!"));
                 add_effect("blind", rng(5, 20));
             }
@@ -6942,7 +6947,7 @@ void player::hardcoded_effects(effect &it)
 
         bool woke_up = false;
         int tirednessVal = rng(5, 200) + rng(0, abs(fatigue * 2 * 5));
-        if (!has_effect("blind") && !worn_with_flag("BLIND")) {
+        if (!has_effect( effect_blind ) && !worn_with_flag("BLIND")) {
             if (has_trait("HEAVYSLEEPER2") && !has_trait("HIBERNATE")) {
                 // So you can too sleep through noon
                 if ((tirednessVal * 1.25) < g->light_level() && (fatigue < 10 || one_in(fatigue / 2))) {
@@ -7000,7 +7005,7 @@ void player::hardcoded_effects(effect &it)
             }
         }
     } else if (id == "alarm_clock") {
-        if (has_effect("sleep")) {
+        if (has_effect( effect_sleep )) {
             if (dur == 1) {
                 if(has_bionic("bio_watch")) {
                     // Normal alarm is volume 12, tested against (2/3/6)d15 for
@@ -7199,7 +7204,7 @@ void player::suffer()
             if (has_trait("LEG_TENT_BRACE")){
                 add_msg_if_player(m_bad, _("Your tentacles buckle under the weight!"));
             }
-            if (has_effect("downed")) {
+            if (has_effect( effect_downed )) {
                 add_effect("downed", 1);
             } else {
                 add_effect("downed", 2);
@@ -7405,7 +7410,7 @@ void player::suffer()
             auto_use = false;
         }
 
-        if (has_effect("sleep")) {
+        if (has_effect( effect_sleep )) {
             add_msg_if_player(_("You have an asthma attack!"));
             wake_up();
             auto_use = false;
@@ -7532,7 +7537,7 @@ void player::suffer()
             add_msg(m_bad, _("Suddenly, you can't hear anything!"));
             add_effect("deaf", 20 * rng (2, 6)) ;
         }
-        if (one_in(600) && !(has_effect("blind"))) {
+        if (one_in(600) && !(has_effect( effect_blind ))) {
             add_msg(m_bad, _("Suddenly, your eyes stop working!"));
             add_effect("blind", 10 * rng (2, 6)) ;
         }
@@ -7655,7 +7660,8 @@ void player::suffer()
         } else if (radiation > 2000) {
             radiation = 2000;
         }
-        if (OPTIONS["RAD_MUTATION"] && rng(60, 2500) < radiation) {
+        static const option_handle<bool> opt_rad_mutation( "RAD_MUTATION" );
+        if (opt_rad_mutation && rng(60, 2500) < radiation) {
             mutate();
             radiation /= 2;
             radiation -= 5;
@@ -7781,7 +7787,7 @@ void player::suffer()
         add_msg(m_bad, _("Your vision pixelates!"));
         add_effect("visuals", 100);
     }
-    if (has_bionic("bio_spasm") && one_in(3000) && !has_effect("downed")) {
+    if (has_bionic("bio_spasm") && one_in(3000) && !has_effect( effect_downed )) {
         add_msg(m_bad, _("Your malfunctioning bionic causes you to spasm and fall to the floor!"));
         mod_pain(1);
         add_effect("stunned", 1);
@@ -7837,7 +7843,7 @@ void player::mend()
             }
 
             // Bed rest speeds up mending
-            if(has_effect("sleep")) {
+            if(has_effect( effect_sleep )) {
                 healing_factor *= 4.0;
             } else if(fatigue > 383) {
             // but being dead tired does not...
@@ -7939,14 +7945,11 @@ void player::vomit()
     hunger += nut_loss;
     thirst += quench_loss;
     moves -= 100;
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            if (it.get_id() == "foodpoison") {
-                it.mod_duration(-300);
-            } else if (it.get_id() == "drunk" ) {
-                it.mod_duration(rng(-100, -500));
-            }
+    for( auto &it : effects ) {
+        if (it.get_id() == "foodpoison") {
+            it.mod_duration(-300);
+        } else if (it.get_id() == "drunk" ) {
+            it.mod_duration(rng(-100, -500));
         }
     }
     remove_effect("pkill1");
@@ -9946,7 +9949,7 @@ hint_rating player::rate_action_wear(item *it)
     if (count == 2) {
         return HINT_IFFY;
     }
-    if (has_trait("WOOLALLERGY") && (it->made_of("wool") || it->item_tags.count("wooled") > 0)) {
+    if (has_trait("WOOLALLERGY") && (it->made_of("wool") || it->has_own_flag("wooled"))) {
         return HINT_IFFY; //should this be HINT_CANT? I kinda think not, because HINT_CANT is more for things that can NEVER happen
     }
     if (it->covers(bp_head) && encumb(bp_head) != 0) {
@@ -10135,7 +10138,7 @@ bool player::wear_item(item *to_wear, bool interactive)
     }
 
     if (!to_wear->has_flag("OVERSIZE")) {
-        if (has_trait("WOOLALLERGY") && (to_wear->made_of("wool") || to_wear->item_tags.count("wooled"))) {
+        if (has_trait("WOOLALLERGY") && (to_wear->made_of("wool") || to_wear->has_own_flag("wooled"))) {
             if(interactive) {
                 add_msg(m_info, _("You can't wear that, it's made of wool!"));
             }
@@ -11627,7 +11630,7 @@ float player::fine_detail_vision_mod()
     // PER_SLIME_OK implies you can get enough eyes around the bile
     // that you can generaly see.  There'll still be the haze, but
     // it's annoying rather than limiting.
-    if ((has_effect("blind") || worn_with_flag("BLIND")) || ((has_effect("boomered")) &&
+    if ((has_effect( effect_blind ) || worn_with_flag("BLIND")) || ((has_effect("boomered")) &&
     !(has_trait("PER_SLIME_OK"))))
     {
         return 5;
@@ -12788,6 +12791,9 @@ bool player::uncanny_dodge()
     if( adjacent.x != posx() || adjacent.y != posy()) {
         position.x = adjacent.x;
         position.y = adjacent.y;
+        if( !is_u ) {
+            npc_position_generation++;
+        }
         if( is_u ) {
             add_msg( _("Time seems to slow down and you instinctively dodge!") );
         } else if( seen ) {
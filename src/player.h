@@ -899,10 +899,16 @@ class player : public Character, public JsonSerializer, public JsonDeserializer
         inline void setx( int x )
         {
             position.x = x;
+            if( is_npc() ) {
+                npc_position_generation++;
+            }
         }
         inline void sety( int y )
         {
             position.y = y;
+            if( is_npc() ) {
+                npc_position_generation++;
+            }
         }
         inline int posz() const
         {
@@ -911,7 +917,16 @@ class player : public Character, public JsonSerializer, public JsonDeserializer
         inline void setz( int z )
         {
             zpos = z;
+            if( is_npc() ) {
+                npc_position_generation++;
+            }
         }
+        /**
+         * Changes whenever an NPC moves or the list of active NPCs changes,
+         * but not when the avatar moves. Used by @ref game::npc_at to know
+         * when its grid is stale.
+         */
+        static unsigned npc_position_generation;
         int view_offset_x, view_offset_y;
         bool in_vehicle;       // Means player sit inside vehicle on the tile he is now
         bool controlling_vehicle;  // Is currently in control of a vehicle
@@ -1,19 +1,163 @@
 #include "output.h"
 #include "rng.h"
 #include <stdlib.h>
+#include <atomic>
+#include <initializer_list>
+
+static uint64_t rotl( const uint64_t x, int k )
+{
+    return ( x << k ) | ( x >> ( 64 - k ) );
+}
+
+// splitmix64, used to spread a seed over the whole state of the generator.
+static uint64_t splitmix64( uint64_t &x )
+{
+    uint64_t z = ( x += 0x9E3779B97F4A7C15ULL );
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+    return z ^ ( z >> 31 );
+}
+
+rng_stream::rng_stream( const uint64_t s )
+{
+    seed( s );
+}
+
+void rng_stream::seed( uint64_t s )
+{
+    for( auto &elem : state ) {
+        elem = splitmix64( s );
+    }
+}
+
+uint64_t rng_stream::next()
+{
+    const uint64_t result = rotl( state[1] * 5, 7 ) * 9;
+    const uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl( state[3], 45 );
+    return result;
+}
+
+double rng_stream::next_double()
+{
+    // The upper 53 bits are the best ones and fill the mantissa of a double exactly.
+    return ( next() >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
+
+static std::atomic<unsigned int> global_seed( 0 );
+// Each thread gets its own streams, later threads must not repeat the ones before.
+static std::atomic<unsigned int> thread_counter( 0 );
+
+namespace
+{
+struct thread_rng_state {
+    rng_stream streams[NUM_RNG_STREAMS];
+    rng_stream_id current = RNG_DEFAULT;
+    // Set by rng_stream_scope, overrides current.
+    rng_stream *injected = nullptr;
+
+    thread_rng_state() {
+        reseed( global_seed, thread_counter++ );
+    }
+    void reseed( const unsigned int seed, const unsigned int thread_index ) {
+        for( int i = 0; i < NUM_RNG_STREAMS; i++ ) {
+            streams[i].seed( ( uint64_t( seed ) << 32 ) ^ ( uint64_t( thread_index ) << 8 ) ^ i );
+        }
+    }
+};
+}
+
+static thread_rng_state &get_thread_rng()
+{
+    static thread_local thread_rng_state state;
+    return state;
+}
+
+void rng_set_seed( const unsigned int seed )
+{
+    global_seed = seed;
+    // The calling thread gets the same streams as the first thread would.
+    get_thread_rng().reseed( seed, 0 );
+}
+
+static std::atomic<uint64_t> world_seed( 0 );
+
+void rng_set_world_seed( const uint64_t seed )
+{
+    world_seed = seed;
+}
+
+uint64_t rng_location_seed( const rng_stream_id id, const int x, const int y, const int z )
+{
+    uint64_t state = world_seed;
+    uint64_t hash = splitmix64( state );
+    for( const int value : { static_cast<int>( id ), x, y, z } ) {
+        state = hash ^ static_cast<uint32_t>( value );
+        hash = splitmix64( state );
+    }
+    return hash;
+}
+
+rng_stream &get_rng_stream( const rng_stream_id id )
+{
+    return get_thread_rng().streams[id];
+}
+
+rng_stream_scope::rng_stream_scope( const rng_stream_id id )
+{
+    auto &state = get_thread_rng();
+    previous = state.current;
+    previous_injected = state.injected;
+    state.current = id;
+    state.injected = nullptr;
+}
+
+rng_stream_scope::rng_stream_scope( rng_stream &stream )
+{
+    auto &state = get_thread_rng();
+    previous = state.current;
+    previous_injected = state.injected;
+    state.injected = &stream;
+}
+
+rng_stream_scope::~rng_stream_scope()
+{
+    auto &state = get_thread_rng();
+    state.current = previous;
+    state.injected = previous_injected;
+}
+
+rng_stream &current_rng_stream()
+{
+    auto &state = get_thread_rng();
+    if( state.injected != nullptr ) {
+        return *state.injected;
+    }
+    return state.streams[state.current];
+}
+
+static double next_double()
+{
+    return current_rng_stream().next_double();
+}
 
 long rng(long val1, long val2)
 {
     long minVal = (val1 < val2) ? val1 : val2;
     long maxVal = (val1 < val2) ? val2 : val1;
-    return minVal + long((maxVal - minVal + 1) * double(rand() / double(RAND_MAX + 1.0)));
+    return minVal + long((maxVal - minVal + 1) * next_double());
 }
 
 double rng_float(double val1, double val2)
 {
     double minVal = (val1 < val2) ? val1 : val2;
     double maxVal = (val1 < val2) ? val2 : val1;
-    return minVal + (maxVal - minVal) * double(rand()) / double(RAND_MAX + 1.0);
+    return minVal + (maxVal - minVal) * next_double();
 }
 
 bool one_in(int chance)
@@ -29,7 +173,7 @@ bool one_in_improved(double chance)
 
 bool x_in_y(double x, double y)
 {
-    return ((double)rand() / RAND_MAX) <= ((double)x / y);
+    return next_double() <= ((double)x / y);
 }
 
 int dice(int number, int sides)
@@ -54,4 +198,3 @@ int djb2_hash(const unsigned char *str)
     }
     return hash;
 }
-
@@ -1,6 +1,105 @@
 #ifndef RNG_H
 #define RNG_H
 
+#include <cstdint>
+
+/**
+ * Subsystems that draw from their own random number stream. Using separate streams
+ * keeps e.g. mapgen results independent from how many random numbers the monster AI
+ * used before, and allows each subsystem to run on its own thread later on.
+ */
+enum rng_stream_id : int {
+    RNG_DEFAULT = 0,
+    RNG_MAPGEN,
+    RNG_MONSTER,
+    RNG_FIELD,
+    RNG_WEATHER,
+    RNG_OVERMAP,
+    NUM_RNG_STREAMS
+};
+
+/**
+ * Small and fast pseudo random number generator (xoshiro256**).
+ * It has no global state, so each thread can use its own instance without any locking.
+ * It can be passed to the standard algorithms, e.g. std::shuffle.
+ */
+class rng_stream
+{
+    public:
+        typedef uint64_t result_type;
+
+        rng_stream( uint64_t seed = 0 );
+        /** Reset the state, the same seed always yields the same sequence. */
+        void seed( uint64_t seed );
+        /** Next raw 64 bit value. */
+        uint64_t next();
+        /** Uniform double in [0, 1). */
+        double next_double();
+
+        static constexpr result_type min() {
+            return 0;
+        }
+        static constexpr result_type max() {
+            return UINT64_MAX;
+        }
+        result_type operator()() {
+            return next();
+        }
+
+    private:
+        uint64_t state[4];
+};
+
+/**
+ * Seed all random number streams of the calling thread from the given (session) seed.
+ * Threads that have not used the random number functions yet derive their streams
+ * from this seed too, when they first use them.
+ */
+void rng_set_seed( unsigned int seed );
+/**
+ * Set the seed stored with the active world, see @ref rng_location_seed.
+ * It does not affect the streams above.
+ */
+void rng_set_world_seed( uint64_t seed );
+/**
+ * Seed for generating the given location (submap or overmap coordinates) of the
+ * active world. It depends only on the world seed, the subsystem and the location,
+ * so a location comes out the same regardless of when and in which order it is
+ * generated.
+ */
+uint64_t rng_location_seed( rng_stream_id id, int x, int y, int z );
+/** The stream of the given subsystem for the calling thread. */
+rng_stream &get_rng_stream( rng_stream_id id );
+/**
+ * The stream the functions below currently draw from on the calling thread,
+ * see @ref rng_stream_scope.
+ */
+rng_stream &current_rng_stream();
+
+/**
+ * While an instance of this exists, the free functions below (@ref rng, @ref one_in, ...)
+ * of the calling thread draw from the stream of the given subsystem.
+ */
+class rng_stream_scope
+{
+    public:
+        rng_stream_scope( rng_stream_id id );
+        /**
+         * Use the given stream instead of any of the per-thread streams, e.g. one that has
+         * been seeded for a specific task, so the result does not depend on which thread
+         * runs the task or on what ran before it.
+         */
+        rng_stream_scope( rng_stream &stream );
+        ~rng_stream_scope();
+
+        rng_stream_scope( const rng_stream_scope & ) = delete;
+        rng_stream_scope &operator=( const rng_stream_scope & ) = delete;
+
+    private:
+        rng_stream_id previous;
+        rng_stream *previous_injected;
+};
+
 long rng(long val1, long val2);
 double rng_float(double val1, double val2);
 bool one_in(int chance);
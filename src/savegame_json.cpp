@@ -252,6 +252,9 @@ void player::load(JsonObject &data)
     if( !data.read("posz", zpos) && g != nullptr ) {
       zpos = g->get_levz();
     }
+    if( is_npc() ) {
+        npc_position_generation++;
+    }
     data.read("hunger", hunger);
     data.read("thirst", thirst);
     data.read("fatigue", fatigue);
@@ -1437,6 +1440,9 @@ void vehicle::deserialize(JsonIn &jsin)
     data.read("camera_on", camera_on);
     data.read("dome_lights_on", dome_lights_on);
     data.read("aisle_lights_on", aisle_lights_on);
+    if( !data.read( "last_update_turn", last_update_turn ) ) {
+        last_update_turn = calendar::turn;
+    }
 
     face.init (fdir);
     move.init (mdir);
@@ -1513,6 +1519,7 @@ void vehicle::serialize(JsonOut &json) const
     json.member( "camera_on", camera_on );
     json.member( "dome_lights_on", dome_lights_on );
     json.member( "aisle_lights_on", aisle_lights_on );
+    json.member( "last_update_turn", last_update_turn );
     json.end_object();
 }
 
@@ -1679,12 +1686,10 @@ void Creature::store( JsonOut &jsout ) const
 
     // Because JSON requires string keys we need to convert our int keys
     std::unordered_map<std::string, std::unordered_map<std::string, effect>> tmp_map;
-    for (auto maps : effects) {
-        for (auto i : maps.second) {
-            std::ostringstream convert;
-            convert << i.first;
-            tmp_map[maps.first][convert.str()] = i.second;
-        }
+    for( auto &eff : effects ) {
+        std::ostringstream convert;
+        convert << eff.get_bp();
+        tmp_map[eff.get_id()][convert.str()] = eff;
     }
     jsout.member( "effects", tmp_map );
 
@@ -1755,7 +1760,7 @@ void Creature::load( JsonObject &jsin )
                     if ( !(std::istringstream(i.first) >> key_num) ) {
                         key_num = 0;
                     }
-                    effects[maps.first][(body_part)key_num] = i.second;
+                    effects.set( get_efftype_index( maps.first ), (body_part)key_num, i.second );
                 }
             }
         }
@@ -1138,6 +1138,7 @@ static bool unserialize_legacy(std::ifstream & fin ) {
                 sm->update_lum_add(it_tmp, itx, ity);
             }
             sm->itm[itx][ity].push_back(it_tmp);
+            sm->update_item_tile(itx, ity);
             if( it_tmp.active ) {
                 sm->active_items.add( std::prev(sm->itm[itx][ity].end()), point( itx, ity ) );
             }
@@ -1157,6 +1158,7 @@ static bool unserialize_legacy(std::ifstream & fin ) {
             if(!sm->fld[itx][ity].findField(field_id(t)))
              sm->field_count++;
             sm->fld[itx][ity].addField(field_id(t), d, a);
+            sm->update_field_tile(itx, ity);
            } else if (string_identifier == "S") {
             char tmpfriend;
             int tmpfac = -1, tmpmis = -1;
@@ -1414,6 +1416,7 @@ static void unserialize_legacy_submaps( std::ifstream &fin, const int num_submap
                     sm->update_lum_add(it_tmp, itx, ity);
                 }
                 sm->itm[itx][ity].push_back(it_tmp);
+                sm->update_item_tile(itx, ity);
                 if (it_tmp.active) {
                     sm->active_items.add( std::prev(sm->itm[itx][ity].end()), point( itx, ity ) );
                 }
@@ -1434,6 +1437,7 @@ static void unserialize_legacy_submaps( std::ifstream &fin, const int num_submap
                     sm->field_count++;
                 }
                 sm->fld[itx][ity].addField(field_id(t), d, a);
+                sm->update_field_tile(itx, ity);
             } else if (string_identifier == "S") {
                 char tmpfriend;
                 int tmpfac = -1, tmpmis = -1;
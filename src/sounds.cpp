@@ -4,6 +4,9 @@
 #include "enums.h"
 #include "overmapbuffer.h"
 
+#include <queue>
+#include <tuple>
+
 struct sound_event {
     int volume;
     std::string description;
@@ -20,6 +23,21 @@ struct centroid
     float weight;
 };
 
+static const int SOUND_MAP_SIZE = SEEX * MAPSIZE;
+// Additional volume lost by passing through a wall or closed door.
+static const int SOUND_WALL_ATTENUATION = 10;
+
+/**
+ * The loudest sound that can be heard on each tile of the reality bubble, after distance and
+ * walls have been taken into account, and where it came from (an index into the sound clusters).
+ * Monsters look it up at their position instead of measuring their distance to each sound.
+ */
+struct sound_field
+{
+    int volume[SOUND_MAP_SIZE][SOUND_MAP_SIZE];
+    int source[SOUND_MAP_SIZE][SOUND_MAP_SIZE];
+};
+
 // Static globals tracking sounds events of various kinds.
 // The sound events since the last monster turn.
 static std::vector<std::pair<point, int>> recent_sounds;
@@ -112,6 +130,68 @@ static std::vector<centroid> cluster_sounds( std::vector<std::pair<point, int>>
     return sound_clusters;
 }
 
+// Impassable and opaque terrain or furniture (walls, closed doors) muffles sound.
+static bool blocks_sound( const int x, const int y )
+{
+    return g->m.move_cost_ter_furn( x, y ) == 0 &&
+           !( g->m.ter_at( x, y ).transparent && g->m.furn_at( x, y ).transparent );
+}
+
+/**
+ * Spreads the sound clusters over the map, losing 1 volume per tile (diagonal steps included,
+ * like @ref rl_dist without trigdist) and @ref SOUND_WALL_ATTENUATION more per wall.
+ * Only the loudest sound is kept on each tile, so this is a Dijkstra search from all clusters
+ * at once, which ends where all sounds have faded out.
+ * @param volume_factor Multiplies the volume of the clusters, good hearing doubles it.
+ * @param wall_cache Lazily filled cache of @ref blocks_sound, 0 means not yet known.
+ */
+static void build_sound_field( sound_field &field, const std::vector<centroid> &sound_clusters,
+                               const int volume_factor,
+                               signed char (&wall_cache)[SOUND_MAP_SIZE][SOUND_MAP_SIZE] )
+{
+    for( auto &column : field.volume ) {
+        std::fill( std::begin( column ), std::end( column ), 0 );
+    }
+    // volume, x, y, the largest volume is processed first.
+    std::priority_queue<std::tuple<int, int, int>> open;
+    for( size_t i = 0; i < sound_clusters.size(); i++ ) {
+        const int x = sound_clusters[i].x;
+        const int y = sound_clusters[i].y;
+        const int volume = int( sound_clusters[i].volume ) * volume_factor;
+        if( x < 0 || y < 0 || x >= SOUND_MAP_SIZE || y >= SOUND_MAP_SIZE ||
+            volume <= field.volume[x][y] ) {
+            continue;
+        }
+        field.volume[x][y] = volume;
+        field.source[x][y] = i;
+        open.emplace( volume, x, y );
+    }
+    while( !open.empty() ) {
+        int volume, x, y;
+        std::tie( volume, x, y ) = open.top();
+        open.pop();
+        if( volume < field.volume[x][y] ) {
+            // Already reached by a louder sound.
+            continue;
+        }
+        for( int nx = std::max( x - 1, 0 ); nx <= std::min( x + 1, SOUND_MAP_SIZE - 1 ); nx++ ) {
+            for( int ny = std::max( y - 1, 0 ); ny <= std::min( y + 1, SOUND_MAP_SIZE - 1 ); ny++ ) {
+                signed char &wall = wall_cache[nx][ny];
+                if( wall == 0 ) {
+                    wall = blocks_sound( nx, ny ) ? 1 : -1;
+                }
+                const int new_volume = volume - ( wall > 0 ? 1 + SOUND_WALL_ATTENUATION : 1 );
+                if( new_volume <= field.volume[nx][ny] ) {
+                    continue;
+                }
+                field.volume[nx][ny] = new_volume;
+                field.source[nx][ny] = field.source[x][y];
+                open.emplace( new_volume, nx, ny );
+            }
+        }
+    }
+}
+
 void sounds::process_sounds()
 {
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
@@ -128,39 +208,60 @@ void sounds::process_sounds()
             const tripoint target( abs_sm.x, abs_sm.y, g->get_levz() );
             overmap_buffer.signal_hordes( target, sig_power );
         }
-        // Alert all monsters (that can hear) to the sound.
-        for (int i = 0, numz = g->num_zombies(); i < numz; i++) {
-            monster &critter = g->zombie(i);
-            // rl_dist() is faster than critter.has_flag() or critter.can_hear(), so we'll check it first.
-            int dist = rl_dist( source, critter.pos() );
-            int vol_goodhearing = vol * 2 - dist;
-            if (vol_goodhearing > 0 && critter.can_hear()) {
-                const bool goodhearing = critter.has_flag(MF_GOODHEARING);
-                int volume = goodhearing ? vol_goodhearing : (vol - dist);
-                // Error is based on volume, louder sound = less error
-                if (volume > 0) {
-                    int max_error = 0;
-                    if (volume < 2) {
-                        max_error = 10;
-                    } else if (volume < 5) {
-                        max_error = 5;
-                    } else if (volume < 10) {
-                        max_error = 3;
-                    } else if (volume < 20) {
-                        max_error = 1;
-                    }
-
-                    int target_x = source.x + rng(-max_error, max_error);
-                    int target_y = source.y + rng(-max_error, max_error);
+    }
+    recent_sounds.clear();
+    if( sound_clusters.empty() ) {
+        return;
+    }
 
-                    int wander_turns = volume * (goodhearing ? 6 : 1);
-                    critter.wander_to(target_x, target_y, wander_turns);
-                    critter.process_trigger(MTRIG_SOUND, volume);
-                }
+    // Large, and only used here.
+    static sound_field field;
+    static sound_field goodhearing_field;
+    static signed char wall_cache[SOUND_MAP_SIZE][SOUND_MAP_SIZE];
+    for( auto &column : wall_cache ) {
+        std::fill( std::begin( column ), std::end( column ), 0 );
+    }
+    build_sound_field( field, sound_clusters, 1, wall_cache );
+    bool goodhearing_field_built = false;
+
+    // Alert all monsters (that can hear) to the loudest sound at their position.
+    for (int i = 0, numz = g->num_zombies(); i < numz; i++) {
+        monster &critter = g->zombie(i);
+        const int x = critter.posx();
+        const int y = critter.posy();
+        if( x < 0 || y < 0 || x >= SOUND_MAP_SIZE || y >= SOUND_MAP_SIZE ) {
+            continue;
+        }
+        const bool goodhearing = critter.has_flag(MF_GOODHEARING);
+        if( goodhearing && !goodhearing_field_built ) {
+            build_sound_field( goodhearing_field, sound_clusters, 2, wall_cache );
+            goodhearing_field_built = true;
+        }
+        const sound_field &heard = goodhearing ? goodhearing_field : field;
+        const int volume = heard.volume[x][y];
+        // Error is based on volume, louder sound = less error
+        if( volume > 0 && critter.can_hear() ) {
+            const centroid &this_centroid = sound_clusters[heard.source[x][y]];
+            const point source = point(this_centroid.x, this_centroid.y);
+            int max_error = 0;
+            if (volume < 2) {
+                max_error = 10;
+            } else if (volume < 5) {
+                max_error = 5;
+            } else if (volume < 10) {
+                max_error = 3;
+            } else if (volume < 20) {
+                max_error = 1;
             }
+
+            int target_x = source.x + rng(-max_error, max_error);
+            int target_y = source.y + rng(-max_error, max_error);
+
+            int wander_turns = volume * (goodhearing ? 6 : 1);
+            critter.wander_to(target_x, target_y, wander_turns);
+            critter.process_trigger(MTRIG_SOUND, volume);
         }
     }
-    recent_sounds.clear();
 }
 
 void sounds::process_sound_markers( player *p )
@@ -188,6 +188,8 @@ vehicle::vehicle(std::string type_id, int init_veh_fuel, int init_veh_status): t
     fridge_on = false;
     recharger_on = false;
     insides_dirty = true;
+    physics_dirty = true;
+    mounts_dirty = true;
     reactor_on = false;
     engine_on = false;
     is_locked = false;
@@ -204,6 +206,7 @@ vehicle::vehicle(std::string type_id, int init_veh_fuel, int init_veh_status): t
         init_state(init_veh_fuel, init_veh_status);
       }
     }
+    last_update_turn = calendar::turn;
     precalc_mounts(0, face.dir());
     refresh();
 }
@@ -565,6 +568,7 @@ void vehicle::smash() {
             parts[part_index].amount = 0;
         }
     }
+    physics_dirty = true;
 }
 
 void vehicle::control_doors() {
@@ -2218,12 +2222,49 @@ bool vehicle::part_flag( int part, const vpart_bitflags &flag) const
 
 int vehicle::part_at(int dx, int dy)
 {
-    for (size_t p = 0; p < parts.size(); p++) {
-        if (parts[p].precalc[0].x == dx && parts[p].precalc[0].y == dy && !parts[p].removed) {
-            return (int)p;
+    if( mounts_dirty ) {
+        refresh_part_at_grid();
+    }
+    const int x = dx - part_at_grid_min.x;
+    const int y = dy - part_at_grid_min.y;
+    if( x < 0 || x >= part_at_grid_width || y < 0 || y >= part_at_grid_height ) {
+        return -1;
+    }
+    return part_at_grid[x * part_at_grid_height + y];
+}
+
+void vehicle::refresh_part_at_grid()
+{
+    mounts_dirty = false;
+    int x1 = 0, y1 = 0, x2 = -1, y2 = -1;
+    for( auto &p : parts ) {
+        if( p.removed ) {
+            continue;
+        }
+        if( x2 < x1 ) {
+            x1 = x2 = p.precalc[0].x;
+            y1 = y2 = p.precalc[0].y;
+        }
+        x1 = std::min( x1, p.precalc[0].x );
+        y1 = std::min( y1, p.precalc[0].y );
+        x2 = std::max( x2, p.precalc[0].x );
+        y2 = std::max( y2, p.precalc[0].y );
+    }
+    part_at_grid_min = point( x1, y1 );
+    part_at_grid_width = x2 - x1 + 1;
+    part_at_grid_height = y2 - y1 + 1;
+    part_at_grid.assign( part_at_grid_width * part_at_grid_height, -1 );
+    // Parts are visited in order, the first one at a tile is the one part_at returns.
+    for( size_t p = 0; p < parts.size(); p++ ) {
+        if( parts[p].removed ) {
+            continue;
+        }
+        int &index = part_at_grid[( parts[p].precalc[0].x - x1 ) * part_at_grid_height +
+                                  parts[p].precalc[0].y - y1];
+        if( index < 0 ) {
+            index = p;
         }
     }
-    return -1;
 }
 
 int vehicle::global_part_at(int x, int y)
@@ -2358,7 +2399,8 @@ nc_color vehicle::part_color (int p)
     int parm = -1;
 
     //If armoring is present and the option is set, it colors the visible part
-    if (!!OPTIONS["VEHICLE_ARMOR_COLOR"])
+    static const option_handle<bool> opt_vehicle_armor_color( "VEHICLE_ARMOR_COLOR" );
+    if (opt_vehicle_armor_color)
       parm = part_with_feature(p, VPFLAG_ARMOR, false);
 
     if (parm >= 0) {
@@ -2564,6 +2606,9 @@ void vehicle::precalc_mounts (int idir, int dir)
         p.precalc[idir].x = dx;
         p.precalc[idir].y = dy;
     }
+    if( idir == 0 ) {
+        mounts_dirty = true;
+    }
 }
 
 std::vector<int> vehicle::boarded_parts()
@@ -2638,6 +2683,23 @@ void vehicle::set_submap_moved( int x, int y )
 }
 
 int vehicle::total_mass()
+{
+    if( physics_dirty ) {
+        refresh_physics();
+    }
+    return mass_cache;
+}
+
+void vehicle::refresh_physics()
+{
+    physics_dirty = false;
+    mass_cache = total_mass_internal();
+    wheels_area_cache = wheels_area_internal( &wheel_count_cache );
+    aerodynamics_cache = k_aerodynamics_internal();
+    valid_wheel_config_cache = valid_wheel_config_internal();
+}
+
+int vehicle::total_mass_internal()
 {
     int m = 0;
     for (size_t i = 0; i < parts.size(); i++)
@@ -2831,6 +2893,11 @@ int vehicle::total_power (bool fueled)
 }
 
 int vehicle::solar_epower (tripoint sm_loc)
+{
+    return solar_epower( sm_loc, g->ground_natural_light_level() );
+}
+
+int vehicle::solar_epower( tripoint sm_loc, const float light )
 {
     // this will obviosuly be wrong for vehicles spanning z-levels, when
     // that gets possible...
@@ -2858,7 +2925,7 @@ int vehicle::solar_epower (tripoint sm_loc)
 
             if( !(terlist[sm->ter[pg.x][pg.y]].has_flag(TFLAG_INDOORS) ||
                   furnlist[sm->get_furn(pg.x, pg.y)].has_flag(TFLAG_INDOORS)) ) {
-                epower += ( part_epower( elem ) * g->ground_natural_light_level() ) / DAYLIGHT_LEVEL;
+                epower += ( part_epower( elem ) * light ) / DAYLIGHT_LEVEL;
             }
         }
     }
@@ -3041,6 +3108,17 @@ void vehicle::noise_and_smoke( double load, double time )
 }
 
 float vehicle::wheels_area (int *cnt)
+{
+    if( physics_dirty ) {
+        refresh_physics();
+    }
+    if( cnt ) {
+        *cnt = wheel_count_cache;
+    }
+    return wheels_area_cache;
+}
+
+float vehicle::wheels_area_internal( int *cnt )
 {
     int count = 0;
     int total_area = 0;
@@ -3073,6 +3151,14 @@ float vehicle::k_friction ()
 }
 
 float vehicle::k_aerodynamics ()
+{
+    if( physics_dirty ) {
+        refresh_physics();
+    }
+    return aerodynamics_cache;
+}
+
+float vehicle::k_aerodynamics_internal()
 {
     const int max_obst = 13;
     int obst[max_obst];
@@ -3137,6 +3223,14 @@ float vehicle::strain ()
 }
 
 bool vehicle::valid_wheel_config ()
+{
+    if( physics_dirty ) {
+        refresh_physics();
+    }
+    return valid_wheel_config_cache;
+}
+
+bool vehicle::valid_wheel_config_internal()
 {
     std::vector<int> floats = all_parts_with_feature(VPFLAG_FLOATS);
     if( !floats.empty() ) {
@@ -3256,7 +3350,12 @@ void vehicle::consume_fuel( double load = 1.0 )
     }
 }
 
-void vehicle::power_parts (tripoint sm_loc)//TODO: more categories of powered part!
+void vehicle::power_parts (tripoint sm_loc)
+{
+    power_parts( sm_loc, 1, g->ground_natural_light_level() );
+}
+
+void vehicle::power_parts( tripoint sm_loc, const int turns, const float light )//TODO: more categories of powered part!
 {
     int epower = 0;
 
@@ -3284,7 +3383,7 @@ void vehicle::power_parts (tripoint sm_loc)//TODO: more categories of powered pa
     if(aisle_lights_on) epower += aisle_lights_epower;
 
     // Producers of epower
-    epower += solar_epower(sm_loc);
+    epower += solar_epower( sm_loc, light );
 
     if(engine_on) {
         // Plasma engines generate epower if turned on
@@ -3313,6 +3412,8 @@ void vehicle::power_parts (tripoint sm_loc)//TODO: more categories of powered pa
             epower += alternators_epower;
         }
     }
+    // From here on epower is the total over all turns.
+    epower *= turns;
 
     if(reactor_on && battery_discharge - epower > 0) {
         // Still not enough surplus epower to fully charge battery
@@ -3321,7 +3422,7 @@ void vehicle::power_parts (tripoint sm_loc)//TODO: more categories of powered pa
         int reactors_fuel_epower = 0;
         for( auto &elem : reactors ) {
             if( parts[elem].hp > 0 ) {
-                reactors_epower += part_info( elem ).epower;
+                reactors_epower += part_info( elem ).epower * turns;
                 reactors_fuel_epower += power_to_epower( parts[elem].amount );
             }
         }
@@ -3435,6 +3536,14 @@ vehicle* vehicle::find_vehicle(point &where)
         }
     }
 
+    if( veh != nullptr ) {
+        // Vehicles outside of the reality bubble are not processed every turn.
+        veh->catch_up( tripoint( veh_sm.x, veh_sm.y, g->get_levz() ) );
+        // Callers change the vehicle (e.g. charge its batteries), and quads
+        // outside of the reality bubble are only saved when dirty.
+        sm->dirty = true;
+    }
+
     // ...and hand it over.
     return veh;
 }
@@ -3569,7 +3678,7 @@ void vehicle::do_engine_damage(size_t e, int strain) {
     }
 }
 
-void vehicle::idle(bool on_map) {
+void vehicle::idle(bool on_map, int turns) {
     int engines_power = 0;
     float idle_rate;
 
@@ -3585,7 +3694,7 @@ void vehicle::idle(bool on_map) {
 
         idle_rate = (float)alternator_load / (float)engines_power;
         if (idle_rate < 0.01) idle_rate = 0.01; // minimum idle is 1% of full throttle
-        consume_fuel(idle_rate);
+        consume_fuel(idle_rate * turns);
 
         if (on_map) {
             noise_and_smoke( idle_rate, 6.0 );
@@ -3607,6 +3716,35 @@ void vehicle::idle(bool on_map) {
     }
 }
 
+void vehicle::catch_up( const tripoint &sm_loc )
+{
+    // Done in chunks, so batteries running empty and engines running dry still
+    // switch things off along the way.
+    static const int max_turns = 600;
+    while( last_update_turn + 1 < calendar::turn ) {
+        const bool active = engine_on || reactor_on || !solar_panels.empty() || lights_on ||
+                            overhead_lights_on || tracking_on || fridge_on || recharger_on ||
+                            is_alarm_on || camera_on || dome_lights_on || aisle_lights_on;
+        if( !active ) {
+            last_update_turn = calendar::turn - 1;
+            break;
+        }
+        const int turns = std::min<int>( max_turns, calendar::turn - 1 - last_update_turn );
+        // The light of the middle of the chunk, not the current one.
+        const calendar when( last_update_turn + turns / 2 );
+        const float light = g->ground_natural_light_level( when,
+                            overmapbuffer::sm_to_ms_copy( sm_loc.x, sm_loc.y ) );
+        // Updated first, power_parts may come back here through connected vehicles.
+        last_update_turn += turns;
+        power_parts( sm_loc, turns, light );
+        idle( false, turns );
+        submap *const sm = MAPBUFFER.find_submap( sm_loc );
+        if( sm != nullptr ) {
+            sm->dirty = true;
+        }
+    }
+}
+
 void vehicle::alarm(){
     if (one_in(4)) {
         //first check if the alarm is still installed
@@ -4362,6 +4500,7 @@ bool vehicle::add_item (int part, item itm)
 bool vehicle::add_item_at(int part, std::list<item>::iterator index, item itm)
 {
     const auto new_pos = parts[part].items.insert( index, itm );
+    physics_dirty = true;
     if( itm.needs_processing() ) {
         active_items.add( new_pos, parts[part].mount );
     }
@@ -4399,6 +4538,7 @@ std::list<item>::iterator vehicle::remove_item( int part, std::list<item>::itera
         active_items.remove( it, parts[part].mount );
     }
 
+    physics_dirty = true;
     return veh_items.erase(it);
 }
 
@@ -4601,6 +4741,7 @@ void vehicle::refresh()
     precalc_mounts( 0, face.dir() );
     check_environmental_effects = true;
     insides_dirty = true;
+    physics_dirty = true;
 }
 
 void vehicle::remove_remote_part(int part_num) {
@@ -4894,8 +5035,10 @@ int vehicle::damage_direct (int p, int dmg, int type)
         parts[p].hp -= dmg;
         if (parts[p].hp < 0)
             parts[p].hp = 0;
-        if (!parts[p].hp && last_hp > 0)
+        if (!parts[p].hp && last_hp > 0) {
             insides_dirty = true;
+            physics_dirty = true;
+        }
         if (part_flag(p, "FUEL_TANK"))
         {
             ammotype ft = part_info(p).fuel_type;
@@ -4914,6 +5057,7 @@ int vehicle::damage_direct (int p, int dmg, int type)
                     g->explosion (global_x() + parts[p].precalc[0].x, global_y() + parts[p].precalc[0].y,
                                 pow, 0, (ft == fuel_type_gasoline || ft == fuel_type_diesel));
                     parts[p].hp = 0;
+                    physics_dirty = true;
                 }
             }
         }
@@ -5618,7 +5762,7 @@ item vehicle_part::properties_to_item() const
     if( tmp.has_flag("CABLE_SPOOL") ) {
         point local_pos = g->m.getlocal(target.first);
         if(g->m.veh_at(local_pos.x, local_pos.y) == nullptr) {
-            tmp.item_tags.insert("NO_DROP"); // That vehicle ain't there no more.
+            tmp.set_flag("NO_DROP"); // That vehicle ain't there no more.
         }
 
         tmp.set_var( "source_x", target.first.x );
@@ -315,6 +315,27 @@ private:
 
     //Refresh all caches and re-locate all parts
     void refresh();
+    // Recalculate the values returned by total_mass, wheels_area, k_aerodynamics
+    // and valid_wheel_config, called by them when physics_dirty is set.
+    void refresh_physics();
+    // Rebuild part_at_grid from precalc[0], called by part_at when mounts_dirty is set.
+    void refresh_part_at_grid();
+    // The uncached calculations behind the functions above.
+    int total_mass_internal();
+    float wheels_area_internal( int *cnt );
+    float k_aerodynamics_internal();
+    bool valid_wheel_config_internal();
+
+    int mass_cache;
+    float wheels_area_cache;
+    int wheel_count_cache;
+    float aerodynamics_cache;
+    bool valid_wheel_config_cache;
+    // Index of the first part at each tile of the precalc[0] bounding box, or -1.
+    std::vector<int> part_at_grid;
+    point part_at_grid_min;
+    int part_at_grid_width;
+    int part_at_grid_height;
 
     // Do stuff like clean up blood and produce smoke from broken parts. Returns false if nothing needs doing.
     bool do_environmental_effects();
@@ -325,6 +346,7 @@ private:
      * Find a possibly off-map vehicle. If necessary, loads up its submap through
      * the global MAPBUFFER and pulls it from there. For this reason, you should only
      * give it the coordinates of the origin tile of a target vehicle.
+     * The submap of an off-map vehicle is marked dirty, as callers may change it.
      * @param where Location of the other vehicle's origin tile.
      */
     vehicle* find_vehicle(point &where);
@@ -532,6 +554,21 @@ public:
     void consume_fuel( double load );
 
     void power_parts (tripoint sm_loc);
+    /**
+     * Same as above, but for several turns at once. The solar panels get the given
+     * natural light level over all of them (see @ref solar_epower).
+     */
+    void power_parts( tripoint sm_loc, int turns, float light );
+
+    /**
+     * Applies @ref power_parts and @ref idle for the turns between @ref last_update_turn
+     * and the current turn (exclusive). Vehicles outside of the reality bubble are not
+     * processed each turn, this is called when they are needed again. Each chunk of turns
+     * gets the natural light of its middle. Marks the submap at sm_loc dirty if there
+     * was anything to catch up.
+     * @param sm_loc Location of the vehicle in global submap coordinates.
+     */
+    void catch_up( const tripoint &sm_loc );
 
     /**
      * Try to charge our (and, optionally, connected vehicles') batteries by the given amount.
@@ -557,6 +594,8 @@ public:
 
 // Get combined epower of solar panels
     int solar_epower (tripoint sm_loc);
+    /** Same as above, with the given natural light level instead of the current one. */
+    int solar_epower( tripoint sm_loc, float light );
 
 // Get acceleration gained by combined power of all engines. If fueled == true, then only engines which
 // vehicle have fuel for are accounted
@@ -597,8 +636,8 @@ public:
 // calculate if it can move using its wheels configuration
     bool valid_wheel_config ();
 
-// idle fuel consumption
-    void idle (bool on_map = true);
+// idle fuel consumption, turns is the number of turns that passed
+    void idle (bool on_map = true, int turns = 1);
 // continuous processing for running vehicle alarms
     void alarm ();
 // leak from broken tanks
@@ -800,10 +839,15 @@ public:
      */
     void set_submap_moved(int x, int y);
     bool insides_dirty; // if true, then parts' "inside" flags are outdated and need refreshing
+    // if true, the cached mass, wheel and drag values are outdated; set it after changing
+    // parts, their hp, cargo or passengers outside of the functions that already do
+    bool physics_dirty;
+    bool mounts_dirty; // if true, precalc[0] changed and part_at must rebuild its lookup grid
     int init_veh_fuel;
     int init_veh_status;
     float alternator_load;
     int last_repair_turn; // Turn it was last repaired, used to make consecutive repairs faster.
+    int last_update_turn; // Last turn power_parts and idle have been applied for, see catch_up.
 
     // save values
     /**
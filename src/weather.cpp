@@ -57,7 +57,7 @@ int get_rot_since( const int since, const int endturn, const point &location )
     const point abs_pos = g->m.getabs( location );
     const point omt_abs = overmapbuffer::ms_to_omt_copy( abs_pos );
     // TODO: input location should be an absolute value and inclue a z-component
-    oter_id oter = overmap_buffer.ter( tripoint( omt_abs.x, omt_abs.y, g->get_levz() ) );
+    oter_id oter = overmap_buffer.get_ter( tripoint( omt_abs.x, omt_abs.y, g->get_levz() ) );
     if (is_ot_type("ice_lab", oter)) {
         return 0;
     }
@@ -543,7 +543,8 @@ std::string print_temperature(float fahrenheit, int decimals)
     ret.precision(decimals);
     ret << std::fixed;
 
-    if(OPTIONS["USE_CELSIUS"] == "celsius") {
+    static const option_handle<std::string> opt_use_celsius( "USE_CELSIUS" );
+    if(opt_use_celsius == "celsius") {
         ret << ((fahrenheit - 32) * 5 / 9);
         return rmp_format(_("<Celsius>%sC"), ret.str().c_str());
     } else {
@@ -562,7 +563,8 @@ std::string print_windspeed(float windspeed, int decimals)
     ret.precision(decimals);
     ret << std::fixed;
 
-    if (OPTIONS["USE_METRIC_SPEEDS"] == "mph") {
+    static const option_handle<std::string> opt_use_metric_speeds( "USE_METRIC_SPEEDS" );
+    if (opt_use_metric_speeds == "mph") {
         ret << windspeed;
         return rmp_format(_("%s mph"), ret.str().c_str());
     } else {
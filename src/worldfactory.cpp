@@ -6,10 +6,13 @@
 #include "debug.h"
 #include "mapsharing.h"
 #include "gamemode.h"
+#include "rng.h"
+#include "compatibility.h"
 
 #include "name.h"
 
 #include <fstream>
+#include <climits>
 
 #define WORLD_OPTION_FILE "worldoptions.txt"
 #define SAVE_MASTER "master.gsav"
@@ -220,10 +223,20 @@ void worldfactory::set_active_world(WORLDPTR world)
 {
     world_generator->active_world = world;
     if (world) {
+        // The seed is chosen (from the --seed value) once and then stored with the world,
+        // so map and overmap generation can be reproduced. The rest of the game keeps
+        // using the streams seeded per session, reloading must not repeat their results.
+        cOpt &seed = world->world_options["WORLD_SEED"];
+        if( static_cast<int>( seed ) == 0 ) {
+            seed.setValue( to_string( rng( 1, INT_MAX ) ) );
+            save_world( world );
+        }
+        rng_set_world_seed( static_cast<uint64_t>( static_cast<int>( seed ) ) );
         ACTIVE_WORLD_OPTIONS = world->world_options;
     } else {
         ACTIVE_WORLD_OPTIONS.clear();
     }
+    options_changed();
 }
 
 bool worldfactory::save_world(WORLDPTR world, bool is_conversion)
@@ -0,0 +1,269 @@
+#include <tap++/tap++.h>
+using namespace TAP;
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <time.h>
+
+#include "filesystem.h"
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "line.h"
+#include "rng.h"
+#include "options.h"
+#include "overmapbuffer.h"
+#include "output.h"
+#include "path_info.h"
+#include "scenario.h"
+#include "worldfactory.h"
+
+// The map caches the move cost and bash resistance of each tile and the connected components
+// that map::route may pass (see map::could_route). These tests compare the cached answers
+// against the same values computed straight from the terrain and furniture.
+
+static const int MAP_WIDTH = SEEX * MAPSIZE;
+static const int MAP_HEIGHT = SEEY * MAPSIZE;
+
+#define ROOMS_PER_ROUND 20
+#define CHANGES_PER_ROUND 100
+#define ROUTE_PAIRS 2000
+
+// Same rules as map::bash_resistance had before the cache.
+int direct_bash_resistance( map &m, int x, int y )
+{
+    if( m.has_furn( x, y ) && m.furn_at( x, y ).bash.str_min != -1 ) {
+        return m.furn_at( x, y ).bash.str_min;
+    } else if( m.ter_at( x, y ).bash.str_min != -1 ) {
+        return m.ter_at( x, y ).bash.str_min;
+    }
+    return -1;
+}
+
+bool move_costs_match( map &m )
+{
+    for( int x = 0; x < MAP_WIDTH; x++ ) {
+        for( int y = 0; y < MAP_HEIGHT; y++ ) {
+            // Vehicle tiles bypass the cache.
+            if( m.veh_at( x, y ) != nullptr ) {
+                continue;
+            }
+            if( m.move_cost( x, y ) != m.move_cost_ter_furn( x, y ) ) {
+                diag( string_format( "move cost at %d,%d: cached %d, direct %d", x, y,
+                      m.move_cost( x, y ), m.move_cost_ter_furn( x, y ) ) );
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool bash_resistances_match( map &m )
+{
+    for( int x = 0; x < MAP_WIDTH; x++ ) {
+        for( int y = 0; y < MAP_HEIGHT; y++ ) {
+            if( m.bash_resistance( x, y ) != direct_bash_resistance( m, x, y ) ) {
+                diag( string_format( "bash resistance at %d,%d: cached %d, direct %d", x, y,
+                      m.bash_resistance( x, y ), direct_bash_resistance( m, x, y ) ) );
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Whether route may pass the tile: it can be walked on or opened, holds a vehicle, or
+// (when bashing) can be bashed at all.
+bool passable( map &m, int x, int y, bool bash )
+{
+    if( m.veh_at( x, y ) != nullptr ) {
+        return true;
+    }
+    if( m.move_cost_ter_furn( x, y ) > 0 || !m.ter_at( x, y ).open.empty() ) {
+        return true;
+    }
+    return bash && ( ( m.has_furn( x, y ) && m.furn_at( x, y ).bash.str_max != -1 ) ||
+                     m.ter_at( x, y ).bash.str_max != -1 );
+}
+
+// Plain flood fill of the 8-connected passable tiles, -1 for the others.
+std::vector<int> components( map &m, bool bash )
+{
+    std::vector<int> result( MAP_WIDTH * MAP_HEIGHT, -1 );
+    int next_label = 0;
+    for( int x = 0; x < MAP_WIDTH; x++ ) {
+        for( int y = 0; y < MAP_HEIGHT; y++ ) {
+            if( result[x * MAP_HEIGHT + y] >= 0 || !passable( m, x, y, bash ) ) {
+                continue;
+            }
+            std::vector<point> todo( 1, point( x, y ) );
+            result[x * MAP_HEIGHT + y] = next_label;
+            while( !todo.empty() ) {
+                const point p = todo.back();
+                todo.pop_back();
+                for( int nx = p.x - 1; nx <= p.x + 1; nx++ ) {
+                    for( int ny = p.y - 1; ny <= p.y + 1; ny++ ) {
+                        if( nx < 0 || nx >= MAP_WIDTH || ny < 0 || ny >= MAP_HEIGHT ||
+                            result[nx * MAP_HEIGHT + ny] >= 0 || !passable( m, nx, ny, bash ) ) {
+                            continue;
+                        }
+                        result[nx * MAP_HEIGHT + ny] = next_label;
+                        todo.push_back( point( nx, ny ) );
+                    }
+                }
+            }
+            next_label++;
+        }
+    }
+    return result;
+}
+
+// Route only needs some tile next to the start to connect to some tile next to the target.
+bool connected( const std::vector<int> &comp, int fx, int fy, int tx, int ty )
+{
+    if( rl_dist( fx, fy, tx, ty ) <= 1 ) {
+        return true;
+    }
+    for( int ax = fx - 1; ax <= fx + 1; ax++ ) {
+        for( int ay = fy - 1; ay <= fy + 1; ay++ ) {
+            if( ax < 0 || ax >= MAP_WIDTH || ay < 0 || ay >= MAP_HEIGHT ||
+                comp[ax * MAP_HEIGHT + ay] < 0 ) {
+                continue;
+            }
+            for( int bx = tx - 1; bx <= tx + 1; bx++ ) {
+                for( int by = ty - 1; by <= ty + 1; by++ ) {
+                    if( bx >= 0 && bx < MAP_WIDTH && by >= 0 && by < MAP_HEIGHT &&
+                        comp[bx * MAP_HEIGHT + by] == comp[ax * MAP_HEIGHT + ay] ) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool reachability_matches( map &m, int bash )
+{
+    const std::vector<int> comp = components( m, bash > 0 );
+    int reachable = 0;
+    for( int i = 0; i < ROUTE_PAIRS; i++ ) {
+        const int fx = rng( 0, MAP_WIDTH - 1 );
+        const int fy = rng( 0, MAP_HEIGHT - 1 );
+        const int tx = rng( 0, MAP_WIDTH - 1 );
+        const int ty = rng( 0, MAP_HEIGHT - 1 );
+        const bool expected = connected( comp, fx, fy, tx, ty );
+        if( m.could_route( fx, fy, tx, ty, bash ) != expected ) {
+            diag( string_format( "could_route %d,%d -> %d,%d (bash %d): cached %d, direct %d",
+                  fx, fy, tx, ty, bash, !expected, expected ) );
+            return false;
+        }
+        reachable += expected ? 1 : 0;
+    }
+    diag( string_format( "bash %d: %d of %d pairs reachable", bash, reachable, ROUTE_PAIRS ) );
+    return true;
+}
+
+void check_caches( map &m, const std::string &stage )
+{
+    ok( move_costs_match( m ), "move costs match " + stage );
+    ok( bash_resistances_match( m ), "bash resistances match " + stage );
+    ok( reachability_matches( m, 0 ), "reachability without bashing matches " + stage );
+    ok( reachability_matches( m, 1 ), "reachability with bashing matches " + stage );
+}
+
+// Closed rooms split the map into components (t_fault can not even be bashed, locked doors
+// can be opened), then single tiles in random places poke holes into them and merge
+// components again.
+void change_random_tiles( map &m )
+{
+    static const std::string walls[] = {
+        "t_wall_wood", "t_fault", "t_door_locked"
+    };
+    static const std::string terrains[] = {
+        "t_floor", "t_dirt", "t_wall_wood", "t_door_c", "t_fault", "t_rock", "t_window"
+    };
+    static const std::string furnitures[] = {
+        "f_null", "f_table", "f_bookcase", "f_rubble"
+    };
+    for( int i = 0; i < ROOMS_PER_ROUND; i++ ) {
+        const int x1 = rng( 0, MAP_WIDTH - 3 );
+        const int y1 = rng( 0, MAP_HEIGHT - 3 );
+        const int x2 = std::min<int>( x1 + rng( 2, 15 ), MAP_WIDTH - 1 );
+        const int y2 = std::min<int>( y1 + rng( 2, 15 ), MAP_HEIGHT - 1 );
+        const std::string &wall = walls[rng( 0, 2 )];
+        for( int x = x1; x <= x2; x++ ) {
+            m.ter_set( x, y1, wall );
+            m.ter_set( x, y2, wall );
+        }
+        for( int y = y1; y <= y2; y++ ) {
+            m.ter_set( x1, y, wall );
+            m.ter_set( x2, y, wall );
+        }
+    }
+    for( int i = 0; i < CHANGES_PER_ROUND; i++ ) {
+        const int x = rng( 0, MAP_WIDTH - 1 );
+        const int y = rng( 0, MAP_HEIGHT - 1 );
+        if( one_in( 3 ) ) {
+            m.furn_set( x, y, furnitures[rng( 0, 3 )] );
+        } else {
+            m.ter_set( x, y, terrains[rng( 0, 6 )] );
+        }
+    }
+}
+
+// Only ever makes tiles passable, the reachability cache merges components instead of
+// being rebuilt.
+void open_random_holes( map &m )
+{
+    for( int i = 0; i < CHANGES_PER_ROUND; i++ ) {
+        const int x = rng( 0, MAP_WIDTH - 1 );
+        const int y = rng( 0, MAP_HEIGHT - 1 );
+        m.furn_set( x, y, "f_null" );
+        m.ter_set( x, y, "t_floor" );
+    }
+}
+
+int main(int argc, char *argv[])
+{
+ plan( 20 );
+
+ rng_set_seed( time( NULL ) );
+
+ PATH_INFO::init_base_path( "" );
+ PATH_INFO::init_user_dir( "./" );
+ PATH_INFO::set_standard_filenames();
+ initOptions();
+ load_options();
+
+ g = new game;
+ g->headless = true;
+ g->load_static_data();
+ // The generated overmaps and submaps go to a throwaway world.
+ assure_dir_exist( FILENAMES["savedir"] );
+ world_generator->set_active_world( world_generator->make_new_world( SGAME_TUTORIAL ) );
+ g->setup();
+ // Some mapgen depends on the scenario.
+ g->scen = scenario::generic();
+
+ // Same place new characters start at, see game::pregen_world.
+ const tripoint center_sm = overmapbuffer::omt_to_sm_copy( tripoint( OMAPX / 2, OMAPY / 2, 0 ) );
+ map &m = g->m;
+ m.load( center_sm.x - MAPSIZE / 2, center_sm.y - MAPSIZE / 2, 0, false );
+ m.build_map_cache( false );
+ check_caches( m, "after building the caches" );
+
+ // ter_set and furn_set update the caches of a single tile.
+ change_random_tiles( m );
+ check_caches( m, "after changing tiles" );
+ change_random_tiles( m );
+ check_caches( m, "after changing more tiles" );
+ open_random_holes( m );
+ check_caches( m, "after opening holes" );
+
+ m.build_map_cache( false );
+ check_caches( m, "after rebuilding the caches" );
+
+ return exit_status();
+}
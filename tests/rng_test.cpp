@@ -0,0 +1,153 @@
+#include <tap++/tap++.h>
+using namespace TAP;
+
+#include "rng.h"
+
+#include "stdio.h"
+#include <stdlib.h>
+#include <time.h>
+
+// The implementation rng() had before it got its own generator, for comparison.
+long libc_rng( long val1, long val2 )
+{
+    long minVal = (val1 < val2) ? val1 : val2;
+    long maxVal = (val1 < val2) ? val2 : val1;
+    return minVal + long((maxVal - minVal + 1) * double(rand() / double(RAND_MAX + 1.0)));
+}
+
+double elapsed_seconds( const struct timespec &start, const struct timespec &end )
+{
+    return ( end.tv_sec - start.tv_sec ) + ( end.tv_nsec - start.tv_nsec ) / 1000000000.0;
+}
+
+#define RANDOM_TEST_NUM 100000
+#define PERFORMANCE_TEST_ITERATIONS 10000000
+
+int main(int argc, char *argv[])
+{
+ plan( 7 );
+
+ rng_set_seed( time( NULL ) );
+
+ {
+     bool in_range = true;
+     bool hit_min = false;
+     bool hit_max = false;
+     for( int i = 0; i < RANDOM_TEST_NUM; ++i ) {
+         const long val = rng( -3, 3 );
+         in_range &= val >= -3 && val <= 3;
+         hit_min |= val == -3;
+         hit_max |= val == 3;
+     }
+     ok( in_range, "rng() stays within its bounds." );
+     ok( hit_min && hit_max, "rng() reaches both of its bounds." );
+ }
+
+ {
+     bool in_range = true;
+     for( int i = 0; i < RANDOM_TEST_NUM; ++i ) {
+         const double val = rng_float( 0.5, 1.5 );
+         in_range &= val >= 0.5 && val < 1.5;
+     }
+     ok( in_range, "rng_float() stays within its bounds." );
+ }
+
+ {
+     rng_stream a( 42 );
+     rng_stream b( 42 );
+     bool same = true;
+     for( int i = 0; i < RANDOM_TEST_NUM; ++i ) {
+         same &= a.next() == b.next();
+     }
+     ok( same, "Streams with the same seed yield the same sequence." );
+ }
+
+ {
+     rng_set_seed( 1234 );
+     long expected[100];
+     {
+         rng_stream_scope scope( RNG_MAPGEN );
+         for( auto &elem : expected ) {
+             elem = rng( 0, 1000000 );
+         }
+     }
+     rng_set_seed( 1234 );
+     // Draws from another subsystem must not change the mapgen sequence.
+     for( int i = 0; i < 1000; ++i ) {
+         rng_stream_scope scope( RNG_MONSTER );
+         rng( 0, 1000000 );
+     }
+     bool same = true;
+     {
+         rng_stream_scope scope( RNG_MAPGEN );
+         for( auto &elem : expected ) {
+             same &= elem == rng( 0, 1000000 );
+         }
+     }
+     ok( same, "Subsystem streams are independent of each other." );
+ }
+
+ {
+     // An injected stream gives the same results on any thread and after any other draws.
+     long expected[100];
+     {
+         rng_stream stream( 99 );
+         rng_stream_scope scope( stream );
+         for( auto &elem : expected ) {
+             elem = rng( 0, 1000000 );
+         }
+     }
+     rng( 0, 1000000 );
+     bool same = true;
+     {
+         rng_stream stream( 99 );
+         rng_stream_scope scope( stream );
+         {
+             // Nested subsystem scopes still use their own stream.
+             rng_stream_scope inner( RNG_MONSTER );
+             rng( 0, 1000000 );
+         }
+         for( auto &elem : expected ) {
+             same &= elem == rng( 0, 1000000 );
+         }
+     }
+     ok( same, "Injected streams are independent of the thread streams." );
+ }
+
+ {
+     int hits = 0;
+     for( int i = 0; i < RANDOM_TEST_NUM; ++i ) {
+         hits += one_in( 4 ) ? 1 : 0;
+     }
+     ok( hits > RANDOM_TEST_NUM / 5 && hits < RANDOM_TEST_NUM / 3, "one_in(4) hits about a quarter." );
+ }
+
+ {
+     long sum1 = 0;
+     struct timespec start1;
+     struct timespec end1;
+     clock_gettime( CLOCK_REALTIME, &start1 );
+     for( long i = 0; i < PERFORMANCE_TEST_ITERATIONS; ++i ) {
+         sum1 += rng( 0, 100 );
+     }
+     clock_gettime( CLOCK_REALTIME, &end1 );
+     long sum2 = 0;
+     struct timespec start2;
+     struct timespec end2;
+     clock_gettime( CLOCK_REALTIME, &start2 );
+     for( long i = 0; i < PERFORMANCE_TEST_ITERATIONS; ++i ) {
+         sum2 += libc_rng( 0, 100 );
+     }
+     clock_gettime( CLOCK_REALTIME, &end2 );
+
+     const double secs1 = elapsed_seconds( start1, end1 );
+     const double secs2 = elapsed_seconds( start2, end2 );
+     // The sums are printed so the loops can't be optimized away.
+     printf( "rng() executed %d times in %f seconds (%.1f M calls/s, sum %ld).\n",
+             PERFORMANCE_TEST_ITERATIONS, secs1, PERFORMANCE_TEST_ITERATIONS / secs1 / 1000000, sum1 );
+     printf( "rand() based rng executed %d times in %f seconds (%.1f M calls/s, sum %ld).\n",
+             PERFORMANCE_TEST_ITERATIONS, secs2, PERFORMANCE_TEST_ITERATIONS / secs2 / 1000000, sum2 );
+ }
+
+ return exit_status();
+}